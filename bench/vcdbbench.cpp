@@ -0,0 +1,819 @@
+/**
+ * \file vcdbbench.cpp
+ *
+ * \brief YCSB-style benchmark driving a database engine through the public
+ * interface.
+ *
+ * Usage: vcdbbench [options]
+ *
+ *      --engine NAME           The registered engine to use (MEMDB).
+ *      --connection STRING     The connection string (vcdbbench).
+ *      --workload NAME         read-heavy, update-heavy, scan, rmw or
+ *                              insert-latest (read-heavy).
+ *      --records N             Records loaded before the run (100000).
+ *      --operations N          Operations in the run (100000).
+ *      --threads N             Client threads (1).
+ *      --key-size N            Key size in bytes, enough for "user" and
+ *                              the record number (16).
+ *      --value-size N          Value size in bytes, excluding the key; at
+ *                              least 1 (100).
+ *      --distribution NAME     uniform, zipfian or latest (zipfian, or latest
+ *                              for insert-latest).
+ *      --scan-length N         Values read per scan (10).
+ *      --seed N                Random seed (1).
+ *      --record FILE           Record the run to FILE for vcdbreplay.  The
+ *                              engine must be a record engine, such as
+ *                              record:MEMDB.
+ *
+ * The results are written to standard output as a single JSON object, with
+ * latencies in nanoseconds.  The interface has no range read, so a scan is a
+ * run of point gets over consecutive keys.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/record.h>
+#include <vcdb/transaction.h>
+
+#include "../test/memory_database.h"
+
+using namespace std;
+
+/**
+ * \brief The operation types of a workload.
+ */
+enum bench_op
+{
+    BENCH_OP_READ,
+    BENCH_OP_UPDATE,
+    BENCH_OP_SCAN,
+    BENCH_OP_RMW,
+    BENCH_OP_INSERT,
+    BENCH_OP_COUNT
+};
+
+static const char* bench_op_names[BENCH_OP_COUNT] = {
+    "read", "update", "scan", "read-modify-write", "insert"
+};
+
+/**
+ * \brief A workload: the percentage of each operation type, which add up to
+ * 100, and the default key distribution.
+ */
+struct bench_workload
+{
+    const char* name;
+    int mix[BENCH_OP_COUNT];
+    const char* distribution;
+};
+
+/* the standard YCSB mixes: B, A, E, F and D. */
+static const bench_workload bench_workloads[] = {
+    { "read-heavy",    { 95,  5,  0,  0,  0 }, "zipfian" },
+    { "update-heavy",  { 50, 50,  0,  0,  0 }, "zipfian" },
+    { "scan",          {  0,  0, 95,  0,  5 }, "zipfian" },
+    { "rmw",           { 50,  0,  0, 50,  0 }, "zipfian" },
+    { "insert-latest", { 95,  0,  0,  0,  5 }, "latest"  },
+};
+
+/**
+ * \brief Benchmark options.
+ */
+struct bench_options
+{
+    string engine = MEMORY_DATABASE_ENGINE;
+    string connection = "vcdbbench";
+    const bench_workload* workload = &bench_workloads[0];
+    uint64_t records = 100000;
+    uint64_t operations = 100000;
+    unsigned threads = 1;
+    size_t key_size = 16;
+    size_t value_size = 100;
+    string distribution;
+    uint64_t scan_length = 10;
+    uint64_t seed = 1;
+    string record;
+};
+
+/* the key size, read by the key getter. */
+static size_t bench_key_size;
+
+/* the record size: the key followed by the value. */
+static size_t bench_record_size;
+
+/**
+ * \brief Get the key of a record, which is its first bytes.
+ */
+static void bench_key_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, value, bench_key_size);
+    *key_size = bench_key_size;
+}
+
+/**
+ * \brief Read a record by copying it.
+ */
+static int bench_value_reader(const void* input, size_t size, void* value)
+{
+    if (bench_record_size != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write a record by copying it.
+ */
+static int bench_value_writer(const void* value, void* output, size_t* size)
+{
+    if (*size < bench_record_size)
+    {
+        *size = bench_record_size;
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, bench_record_size);
+    *size = bench_record_size;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write the key of the given record number, so that keys sort in
+ * record order.
+ */
+static void bench_key(uint64_t record, char* key)
+{
+    char digits[32];
+    int len = snprintf(digits, sizeof(digits), "%" PRIu64, record);
+
+    memset(key, '0', bench_key_size);
+    memcpy(key, "user", 4);
+    memcpy(key + bench_key_size - len, digits, len);
+}
+
+/**
+ * \brief Zipfian generator over [0, n), after Gray et al., "Quickly
+ * Generating Billion-Record Synthetic Databases", as used by YCSB.
+ */
+class bench_zipfian
+{
+public:
+    explicit bench_zipfian(uint64_t n, double theta = 0.99)
+        : n(n), theta(theta)
+    {
+        double zeta2 = 1.0 + pow(0.5, theta);
+
+        zetan = 0.0;
+        for (uint64_t i = 1; i <= n; ++i)
+        {
+            zetan += 1.0 / pow((double)i, theta);
+        }
+
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+    }
+
+    uint64_t next(mt19937_64& rng)
+    {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+        double uz = u * zetan;
+
+        if (uz < 1.0)
+        {
+            return 0;
+        }
+
+        if (uz < 1.0 + pow(0.5, theta))
+        {
+            return 1;
+        }
+
+        uint64_t v = (uint64_t)(n * pow(eta * u - eta + 1.0, alpha));
+
+        return min(v, n - 1);
+    }
+
+private:
+    uint64_t n;
+    double theta;
+    double zetan;
+    double alpha;
+    double eta;
+};
+
+/**
+ * \brief Scramble a zipfian rank so the popular records are spread over the
+ * key space (FNV-1a).
+ */
+static uint64_t bench_scramble(uint64_t v)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        hash ^= (v >> (i * 8)) & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief The shared state of a run.
+ */
+struct bench_state
+{
+    const bench_options* options;
+    vcdb_database_t* database;
+    vcdb_datastore_t* datastore;
+    bench_zipfian* zipfian;
+    atomic<uint64_t> next;
+    atomic<uint64_t> inserted;
+    atomic<uint64_t> not_found;
+    atomic<uint64_t> errors;
+};
+
+/**
+ * \brief The latencies recorded by a client thread, by operation type.
+ */
+struct bench_thread_result
+{
+    vector<uint64_t> latencies[BENCH_OP_COUNT];
+};
+
+/**
+ * \brief Choose a record to operate on.
+ */
+static uint64_t bench_choose(bench_state* state, mt19937_64& rng)
+{
+    uint64_t count = state->inserted.load(memory_order_relaxed);
+    const string& distribution = state->options->distribution;
+
+    if ("uniform" == distribution)
+    {
+        return uniform_int_distribution<uint64_t>(0, count - 1)(rng);
+    }
+    else if ("latest" == distribution)
+    {
+        uint64_t back = state->zipfian->next(rng);
+
+        return back < count ? count - 1 - back : 0;
+    }
+    else
+    {
+        return bench_scramble(state->zipfian->next(rng)) % count;
+    }
+}
+
+/**
+ * \brief Write a record in its own transaction.
+ */
+static int bench_put(bench_state* state, char* record)
+{
+    vcdb_transaction_t transaction;
+    size_t record_size = bench_record_size;
+
+    int retval = vcdb_transaction_begin(&transaction, state->database);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vcdb_database_datastore_put(
+            &transaction, state->datastore, record, &record_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        vcdb_transaction_rollback(&transaction);
+    }
+    else
+    {
+        retval = vcdb_transaction_commit(&transaction);
+    }
+
+    dispose((disposable_t*)&transaction);
+
+    return retval;
+}
+
+/**
+ * \brief Read a record.
+ */
+static int bench_get(bench_state* state, uint64_t n, char* record)
+{
+    char key[VCDB_MAX_KEY_SIZE];
+    size_t record_size = bench_record_size;
+
+    bench_key(n, key);
+
+    return
+        vcdb_database_datastore_get(
+            state->database, state->datastore, key, bench_key_size, record,
+            &record_size);
+}
+
+/**
+ * \brief Fill a record with its key and a random value.
+ */
+static void bench_fill(uint64_t n, char* record, mt19937_64& rng)
+{
+    bench_key(n, record);
+    for (size_t i = bench_key_size; i < bench_record_size; ++i)
+    {
+        record[i] = 'a' + rng() % 26;
+    }
+}
+
+/**
+ * \brief Run one operation, returning a status code.
+ */
+static int bench_run_op(
+    bench_state* state, bench_op op, char* record, mt19937_64& rng)
+{
+    int retval = VCDB_STATUS_SUCCESS;
+    uint64_t n;
+
+    switch (op)
+    {
+        case BENCH_OP_READ:
+            return bench_get(state, bench_choose(state, rng), record);
+
+        case BENCH_OP_UPDATE:
+            bench_fill(bench_choose(state, rng), record, rng);
+            return bench_put(state, record);
+
+        case BENCH_OP_SCAN:
+            n = bench_choose(state, rng);
+            for (uint64_t i = 0;
+                 i < state->options->scan_length
+                    && n + i < state->inserted.load(memory_order_relaxed);
+                 ++i)
+            {
+                retval = bench_get(state, n + i, record);
+                if (VCDB_STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+            }
+            return VCDB_STATUS_SUCCESS;
+
+        case BENCH_OP_RMW:
+            retval = bench_get(state, bench_choose(state, rng), record);
+            if (VCDB_STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+            record[bench_key_size] ^= 1;
+            return bench_put(state, record);
+
+        case BENCH_OP_INSERT:
+            n = state->next.fetch_add(1, memory_order_relaxed);
+            bench_fill(n, record, rng);
+            retval = bench_put(state, record);
+            if (VCDB_STATUS_SUCCESS == retval)
+            {
+                /* new records become visible to the other clients. */
+                uint64_t expected = state->inserted.load();
+                while (expected <= n
+                    && !state->inserted.compare_exchange_weak(
+                        expected, n + 1))
+                {
+                }
+            }
+            return retval;
+
+        default:
+            return VCDB_ERROR_INVALID_PARAMETER;
+    }
+}
+
+/**
+ * \brief The body of a client thread.
+ */
+static void bench_client(
+    bench_state* state, unsigned thread, uint64_t operations,
+    bench_thread_result* result)
+{
+    const bench_options* options = state->options;
+    mt19937_64 rng(options->seed * 0x9e3779b97f4a7c15ULL + thread);
+    vector<char> record(bench_record_size);
+
+    for (uint64_t i = 0; i < operations; ++i)
+    {
+        /* pick an operation according to the mix. */
+        int roll = uniform_int_distribution<int>(0, 99)(rng);
+        int op = 0;
+        while (roll >= options->workload->mix[op])
+        {
+            roll -= options->workload->mix[op];
+            ++op;
+        }
+
+        auto start = chrono::steady_clock::now();
+        int retval = bench_run_op(state, (bench_op)op, record.data(), rng);
+        auto end = chrono::steady_clock::now();
+
+        /* concurrent inserts can leave gaps below the newest record. */
+        if (VCDB_ERROR_VALUE_NOT_FOUND == retval)
+        {
+            state->not_found.fetch_add(1, memory_order_relaxed);
+        }
+        else if (VCDB_STATUS_SUCCESS != retval)
+        {
+            state->errors.fetch_add(1, memory_order_relaxed);
+        }
+
+        result->latencies[op].push_back(
+            chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+    }
+}
+
+/**
+ * \brief Load the initial records, a batch per transaction.
+ */
+static int bench_load(bench_state* state)
+{
+    const uint64_t BATCH = 1000;
+    mt19937_64 rng(state->options->seed);
+    vector<char> record(bench_record_size);
+
+    for (uint64_t n = 0; n < state->options->records; n += BATCH)
+    {
+        vcdb_transaction_t transaction;
+
+        int retval = vcdb_transaction_begin(&transaction, state->database);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        for (uint64_t i = n;
+             i < min(n + BATCH, state->options->records) &&
+                VCDB_STATUS_SUCCESS == retval;
+             ++i)
+        {
+            size_t record_size = bench_record_size;
+
+            bench_fill(i, record.data(), rng);
+            retval =
+                vcdb_database_datastore_put(
+                    &transaction, state->datastore, record.data(),
+                    &record_size);
+        }
+
+        if (VCDB_STATUS_SUCCESS == retval)
+        {
+            retval = vcdb_transaction_commit(&transaction);
+        }
+        else
+        {
+            vcdb_transaction_rollback(&transaction);
+        }
+
+        dispose((disposable_t*)&transaction);
+
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    state->next = state->options->records;
+    state->inserted = state->options->records;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Print the usage message.
+ */
+static void bench_usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s [--engine NAME] [--connection STRING] [--workload NAME]\n"
+        "       [--records N] [--operations N] [--threads N]\n"
+        "       [--key-size N] [--value-size N] [--distribution NAME]\n"
+        "       [--scan-length N] [--seed N] [--record FILE]\n"
+        "workloads: read-heavy update-heavy scan rmw insert-latest\n"
+        "distributions: uniform zipfian latest\n",
+        name);
+}
+
+/**
+ * \brief Parse the command line, returning false on bad options.
+ */
+static bool bench_parse(int argc, char* argv[], bench_options* options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+
+        const char* val = argv[++i];
+
+        if ("--engine" == arg)
+        {
+            options->engine = val;
+        }
+        else if ("--connection" == arg)
+        {
+            options->connection = val;
+        }
+        else if ("--workload" == arg)
+        {
+            options->workload = nullptr;
+            for (auto& w : bench_workloads)
+            {
+                if (w.name == string(val))
+                {
+                    options->workload = &w;
+                }
+            }
+
+            if (nullptr == options->workload)
+            {
+                return false;
+            }
+        }
+        else if ("--records" == arg)
+        {
+            options->records = strtoull(val, nullptr, 10);
+        }
+        else if ("--operations" == arg)
+        {
+            options->operations = strtoull(val, nullptr, 10);
+        }
+        else if ("--threads" == arg)
+        {
+            options->threads = strtoul(val, nullptr, 10);
+        }
+        else if ("--key-size" == arg)
+        {
+            options->key_size = strtoul(val, nullptr, 10);
+        }
+        else if ("--value-size" == arg)
+        {
+            options->value_size = strtoul(val, nullptr, 10);
+        }
+        else if ("--distribution" == arg)
+        {
+            options->distribution = val;
+        }
+        else if ("--scan-length" == arg)
+        {
+            options->scan_length = strtoull(val, nullptr, 10);
+        }
+        else if ("--seed" == arg)
+        {
+            options->seed = strtoull(val, nullptr, 10);
+        }
+        else if ("--record" == arg)
+        {
+            options->record = val;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (options->distribution.empty())
+    {
+        options->distribution = options->workload->distribution;
+    }
+
+    /* keys hold "user" and the record number, and read-modify-write flips
+     * the first value byte. */
+    size_t digits =
+        to_string(options->records + options->operations).size();
+
+    return
+        options->records > 0 && options->threads > 0
+     && options->key_size >= 4 + digits
+     && options->key_size <= VCDB_MAX_KEY_SIZE
+     && options->value_size > 0
+     && ("uniform" == options->distribution
+      || "zipfian" == options->distribution
+      || "latest" == options->distribution);
+}
+
+/**
+ * \brief Print the latency summary of an operation type as JSON.
+ */
+static void bench_report_op(
+    const char* name, vector<uint64_t>& latencies, bool last)
+{
+    sort(latencies.begin(), latencies.end());
+
+    uint64_t sum = 0;
+    for (uint64_t l : latencies)
+    {
+        sum += l;
+    }
+
+    auto pct = [&](double p) -> uint64_t {
+        size_t i = (size_t)ceil(p * latencies.size());
+        return latencies[i > 0 ? i - 1 : 0];
+    };
+
+    printf(
+        "    \"%s\": {\"count\": %zu, \"mean\": %" PRIu64 ", "
+        "\"p50\": %" PRIu64 ", \"p99\": %" PRIu64 ", \"p999\": %" PRIu64 ", "
+        "\"max\": %" PRIu64 "}%s\n",
+        name, latencies.size(), sum / latencies.size(), pct(0.50),
+        pct(0.99), pct(0.999), latencies.back(), last ? "" : ",");
+}
+
+/**
+ * \brief Main entry point for the benchmark.
+ */
+int main(int argc, char* argv[])
+{
+    bench_options options;
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_database_t database;
+    int retval;
+
+    if (!bench_parse(argc, argv, &options))
+    {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    register_memory_database();
+
+    /* decorators are only registered on request. */
+    const size_t record_prefix_size = strlen(VCDB_RECORD_ENGINE_PREFIX);
+    if (0 == options.engine.compare(
+                0, record_prefix_size, VCDB_RECORD_ENGINE_PREFIX))
+    {
+        retval =
+            vcdb_record_engine_register(
+                options.engine.c_str() + record_prefix_size);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "record engine register failed: %d\n", retval);
+            return 1;
+        }
+    }
+
+    bench_key_size = options.key_size;
+    bench_record_size = options.key_size + options.value_size;
+
+    retval =
+        vcdb_datastore_init(
+            &datastore, "usertable", bench_record_size, &bench_key_getter,
+            &bench_value_reader, &bench_value_writer);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "datastore init failed: %d\n", retval);
+        return 1;
+    }
+
+    retval =
+        vcdb_builder_init(
+            &builder, options.engine.c_str(), options.connection.c_str());
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_builder_add_datastore(&builder, &datastore);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_database_create_from_builder(&database, &builder);
+    }
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "database create failed: %d\n", retval);
+        return 1;
+    }
+
+    bench_zipfian zipfian(options.records);
+    bench_state state;
+    state.options = &options;
+    state.database = &database;
+    state.datastore = &datastore;
+    state.zipfian = &zipfian;
+    state.next = 0;
+    state.inserted = 0;
+    state.not_found = 0;
+    state.errors = 0;
+
+    retval = bench_load(&state);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "load failed: %d\n", retval);
+        return 1;
+    }
+
+    /* the load is not part of the recorded workload. */
+    if (!options.record.empty())
+    {
+        retval =
+            vcdb_record_start(options.engine.c_str(), options.record.c_str());
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            fprintf(stderr, "record start failed: %d\n", retval);
+            return 1;
+        }
+    }
+
+    /* run the clients. */
+    vector<bench_thread_result> results(options.threads);
+    vector<thread> clients;
+    auto start = chrono::steady_clock::now();
+    for (unsigned t = 0; t < options.threads; ++t)
+    {
+        uint64_t ops =
+            options.operations / options.threads
+          + (t < options.operations % options.threads ? 1 : 0);
+        clients.emplace_back(bench_client, &state, t, ops, &results[t]);
+    }
+    for (auto& client : clients)
+    {
+        client.join();
+    }
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+
+    if (!options.record.empty()
+     && VCDB_STATUS_SUCCESS != vcdb_record_stop(options.engine.c_str()))
+    {
+        fprintf(stderr, "record failed\n");
+        state.errors.fetch_add(1);
+    }
+
+    /* merge the per-thread latencies. */
+    vector<uint64_t> latencies[BENCH_OP_COUNT];
+    for (auto& result : results)
+    {
+        for (int op = 0; op < BENCH_OP_COUNT; ++op)
+        {
+            latencies[op].insert(
+                latencies[op].end(), result.latencies[op].begin(),
+                result.latencies[op].end());
+        }
+    }
+
+    printf("{\n");
+    printf("  \"engine\": \"%s\",\n", options.engine.c_str());
+    printf("  \"workload\": \"%s\",\n", options.workload->name);
+    printf("  \"distribution\": \"%s\",\n", options.distribution.c_str());
+    printf("  \"records\": %" PRIu64 ",\n", options.records);
+    printf("  \"operations\": %" PRIu64 ",\n", options.operations);
+    printf("  \"threads\": %u,\n", options.threads);
+    printf("  \"key_size\": %zu,\n", options.key_size);
+    printf("  \"value_size\": %zu,\n", options.value_size);
+    printf("  \"not_found\": %" PRIu64 ",\n", state.not_found.load());
+    printf("  \"errors\": %" PRIu64 ",\n", state.errors.load());
+    printf("  \"seconds\": %.6f,\n", seconds);
+    printf("  \"throughput\": %.1f,\n", options.operations / seconds);
+    printf("  \"latency_ns\": {\n");
+    int last = -1;
+    for (int op = 0; op < BENCH_OP_COUNT; ++op)
+    {
+        if (!latencies[op].empty())
+        {
+            last = op;
+        }
+    }
+    for (int op = 0; op < BENCH_OP_COUNT; ++op)
+    {
+        if (!latencies[op].empty())
+        {
+            bench_report_op(bench_op_names[op], latencies[op], op == last);
+        }
+    }
+    printf("  }\n");
+    printf("}\n");
+
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+
+    return state.errors.load() > 0 ? 1 : 0;
+}
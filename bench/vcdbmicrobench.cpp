@@ -0,0 +1,360 @@
+/**
+ * \file vcdbmicrobench.cpp
+ *
+ * \brief Microbenchmarks of the fixed cost of each public call, measured
+ * against the null engine.
+ *
+ * Usage: vcdbmicrobench [--iterations N] [--engine NAME]
+ *
+ * Each public call is timed in a tight loop and reported in nanoseconds per
+ * call.  The engine.* entries call the engine methods directly with the same
+ * arguments, so the difference between a call and its engine.* entry is the
+ * overhead added by the library: parameter checks, the engine indirection,
+ * the scratch allocation and the key getter, value reader and value writer
+ * calls.  Results are written to standard output as a single JSON object.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/index.h>
+#include <vcdb/transaction.h>
+
+#include "../test/null_database.h"
+
+using namespace std;
+
+/**
+ * \brief The value type used by every benchmark.
+ */
+typedef struct micro_value
+{
+    char key[16];
+    char group[16];
+    char payload[96];
+} micro_value_t;
+
+/**
+ * \brief Get the primary key of a value.
+ */
+static void micro_key_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const micro_value_t*)value)->key, 16);
+    *key_size = 16;
+}
+
+/**
+ * \brief Get the secondary key of a value.
+ */
+static void micro_group_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const micro_value_t*)value)->group, 16);
+    *key_size = 16;
+}
+
+/**
+ * \brief Read a value by copying it.
+ */
+static int micro_value_reader(const void* input, size_t size, void* value)
+{
+    if (sizeof(micro_value_t) != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write a value by copying it.
+ */
+static int micro_value_writer(const void* value, void* output, size_t* size)
+{
+    if (*size < sizeof(micro_value_t))
+    {
+        *size = sizeof(micro_value_t);
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, sizeof(micro_value_t));
+    *size = sizeof(micro_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Fold a merge operand by replacing the value with it.
+ */
+static int micro_value_merger(
+    const void* /*existing*/, size_t /*existing_size*/,
+    const void* operand, size_t operand_size,
+    void* output, size_t* output_size)
+{
+    if (*output_size < operand_size)
+    {
+        *output_size = operand_size;
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, operand, operand_size);
+    *output_size = operand_size;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief A benchmark: a name and a call returning a status code.
+ */
+struct micro_case
+{
+    string name;
+    function<int()> call;
+};
+
+/**
+ * \brief Main entry point for the microbenchmarks.
+ */
+int main(int argc, char* argv[])
+{
+    uint64_t iterations = 1000000;
+    string engine_name = NULL_DATABASE_ENGINE;
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_datastore_t counters;
+    vcdb_index_t index;
+    vcdb_database_t database;
+    vcdb_transaction_t transaction;
+    micro_value_t value;
+    int retval;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp("--iterations", argv[i]))
+        {
+            iterations = strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (!strcmp("--engine", argv[i]))
+        {
+            engine_name = argv[i + 1];
+        }
+    }
+
+    if (0 == iterations || 0 == argc % 2)
+    {
+        fprintf(stderr, "usage: %s [--iterations N] [--engine NAME]\n",
+            argv[0]);
+        return 1;
+    }
+
+    register_null_database();
+
+    memset(&value, 0, sizeof(value));
+    strcpy(value.key, "key");
+    strcpy(value.group, "group");
+
+    retval =
+        vcdb_datastore_init(
+            &datastore, "values", sizeof(micro_value_t), &micro_key_getter,
+            &micro_value_reader, &micro_value_writer);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval =
+            vcdb_datastore_init(
+                &counters, "counters", sizeof(micro_value_t),
+                &micro_key_getter, &micro_value_reader, &micro_value_writer);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_datastore_value_merger_set(
+            &counters, &micro_value_merger);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_index_init(
+            &index, &datastore, "groups", &micro_group_getter);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval =
+            vcdb_builder_init(&builder, engine_name.c_str(), "microbench");
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_builder_add_datastore(&builder, &datastore);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_builder_add_datastore(&builder, &counters);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_builder_add_index(&builder, &index);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_database_create_from_builder(&database, &builder);
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_transaction_begin(&transaction, &database);
+    }
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "setup failed: %d\n", retval);
+        return 1;
+    }
+
+    vcdb_database_engine_t* engine = builder.engine;
+    micro_value_t out;
+    char buffer[1024];
+    char end_key[16] = "kez";
+    size_t key_size, value_size, end_size;
+    vcdb_version_t version;
+
+    /* writes share one transaction, which the null engine never fills.  Merges
+     * and range deletes go to a datastore without indexes, since indexed ones
+     * refuse them. */
+    vector<micro_case> cases = {
+        { "datastore_get", [&]() {
+            value_size = sizeof(out);
+            return vcdb_database_datastore_get(
+                &database, &datastore, value.key, 16, &out, &value_size); } },
+        { "engine.datastore_get", [&]() {
+            value_size = sizeof(buffer);
+            return engine->datastore_get(
+                &database, &datastore, value.key, 16, buffer,
+                &value_size); } },
+        { "datastore_get_versioned", [&]() {
+            value_size = sizeof(out);
+            return vcdb_database_datastore_get_versioned(
+                &database, &datastore, value.key, 16, &out, &value_size,
+                &version); } },
+        { "datastore_contains", [&]() {
+            return vcdb_database_datastore_contains(
+                &database, &datastore, value.key, 16); } },
+        { "index_get", [&]() {
+            value_size = sizeof(out);
+            return vcdb_database_index_get(
+                &database, &index, value.group, 16, &out, &value_size); } },
+        { "engine.index_get", [&]() {
+            value_size = sizeof(buffer);
+            return engine->index_get(
+                &database, &index, value.group, 16, buffer,
+                &value_size); } },
+        { "index_contains", [&]() {
+            return vcdb_database_index_contains(
+                &database, &index, value.group, 16); } },
+        { "datastore_put", [&]() {
+            value_size = sizeof(value);
+            return vcdb_database_datastore_put(
+                &transaction, &datastore, &value, &value_size); } },
+        { "engine.datastore_put", [&]() {
+            key_size = 16;
+            value_size = sizeof(value);
+            return engine->datastore_put(
+                &transaction, &datastore, value.key, &key_size, &value,
+                &value_size); } },
+        { "datastore_put_if_version", [&]() {
+            value_size = sizeof(value);
+            return vcdb_database_datastore_put_if_version(
+                &transaction, &datastore, &value, &value_size, 1); } },
+        { "datastore_merge", [&]() {
+            key_size = 16;
+            value_size = sizeof(value);
+            return vcdb_database_datastore_merge(
+                &transaction, &counters, value.key, &key_size, &value,
+                &value_size); } },
+        { "datastore_delete", [&]() {
+            key_size = 16;
+            return vcdb_database_datastore_delete(
+                &transaction, &datastore, value.key, &key_size); } },
+        { "datastore_delete_range", [&]() {
+            key_size = 16;
+            end_size = 16;
+            return vcdb_database_datastore_delete_range(
+                &transaction, &counters, value.key, &key_size, end_key,
+                &end_size); } },
+        { "index_delete", [&]() {
+            key_size = 16;
+            return vcdb_database_index_delete(
+                &transaction, &index, value.group, &key_size); } },
+        { "transaction_begin_rollback", [&]() {
+            vcdb_transaction_t t;
+            int r = vcdb_transaction_begin(&t, &database);
+            if (VCDB_STATUS_SUCCESS == r)
+            {
+                r = vcdb_transaction_rollback(&t);
+                dispose((disposable_t*)&t);
+            }
+            return r; } },
+        { "transaction_begin_commit", [&]() {
+            vcdb_transaction_t t;
+            int r = vcdb_transaction_begin(&t, &database);
+            if (VCDB_STATUS_SUCCESS == r)
+            {
+                r = vcdb_transaction_commit(&t);
+                dispose((disposable_t*)&t);
+            }
+            return r; } },
+    };
+
+    printf("{\n");
+    printf("  \"engine\": \"%s\",\n", engine_name.c_str());
+    printf("  \"iterations\": %" PRIu64 ",\n", iterations);
+    printf("  \"ns_per_call\": {\n");
+
+    int failures = 0;
+    for (size_t c = 0; c < cases.size(); ++c)
+    {
+        int status = VCDB_STATUS_SUCCESS;
+
+        /* warm up, and check that the call works at all. */
+        for (uint64_t i = 0; i < iterations / 10 + 1; ++i)
+        {
+            status |= cases[c].call();
+        }
+
+        auto start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            status |= cases[c].call();
+        }
+        auto end = chrono::steady_clock::now();
+
+        double ns =
+            chrono::duration<double, nano>(end - start).count() / iterations;
+
+        if (VCDB_STATUS_SUCCESS != status)
+        {
+            fprintf(stderr, "%s failed\n", cases[c].name.c_str());
+            ++failures;
+        }
+
+        printf("    \"%s\": %.1f%s\n", cases[c].name.c_str(), ns,
+            c + 1 < cases.size() ? "," : "");
+    }
+
+    printf("  }\n");
+    printf("}\n");
+
+    vcdb_transaction_rollback(&transaction);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+
+    return failures > 0 ? 1 : 0;
+}
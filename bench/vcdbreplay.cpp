@@ -0,0 +1,770 @@
+/**
+ * \file vcdbreplay.cpp
+ *
+ * \brief Replay a workload captured by a record engine against any engine.
+ *
+ * Usage: vcdbreplay --trace FILE [options]
+ *
+ *      --engine NAME           The registered engine to replay against
+ *                              (MEMDB).
+ *      --connection STRING     The connection string (vcdbreplay).
+ *      --threads N             Replay threads (1).  Each recorded thread is
+ *                              replayed in order by one replay thread.
+ *      --speed SPEED           original, to keep the recorded timing, or max
+ *                              (max).
+ *
+ * The replay goes through the public interface, so the library's own work is
+ * part of the measurement.  The recorded values are opaque, so each datastore
+ * is replayed with a pass-through serializer, and each index with key getters
+ * which return the secondary keys recorded with each put.  Operations of
+ * transactions which began before recording started are skipped, and data
+ * written before recording started is missing, so reads of it are counted as
+ * status mismatches: calls whose status differs from the recorded one.  The
+ * results are written to standard output as a single JSON object, with
+ * latencies in nanoseconds.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/index.h>
+#include <vcdb/record.h>
+#include <vcdb/transaction.h>
+
+#include "../test/memory_database.h"
+
+using namespace std;
+
+/**
+ * \brief The most indexes a replayed datastore can have.
+ */
+#define REPLAY_MAX_INDEXES 8
+
+static const char* replay_op_names[VCDB_RECORD_OP_COUNT] = {
+    "datastore_get", "index_get", "datastore_put", "datastore_merge",
+    "datastore_delete", "index_delete", "datastore_delete_range",
+    "transaction_begin", "transaction_commit", "transaction_rollback"
+};
+
+/**
+ * \brief A record read from the record file.
+ */
+struct replay_op
+{
+    vcdb_record_header_t header;
+    string name;
+    string key;
+    string value;
+    string extra;
+
+    /* the secondary keys of a put, by index slot of its datastore. */
+    bool has_index_key[REPLAY_MAX_INDEXES];
+    string index_keys[REPLAY_MAX_INDEXES];
+
+    /* the replay thread and datastore or index of this operation. */
+    unsigned worker;
+    vcdb_datastore_t* datastore;
+    vcdb_index_t* index;
+};
+
+/**
+ * \brief The deserialized form of a replayed value: the put it came from, or
+ * NULL if it was read back from the engine.
+ */
+struct replay_value
+{
+    const replay_op* op;
+};
+
+/**
+ * \brief A replayed datastore and its indexes.
+ */
+struct replay_datastore
+{
+    unique_ptr<vcdb_datastore_t> datastore;
+    vector<string> index_names;
+    bool merges = false;
+};
+
+/* the put being replayed on this thread, seen by the value reader. */
+static thread_local const replay_op* replay_current;
+
+/**
+ * \brief Get the primary key of a put.
+ */
+static void replay_key_getter(const void* value, void* key, size_t* key_size)
+{
+    const replay_op* op = ((const replay_value*)value)->op;
+
+    *key_size = 0;
+    if (NULL != op)
+    {
+        memcpy(key, op->key.data(), op->key.size());
+        *key_size = op->key.size();
+    }
+}
+
+/**
+ * \brief Read a value, attaching the put being replayed so the engine sees
+ * the recorded secondary keys.
+ */
+static int replay_value_reader(
+    const void* /*input*/, size_t /*size*/, void* value)
+{
+    ((replay_value*)value)->op = replay_current;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write the recorded serialized value of a put.
+ */
+static int replay_value_writer(const void* value, void* output, size_t* size)
+{
+    const replay_op* op = ((const replay_value*)value)->op;
+
+    if (*size < op->value.size())
+    {
+        *size = op->value.size();
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, op->value.data(), op->value.size());
+    *size = op->value.size();
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Fold a merge operand by replacing the value with it.
+ */
+static int replay_value_merger(
+    const void* /*existing*/, size_t /*existing_size*/,
+    const void* operand, size_t operand_size,
+    void* output, size_t* output_size)
+{
+    if (*output_size < operand_size)
+    {
+        *output_size = operand_size;
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, operand, operand_size);
+    *output_size = operand_size;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Get the recorded secondary key for index slot I.
+ */
+template <int I>
+static void replay_index_getter(
+    const void* value, void* key, size_t* key_size)
+{
+    const replay_op* op = ((const replay_value*)value)->op;
+
+    *key_size = 0;
+    if (NULL != op)
+    {
+        memcpy(key, op->index_keys[I].data(), op->index_keys[I].size());
+        *key_size = op->index_keys[I].size();
+    }
+}
+
+/**
+ * \brief Check whether a value was recorded with a key for index slot I.
+ */
+template <int I>
+static bool replay_index_predicate(const void* value)
+{
+    const replay_op* op = ((const replay_value*)value)->op;
+
+    return NULL != op && op->has_index_key[I];
+}
+
+static vcdb_index_secondary_key_getter_method_t
+replay_index_getters[REPLAY_MAX_INDEXES] = {
+    &replay_index_getter<0>, &replay_index_getter<1>,
+    &replay_index_getter<2>, &replay_index_getter<3>,
+    &replay_index_getter<4>, &replay_index_getter<5>,
+    &replay_index_getter<6>, &replay_index_getter<7>
+};
+
+static vcdb_index_predicate_method_t
+replay_index_predicates[REPLAY_MAX_INDEXES] = {
+    &replay_index_predicate<0>, &replay_index_predicate<1>,
+    &replay_index_predicate<2>, &replay_index_predicate<3>,
+    &replay_index_predicate<4>, &replay_index_predicate<5>,
+    &replay_index_predicate<6>, &replay_index_predicate<7>
+};
+
+/**
+ * \brief Read all records of a record file.
+ */
+static bool replay_read(const char* path, vector<replay_op>* ops)
+{
+    FILE* file = fopen(path, "rb");
+    char magic[VCDB_RECORD_MAGIC_SIZE];
+
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    if (1 != fread(magic, sizeof(magic), 1, file)
+     || 0 != memcmp(magic, VCDB_RECORD_MAGIC, sizeof(magic)))
+    {
+        fclose(file);
+        return false;
+    }
+
+    replay_op op;
+    while (1 == fread(&op.header, sizeof(op.header), 1, file))
+    {
+        string* parts[] = { &op.name, &op.key, &op.value, &op.extra };
+        uint32_t sizes[] = {
+            op.header.name_size, op.header.key_size, op.header.value_size,
+            op.header.extra_size };
+
+        if (op.header.op >= VCDB_RECORD_OP_COUNT)
+        {
+            fclose(file);
+            return false;
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            parts[i]->resize(sizes[i]);
+            if (sizes[i] > 0
+             && 1 != fread(&(*parts[i])[0], sizes[i], 1, file))
+            {
+                fclose(file);
+                return false;
+            }
+        }
+
+        ops->push_back(op);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+/**
+ * \brief Parse the secondary keys of a put into (index name, key) pairs.
+ */
+static vector<pair<string, string>> replay_index_keys(const string& extra)
+{
+    vector<pair<string, string>> keys;
+    size_t offset = 0;
+
+    while (offset + sizeof(vcdb_record_index_key_t) <= extra.size())
+    {
+        vcdb_record_index_key_t entry;
+        memcpy(&entry, extra.data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        if (offset + entry.name_size + entry.key_size > extra.size())
+        {
+            break;
+        }
+
+        keys.emplace_back(
+            extra.substr(offset, entry.name_size),
+            extra.substr(offset + entry.name_size, entry.key_size));
+        offset += entry.name_size + entry.key_size;
+    }
+
+    return keys;
+}
+
+/**
+ * \brief The results of a replay thread, by operation.
+ */
+struct replay_result
+{
+    vector<uint64_t> latencies[VCDB_RECORD_OP_COUNT];
+    uint64_t mismatches[VCDB_RECORD_OP_COUNT] = { 0 };
+    uint64_t skipped = 0;
+};
+
+/**
+ * \brief Replay one operation, returning a status code.
+ */
+static int replay_run_op(
+    vcdb_database_t* database, const replay_op& op,
+    map<uint64_t, unique_ptr<vcdb_transaction_t>>& transactions,
+    bool* skipped)
+{
+    vcdb_transaction_t* transaction = NULL;
+    replay_value value = { &op };
+    size_t key_size = op.key.size();
+    size_t value_size = op.value.size();
+    char buffer[sizeof(replay_value)];
+    int retval;
+
+    *skipped = false;
+
+    /* writes and transaction ends need the replayed transaction. */
+    if (0 != op.header.transaction
+     && VCDB_RECORD_OP_TRANSACTION_BEGIN != op.header.op)
+    {
+        auto t = transactions.find(op.header.transaction);
+        if (transactions.end() == t)
+        {
+            *skipped = true;
+            return VCDB_STATUS_SUCCESS;
+        }
+
+        transaction = t->second.get();
+    }
+
+    switch (op.header.op)
+    {
+        case VCDB_RECORD_OP_DATASTORE_GET:
+            value_size = sizeof(buffer);
+            return vcdb_database_datastore_get(
+                database, op.datastore, (void*)op.key.data(), key_size,
+                buffer, &value_size);
+
+        case VCDB_RECORD_OP_INDEX_GET:
+            value_size = sizeof(buffer);
+            return vcdb_database_index_get(
+                database, op.index, (void*)op.key.data(), key_size, buffer,
+                &value_size);
+
+        case VCDB_RECORD_OP_DATASTORE_PUT:
+            replay_current = &op;
+            value_size = sizeof(value);
+            retval = vcdb_database_datastore_put(
+                transaction, op.datastore, &value, &value_size);
+            replay_current = NULL;
+            return retval;
+
+        case VCDB_RECORD_OP_DATASTORE_MERGE:
+            return vcdb_database_datastore_merge(
+                transaction, op.datastore, (void*)op.key.data(), &key_size,
+                (void*)op.value.data(), &value_size);
+
+        case VCDB_RECORD_OP_DATASTORE_DELETE:
+            return vcdb_database_datastore_delete(
+                transaction, op.datastore, (void*)op.key.data(), &key_size);
+
+        case VCDB_RECORD_OP_INDEX_DELETE:
+            return vcdb_database_index_delete(
+                transaction, op.index, (void*)op.key.data(), &key_size);
+
+        case VCDB_RECORD_OP_DATASTORE_DELETE_RANGE:
+            return vcdb_database_datastore_delete_range(
+                transaction, op.datastore, (void*)op.key.data(), &key_size,
+                (void*)op.value.data(), &value_size);
+
+        case VCDB_RECORD_OP_TRANSACTION_BEGIN:
+        {
+            unique_ptr<vcdb_transaction_t> t(new vcdb_transaction_t);
+            retval = vcdb_transaction_begin(t.get(), database);
+            if (VCDB_STATUS_SUCCESS == retval)
+            {
+                transactions[op.header.transaction] = move(t);
+            }
+            return retval;
+        }
+
+        case VCDB_RECORD_OP_TRANSACTION_COMMIT:
+        case VCDB_RECORD_OP_TRANSACTION_ROLLBACK:
+            retval =
+                VCDB_RECORD_OP_TRANSACTION_COMMIT == op.header.op
+                    ? vcdb_transaction_commit(transaction)
+                    : vcdb_transaction_rollback(transaction);
+            dispose((disposable_t*)transaction);
+            transactions.erase(op.header.transaction);
+            return retval;
+
+        default:
+            return VCDB_ERROR_INVALID_PARAMETER;
+    }
+}
+
+/**
+ * \brief The body of a replay thread.
+ */
+static void replay_worker(
+    vcdb_database_t* database, const vector<replay_op>* ops, unsigned worker,
+    bool original_speed, chrono::steady_clock::time_point start,
+    replay_result* result)
+{
+    map<uint64_t, unique_ptr<vcdb_transaction_t>> transactions;
+
+    for (auto& op : *ops)
+    {
+        if (op.worker != worker)
+        {
+            continue;
+        }
+
+        if (original_speed)
+        {
+            this_thread::sleep_until(
+                start + chrono::nanoseconds(op.header.time));
+        }
+
+        bool skipped;
+        auto begin = chrono::steady_clock::now();
+        int retval = replay_run_op(database, op, transactions, &skipped);
+        auto end = chrono::steady_clock::now();
+
+        if (skipped)
+        {
+            ++result->skipped;
+            continue;
+        }
+
+        if (retval != op.header.status)
+        {
+            ++result->mismatches[op.header.op];
+        }
+
+        result->latencies[op.header.op].push_back(
+            chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+    }
+
+    /* roll back transactions left open when recording stopped. */
+    for (auto& t : transactions)
+    {
+        vcdb_transaction_rollback(t.second.get());
+        dispose((disposable_t*)t.second.get());
+    }
+}
+
+/**
+ * \brief Main entry point for the replay tool.
+ */
+int main(int argc, char* argv[])
+{
+    string trace;
+    string engine = MEMORY_DATABASE_ENGINE;
+    string connection = "vcdbreplay";
+    unsigned threads = 1;
+    bool original_speed = false;
+    bool usage = false;
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        string arg = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (NULL == val)
+        {
+            usage = true;
+        }
+        else if ("--trace" == arg)
+        {
+            trace = val;
+        }
+        else if ("--engine" == arg)
+        {
+            engine = val;
+        }
+        else if ("--connection" == arg)
+        {
+            connection = val;
+        }
+        else if ("--threads" == arg)
+        {
+            threads = strtoul(val, nullptr, 10);
+        }
+        else if ("--speed" == arg)
+        {
+            original_speed = !strcmp("original", val);
+            usage = usage || (!original_speed && strcmp("max", val));
+        }
+        else
+        {
+            usage = true;
+        }
+    }
+
+    if (usage || trace.empty() || 0 == threads)
+    {
+        fprintf(stderr,
+            "usage: %s --trace FILE [--engine NAME] [--connection STRING]\n"
+            "       [--threads N] [--speed original|max]\n", argv[0]);
+        return 1;
+    }
+
+    vector<replay_op> ops;
+    if (!replay_read(trace.c_str(), &ops))
+    {
+        fprintf(stderr, "could not read record file %s\n", trace.c_str());
+        return 1;
+    }
+
+    /* find the datastores and indexes used by the workload. */
+    map<string, replay_datastore> datastores;
+    map<string, string> index_datastores;
+    for (auto& op : ops)
+    {
+        switch (op.header.op)
+        {
+            case VCDB_RECORD_OP_INDEX_GET:
+            case VCDB_RECORD_OP_INDEX_DELETE:
+                index_datastores[op.name] = op.extra;
+                datastores[op.extra];
+                break;
+
+            case VCDB_RECORD_OP_DATASTORE_PUT:
+                for (auto& key : replay_index_keys(op.extra))
+                {
+                    index_datastores[key.first] = op.name;
+                }
+                datastores[op.name];
+                break;
+
+            case VCDB_RECORD_OP_DATASTORE_MERGE:
+                datastores[op.name].merges = true;
+                break;
+
+            case VCDB_RECORD_OP_DATASTORE_GET:
+            case VCDB_RECORD_OP_DATASTORE_DELETE:
+            case VCDB_RECORD_OP_DATASTORE_DELETE_RANGE:
+                datastores[op.name];
+                break;
+        }
+    }
+
+    for (auto& index : index_datastores)
+    {
+        auto& ds = datastores[index.second];
+        if (ds.index_names.size() >= REPLAY_MAX_INDEXES)
+        {
+            fprintf(stderr, "too many indexes on %s\n", index.second.c_str());
+            return 1;
+        }
+
+        ds.index_names.push_back(index.first);
+    }
+
+    /* build the database. */
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    map<string, unique_ptr<vcdb_index_t>> indexes;
+
+    register_memory_database();
+
+    int retval =
+        vcdb_builder_init(&builder, engine.c_str(), connection.c_str());
+    for (auto& ds : datastores)
+    {
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            break;
+        }
+
+        ds.second.datastore.reset(new vcdb_datastore_t);
+        retval =
+            vcdb_datastore_init(
+                ds.second.datastore.get(), ds.first.c_str(),
+                sizeof(replay_value), &replay_key_getter,
+                &replay_value_reader, &replay_value_writer);
+        if (VCDB_STATUS_SUCCESS == retval && ds.second.merges)
+        {
+            retval =
+                vcdb_datastore_value_merger_set(
+                    ds.second.datastore.get(), &replay_value_merger);
+        }
+        if (VCDB_STATUS_SUCCESS == retval)
+        {
+            retval =
+                vcdb_builder_add_datastore(
+                    &builder, ds.second.datastore.get());
+        }
+
+        for (size_t i = 0;
+             i < ds.second.index_names.size() && VCDB_STATUS_SUCCESS == retval;
+             ++i)
+        {
+            auto& index = indexes[ds.second.index_names[i]];
+            index.reset(new vcdb_index_t);
+            retval =
+                vcdb_index_init(
+                    index.get(), ds.second.datastore.get(),
+                    ds.second.index_names[i].c_str(),
+                    replay_index_getters[i]);
+            if (VCDB_STATUS_SUCCESS == retval)
+            {
+                retval =
+                    vcdb_index_predicate_set(
+                        index.get(), replay_index_predicates[i]);
+            }
+            if (VCDB_STATUS_SUCCESS == retval)
+            {
+                retval = vcdb_builder_add_index(&builder, index.get());
+            }
+        }
+    }
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_database_create_from_builder(&database, &builder);
+    }
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "database create failed: %d\n", retval);
+        return 1;
+    }
+
+    /* assign each recorded thread to a replay thread, keeping transactions
+     * on the thread which began them. */
+    map<uint32_t, unsigned> workers;
+    map<uint64_t, unsigned> transaction_workers;
+    for (auto& op : ops)
+    {
+        auto w = workers.find(op.header.thread);
+        if (workers.end() == w)
+        {
+            unsigned next = workers.size() % threads;
+            w = workers.emplace(op.header.thread, next).first;
+        }
+
+        op.worker = w->second;
+        if (VCDB_RECORD_OP_TRANSACTION_BEGIN == op.header.op)
+        {
+            transaction_workers[op.header.transaction] = op.worker;
+        }
+        else if (0 != op.header.transaction)
+        {
+            auto t = transaction_workers.find(op.header.transaction);
+            if (transaction_workers.end() != t)
+            {
+                op.worker = t->second;
+            }
+        }
+
+        op.datastore = NULL;
+        op.index = NULL;
+        auto ds = datastores.find(op.name);
+        if (datastores.end() != ds)
+        {
+            op.datastore = ds->second.datastore.get();
+        }
+        auto index = indexes.find(op.name);
+        if (indexes.end() != index)
+        {
+            op.index = index->second.get();
+        }
+
+        /* the secondary keys of a put, by index slot. */
+        if (VCDB_RECORD_OP_DATASTORE_PUT == op.header.op)
+        {
+            auto& names = datastores[op.name].index_names;
+            for (size_t i = 0; i < REPLAY_MAX_INDEXES; ++i)
+            {
+                op.has_index_key[i] = false;
+            }
+            for (auto& key : replay_index_keys(op.extra))
+            {
+                size_t slot =
+                    find(names.begin(), names.end(), key.first)
+                  - names.begin();
+                op.has_index_key[slot] = true;
+                op.index_keys[slot] = key.second;
+            }
+        }
+    }
+
+    /* replay. */
+    vector<replay_result> results(threads);
+    vector<thread> workers_threads;
+    auto start = chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers_threads.emplace_back(
+            replay_worker, &database, &ops, t, original_speed, start,
+            &results[t]);
+    }
+    for (auto& w : workers_threads)
+    {
+        w.join();
+    }
+    double seconds =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    /* merge the per-thread results. */
+    replay_result total;
+    for (auto& result : results)
+    {
+        total.skipped += result.skipped;
+        for (int op = 0; op < VCDB_RECORD_OP_COUNT; ++op)
+        {
+            total.latencies[op].insert(
+                total.latencies[op].end(), result.latencies[op].begin(),
+                result.latencies[op].end());
+            total.mismatches[op] += result.mismatches[op];
+        }
+    }
+
+    uint64_t replayed = 0;
+    for (int op = 0; op < VCDB_RECORD_OP_COUNT; ++op)
+    {
+        replayed += total.latencies[op].size();
+    }
+
+    printf("{\n");
+    printf("  \"engine\": \"%s\",\n", engine.c_str());
+    printf("  \"records\": %zu,\n", ops.size());
+    printf("  \"replayed\": %" PRIu64 ",\n", replayed);
+    printf("  \"skipped\": %" PRIu64 ",\n", total.skipped);
+    printf("  \"threads\": %u,\n", threads);
+    printf("  \"speed\": \"%s\",\n", original_speed ? "original" : "max");
+    printf("  \"seconds\": %.6f,\n", seconds);
+    printf("  \"throughput\": %.1f,\n", replayed / seconds);
+    printf("  \"operations\": {");
+    const char* sep = "\n";
+    for (int op = 0; op < VCDB_RECORD_OP_COUNT; ++op)
+    {
+        auto& l = total.latencies[op];
+        if (l.empty())
+        {
+            continue;
+        }
+
+        sort(l.begin(), l.end());
+        uint64_t sum = 0;
+        for (uint64_t v : l)
+        {
+            sum += v;
+        }
+        size_t p99 = (size_t)ceil(0.99 * l.size());
+
+        printf(
+            "%s    \"%s\": {\"count\": %zu, \"status_mismatches\": %" PRIu64
+            ", \"mean_ns\": %" PRIu64 ", \"p99_ns\": %" PRIu64
+            ", \"max_ns\": %" PRIu64 "}",
+            sep, replay_op_names[op], l.size(), total.mismatches[op],
+            sum / l.size(), l[p99 > 0 ? p99 - 1 : 0], l.back());
+        sep = ",\n";
+    }
+    printf("\n  }\n");
+    printf("}\n");
+
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+
+    return 0;
+}
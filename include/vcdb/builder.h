@@ -19,6 +19,7 @@
 #include <vcdb/engine.h>
 #include <vcdb/error_codes.h>
 #include <vcdb/index.h>
+#include <vpr/allocator.h>
 #include <vpr/disposable.h>
 
 /* make this header C++ friendly. */
@@ -27,6 +28,7 @@ extern "C" {
 #endif  //__cplusplus
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /**
@@ -34,6 +36,15 @@ extern "C" {
  */
 #define DEFAULT_INSTANCE_SIZE 20
 
+/**
+ * \brief Clock method used to time engine methods.
+ *
+ * The clock must be monotonic.  Latencies are reported in its units.
+ *
+ * \returns the current time.
+ */
+typedef uint64_t (*vcdb_builder_clock_method_t)(void);
+
 /**
  * \brief The instance type for a stored datastore / index instance.
  */
@@ -87,9 +98,26 @@ typedef struct vcdb_builder_datastore_instance
 
     /**
      * \brief The handle to the external database object.
+     *
+     * The database engine owns this slot.  Engines should store their
+     * per-datastore or per-index object (tree root, hash table, file, etc.)
+     * here when the database is created or opened, and resolve it with
+     * vcdb_builder_datastore_handle_get() or vcdb_builder_index_handle_get().
      */
     void* handle;
 
+    /**
+     * \brief The number of deserialized values to keep in the database read
+     * cache for this datastore, or 0 if the datastore is not cached.
+     */
+    size_t cache_size;
+
+    /**
+     * \brief The number of keys for which to size the negative-lookup filter
+     * of this datastore or index, or 0 if it has no filter.
+     */
+    size_t filter_size;
+
 } vcdb_builder_datastore_instance_t;
 
 /**
@@ -135,8 +163,205 @@ typedef struct vcdb_builder
      * \brief Set to true when the database has been opened.
      */
     bool database_opened;
+
+    /**
+     * \brief Open addressed hash table of instance array offsets, keyed by
+     * instance type and name.
+     *
+     * This table is built when the database is created or opened.
+     */
+    size_t* schema_name_table;
+
+    /**
+     * \brief The number of slots in the schema name table.
+     */
+    size_t schema_name_table_size;
+
+    /**
+     * \brief For each instance array entry, the offset of its first index in
+     * \ref schema_index_list.
+     *
+     * This array has instance_array_size + 1 entries, so the indexes of the
+     * datastore at offset i are found in the half-open range
+     * [schema_index_offset[i], schema_index_offset[i + 1]).
+     */
+    size_t* schema_index_offset;
+
+    /**
+     * \brief The secondary indexes in this builder, grouped by datastore.
+     */
+    vcdb_index_t** schema_index_list;
+
+    /**
+     * \brief The clock used to time engine methods, or NULL if latency
+     * histograms are disabled.
+     */
+    vcdb_builder_clock_method_t latency_clock;
+
+    /**
+     * \brief Set to true when operation counters are kept.
+     */
+    bool stats_enabled;
+
+    /**
+     * \brief The allocator used for all memory owned by this builder and the
+     * databases built from it, or NULL to use the C library allocator.
+     */
+    allocator_options_t* alloc_opts;
+
 } vcdb_builder_t;
 
+/**
+ * \brief Get the engine handle for a datastore.
+ *
+ * The correlation ID assigned by vcdb_builder_add_datastore() is the dense
+ * offset of the datastore in the builder's instance array, so this is a single
+ * array access.  Engines should use it on every get and put instead of
+ * resolving their datastore object by name or pointer.
+ *
+ * \param builder   The builder to which the datastore was added.
+ * \param datastore The datastore whose handle is returned.
+ *
+ * \returns the engine handle for this datastore.
+ */
+static inline void* vcdb_builder_datastore_handle_get(
+    const vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore)
+{
+    return builder->instance_array[datastore->correlation_id].handle;
+}
+
+/**
+ * \brief Set the engine handle for a datastore.
+ *
+ * Engines should call this for each datastore when the database is created or
+ * opened.
+ *
+ * \param builder   The builder to which the datastore was added.
+ * \param datastore The datastore whose handle is set.
+ * \param handle    The engine handle for this datastore.
+ */
+static inline void vcdb_builder_datastore_handle_set(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    void* handle)
+{
+    builder->instance_array[datastore->correlation_id].handle = handle;
+}
+
+/**
+ * \brief Get the engine handle for a secondary index.
+ *
+ * The correlation ID assigned by vcdb_builder_add_index() is the dense offset
+ * of the index in the builder's instance array, so this is a single array
+ * access.
+ *
+ * \param builder   The builder to which the index was added.
+ * \param index     The index whose handle is returned.
+ *
+ * \returns the engine handle for this index.
+ */
+static inline void* vcdb_builder_index_handle_get(
+    const vcdb_builder_t* builder,
+    const vcdb_index_t* index)
+{
+    return builder->instance_array[index->correlation_id].handle;
+}
+
+/**
+ * \brief Set the engine handle for a secondary index.
+ *
+ * Engines should call this for each index when the database is created or
+ * opened.
+ *
+ * \param builder   The builder to which the index was added.
+ * \param index     The index whose handle is set.
+ * \param handle    The engine handle for this index.
+ */
+static inline void vcdb_builder_index_handle_set(
+    vcdb_builder_t* builder,
+    const vcdb_index_t* index,
+    void* handle)
+{
+    builder->instance_array[index->correlation_id].handle = handle;
+}
+
+/**
+ * \brief Allocate memory using the allocator of the given builder.
+ *
+ * The library and database engines use this for every buffer whose lifetime
+ * is bound to the builder or to a database built from it.
+ *
+ * \param builder   The builder whose allocator is used.
+ * \param size      The size of the memory to allocate.
+ *
+ * \returns the allocated memory, or NULL on failure.
+ */
+static inline void* vcdb_builder_memory_allocate(
+    vcdb_builder_t* builder,
+    size_t size)
+{
+    if (NULL == builder->alloc_opts)
+    {
+        return malloc(size);
+    }
+
+    return allocate(builder->alloc_opts, size);
+}
+
+/**
+ * \brief Resize memory previously allocated with
+ * vcdb_builder_memory_allocate().
+ *
+ * On failure, the original memory is unchanged and still owned by the caller.
+ *
+ * \param builder   The builder whose allocator is used.
+ * \param mem       The memory to resize, or NULL.
+ * \param old_size  The current size of the memory.
+ * \param new_size  The new size of the memory.
+ *
+ * \returns the resized memory, or NULL on failure.
+ */
+static inline void* vcdb_builder_memory_reallocate(
+    vcdb_builder_t* builder,
+    void* mem,
+    size_t old_size,
+    size_t new_size)
+{
+    if (NULL == builder->alloc_opts)
+    {
+        return realloc(mem, new_size);
+    }
+
+    if (NULL == mem)
+    {
+        return allocate(builder->alloc_opts, new_size);
+    }
+
+    return reallocate(builder->alloc_opts, mem, old_size, new_size);
+}
+
+/**
+ * \brief Release memory previously allocated with
+ * vcdb_builder_memory_allocate().
+ *
+ * \param builder   The builder whose allocator is used.
+ * \param mem       The memory to release, or NULL.
+ */
+static inline void vcdb_builder_memory_release(
+    vcdb_builder_t* builder,
+    void* mem)
+{
+    if (NULL == builder->alloc_opts)
+    {
+        free(mem);
+    }
+    else if (NULL != mem)
+    {
+        release(builder->alloc_opts, mem);
+    }
+}
+
 /**
  * \brief Initialize a builder instance from an engine string and a connection
  * string.
@@ -159,6 +384,34 @@ int vcdb_builder_init(
     const char* engine,
     const char* connect);
 
+/**
+ * \brief Initialize a builder instance which uses the given allocator.
+ *
+ * This behaves like vcdb_builder_init(), except that the builder, the
+ * databases built from it, and the transactions against those databases
+ * allocate all of their memory from the given allocator.  Database engines are
+ * expected to do the same via vcdb_builder_memory_allocate().  This allows a
+ * memory cap, an arena, or instrumentation to be applied to the library.
+ *
+ * The allocator must remain in scope until the builder is disposed.
+ *
+ * \param builder       The builder instance to initialize.
+ * \param alloc_opts    The allocator to use, or NULL to use the C library
+ *                      allocator.
+ * \param engine        The database engine to use.
+ * \param connect       The implementation-dependent connection string for a
+ *                      database instance.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_init_with_allocator(
+    vcdb_builder_t* builder,
+    allocator_options_t* alloc_opts,
+    const char* engine,
+    const char* connect);
+
 /**
  * \brief Add a datastore to the builder.
  *
@@ -193,6 +446,194 @@ int vcdb_builder_add_index(
     vcdb_builder_t* builder,
     vcdb_index_t* index);
 
+/**
+ * \brief Enable the database read cache for a datastore.
+ *
+ * When enabled, vcdb_database_datastore_get() keeps up to the given number of
+ * deserialized values for this datastore in memory, keyed by primary key.  A
+ * cached value is returned without calling the engine or the value reader.
+ * Keys written by a transaction are invalidated when it commits.  The cache
+ * must be sized before the database is created or opened.
+ *
+ * \param builder   The builder to which the datastore was added.
+ * \param datastore The datastore to cache.
+ * \param entries   The number of values to cache, or 0 to disable caching.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the datastore is not in this
+ *            builder, or if the database is already open.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_cache_size_set(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    size_t entries);
+
+/**
+ * \brief Enable the negative-lookup filter for a datastore.
+ *
+ * When enabled, the library keeps a blocked bloom filter of the keys put into
+ * this datastore.  vcdb_database_datastore_get() returns
+ * VCDB_ERROR_VALUE_NOT_FOUND without calling the engine for most keys which
+ * were never put.  Deleted keys stay in the filter, so they still go to the
+ * engine.  The filter must be sized before the database is created or opened.
+ *
+ * A filter is complete for a database created in this process.  When a
+ * database is opened, the filter is loaded using the engine's filter_load
+ * method.  If the engine can't supply it, the filter is disabled until the
+ * database is next created.
+ *
+ * \param builder   The builder to which the datastore was added.
+ * \param datastore The datastore to filter.
+ * \param keys      The expected number of keys, or 0 to disable the filter.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the datastore is not in this
+ *            builder, or if the database is already open.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_filter_size_set(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    size_t keys);
+
+/**
+ * \brief Enable the negative-lookup filter for a secondary index.
+ *
+ * This works like vcdb_builder_datastore_filter_size_set(), using secondary
+ * keys, and lets vcdb_database_index_get() reject keys which were never put.
+ *
+ * \param builder   The builder to which the index was added.
+ * \param index     The index to filter.
+ * \param keys      The expected number of keys, or 0 to disable the filter.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the index is not in this builder,
+ *            or if the database is already open.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_index_filter_size_set(
+    vcdb_builder_t* builder,
+    const vcdb_index_t* index,
+    size_t keys);
+
+/**
+ * \brief Enable latency histograms for the engine methods of a database.
+ *
+ * When enabled, every get, put, merge, delete, index get, index delete,
+ * begin, commit, and rollback sent to the engine is timed and recorded in a
+ * log-bucketed histogram for its datastore or index.  Recording is lock free.
+ * Use vcdb_database_latency_get() to read a summary of a histogram.  Latency
+ * histograms must be enabled before the database is created or opened.
+ *
+ * \param builder   The builder for the database.
+ * \param clock     The clock to use, or NULL to use the monotonic clock in
+ *                  nanoseconds.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database is already open.
+ *          * VCDB_ERROR_NOT_SUPPORTED if the target does not have lock free
+ *            64-bit atomics.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_latency_histograms_enable(
+    vcdb_builder_t* builder,
+    vcdb_builder_clock_method_t clock);
+
+/**
+ * \brief Enable operation counters for the datastores and indexes of a
+ * database.
+ *
+ * When enabled, gets, puts, deletes, commits, and rollbacks are counted in
+ * per-thread stripes, and vcdb_database_stats() returns a snapshot of the
+ * counters.  When disabled, which is the default, each operation only pays for
+ * a single branch.  Operation counters must be enabled before the database is
+ * created or opened.
+ *
+ * \param builder   The builder for the database.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database is already open.
+ *          * VCDB_ERROR_NOT_SUPPORTED if the target does not have lock free
+ *            64-bit atomics.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_stats_enable(
+    vcdb_builder_t* builder);
+
+/**
+ * \brief Find a datastore in the builder by name.
+ *
+ * This lookup takes constant time, using the schema built when the database
+ * was created or opened.
+ *
+ * \param builder   The builder instance to search.
+ * \param datastore Pointer to receive the datastore on success.
+ * \param name      The name of the datastore to find.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_VALUE_NOT_FOUND if no datastore has this name.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database has not been created
+ *            or opened.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_find(
+    vcdb_builder_t* builder,
+    vcdb_datastore_t** datastore,
+    const char* name);
+
+/**
+ * \brief Find a secondary index in the builder by name.
+ *
+ * This lookup takes constant time, using the schema built when the database
+ * was created or opened.
+ *
+ * \param builder   The builder instance to search.
+ * \param index     Pointer to receive the index on success.
+ * \param name      The name of the index to find.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_VALUE_NOT_FOUND if no index has this name.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database has not been created
+ *            or opened.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_index_find(
+    vcdb_builder_t* builder,
+    vcdb_index_t** index,
+    const char* name);
+
+/**
+ * \brief Get the secondary indexes which belong to the given datastore.
+ *
+ * The returned array is owned by the builder and remains valid while the
+ * database is open.
+ *
+ * \param builder   The builder instance to search.
+ * \param datastore The datastore whose indexes are returned.  It must have
+ *                  been added to this builder.
+ * \param indexes   Pointer to receive the array of indexes.
+ * \param count     Pointer to receive the number of indexes in the array.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the datastore is not in this
+ *            builder, or if the database has not been created or opened.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_indexes_get(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    vcdb_index_t* const** indexes,
+    size_t* count);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
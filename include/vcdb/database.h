@@ -10,6 +10,7 @@
 #ifndef VCDB_DATABASE_HEADER_GUARD
 #define VCDB_DATABASE_HEADER_GUARD
 
+#include <stdint.h>
 #include <vcdb/builder.h>
 #include <vpr/disposable.h>
 
@@ -18,6 +19,12 @@
 extern "C" {
 #endif  //__cplusplus
 
+/* forward declarations for structures. */
+struct vcdb_cache;
+struct vcdb_filter;
+struct vcdb_stats;
+struct vcdb_latency;
+
 /**
  * \brief The database interface is used to perform operations on the database.
  *
@@ -42,8 +49,223 @@ typedef struct vcdb_database
      */
     void* database_engine_context;
 
+    /**
+     * \brief Read caches indexed by datastore correlation ID, or NULL if no
+     * datastore in this database is cached.
+     */
+    struct vcdb_cache** datastore_cache;
+
+    /**
+     * \brief Negative-lookup filters indexed by datastore or index
+     * correlation ID, or NULL if nothing in this database is filtered.
+     */
+    struct vcdb_filter** instance_filter;
+
+    /**
+     * \brief Operation counters, kept in per-thread stripes.
+     */
+    struct vcdb_stats* stats;
+
+    /**
+     * \brief Engine method latency histograms, or NULL if they are disabled.
+     */
+    struct vcdb_latency* latency;
+
 } vcdb_database_t;
 
+/**
+ * \brief Operation counters for a single datastore or index.
+ */
+typedef struct vcdb_database_counters
+{
+    /**
+     * \brief The number of gets.
+     */
+    uint64_t gets;
+
+    /**
+     * \brief The number of gets which found a value.
+     */
+    uint64_t hits;
+
+    /**
+     * \brief The number of gets which found no value.
+     */
+    uint64_t misses;
+
+    /**
+     * \brief The number of hits served from the read cache.
+     */
+    uint64_t cache_hits;
+
+    /**
+     * \brief The number of misses rejected by the negative-lookup filter.
+     */
+    uint64_t filter_rejects;
+
+    /**
+     * \brief The number of puts and merges.
+     */
+    uint64_t puts;
+
+    /**
+     * \brief The number of deletes, with each range delete counted once.
+     */
+    uint64_t deletes;
+
+    /**
+     * \brief The number of VCDB_ERROR_WOULD_TRUNCATE retries of buffers
+     * which were too small.
+     */
+    uint64_t truncate_retries;
+
+    /**
+     * \brief The number of bytes serialized by puts and merges.
+     */
+    uint64_t bytes_serialized;
+
+    /**
+     * \brief The number of bytes deserialized by gets.
+     */
+    uint64_t bytes_deserialized;
+
+} vcdb_database_counters_t;
+
+/**
+ * \brief A snapshot of the operation counters of a database.
+ *
+ * The snapshot is owned by the caller and must be disposed of by calling
+ * dispose() on it.
+ */
+typedef struct vcdb_database_stats
+{
+    /**
+     * \brief This structure is disposable.
+     */
+    disposable_t hdr;
+
+    /**
+     * \brief The number of committed transactions.
+     */
+    uint64_t commits;
+
+    /**
+     * \brief The number of rolled back transactions.
+     */
+    uint64_t rollbacks;
+
+    /**
+     * \brief The number of entries in the instances array.
+     */
+    size_t instance_count;
+
+    /**
+     * \brief Counters for each datastore and index, indexed by correlation ID.
+     */
+    vcdb_database_counters_t* instances;
+
+} vcdb_database_stats_t;
+
+/**
+ * \brief The engine methods timed by latency histograms.
+ */
+typedef enum vcdb_database_method
+{
+    /**
+     * \brief Datastore gets, including versioned gets.
+     */
+    VCDB_DATABASE_METHOD_GET,
+
+    /**
+     * \brief Datastore puts, including versioned puts.
+     */
+    VCDB_DATABASE_METHOD_PUT,
+
+    /**
+     * \brief Datastore merges.
+     */
+    VCDB_DATABASE_METHOD_MERGE,
+
+    /**
+     * \brief Datastore deletes of a single key.
+     */
+    VCDB_DATABASE_METHOD_DELETE,
+
+    /**
+     * \brief Datastore range deletes.
+     */
+    VCDB_DATABASE_METHOD_DELETE_RANGE,
+
+    /**
+     * \brief Secondary index gets.
+     */
+    VCDB_DATABASE_METHOD_INDEX_GET,
+
+    /**
+     * \brief Secondary index deletes.
+     */
+    VCDB_DATABASE_METHOD_INDEX_DELETE,
+
+    /**
+     * \brief Transaction begins, which are database-wide.
+     */
+    VCDB_DATABASE_METHOD_BEGIN,
+
+    /**
+     * \brief Transaction commits, which are database-wide.
+     */
+    VCDB_DATABASE_METHOD_COMMIT,
+
+    /**
+     * \brief Transaction rollbacks, which are database-wide.
+     */
+    VCDB_DATABASE_METHOD_ROLLBACK,
+
+    VCDB_DATABASE_METHOD_COUNT
+
+} vcdb_database_method_t;
+
+/**
+ * \brief A summary of the latency histogram of an engine method.
+ *
+ * Latencies are in the units of the builder's clock.  Percentiles are the
+ * upper bound of the histogram bucket in which they fall, so they are within
+ * 25% of the recorded latency.
+ */
+typedef struct vcdb_database_latency
+{
+    /**
+     * \brief The number of timed calls.
+     */
+    uint64_t count;
+
+    /**
+     * \brief The mean latency.
+     */
+    uint64_t mean;
+
+    /**
+     * \brief The median latency.
+     */
+    uint64_t p50;
+
+    /**
+     * \brief The 99th percentile latency.
+     */
+    uint64_t p99;
+
+    /**
+     * \brief The 99.9th percentile latency.
+     */
+    uint64_t p999;
+
+    /**
+     * \brief The largest recorded latency.
+     */
+    uint64_t max;
+
+} vcdb_database_latency_t;
+
 /**
  * \brief Create a database from the given builder.
  *
@@ -116,6 +338,40 @@ int vcdb_database_datastore_get(
     void* value,
     size_t* value_size);
 
+/**
+ * \brief Get a value and its version token from the database corresponding to
+ * a given key.
+ *
+ * The version token can be passed to vcdb_database_datastore_put_if_version()
+ * to update the value only if it has not changed since it was read.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to get the value from.
+ * \param key           The key to use for the query.
+ * \param key_size      The size of the key.
+ * \param value         The value to read.
+ * \param value_size    The size pointer.  Must be set to the maximum size of
+ *                      the value buffer.  On success, this pointer is updated
+ *                      to the size of the data read.
+ * \param version       Pointer to receive the version token of the value.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the value is not in the datastore.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the value_size is too small.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support
+ *            versioned reads.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_get_versioned(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t* version);
+
 /**
  * \brief Get a value from the database via a secondary index corresponding to
  * a given key.
@@ -144,6 +400,164 @@ int vcdb_database_index_get(
     void* value,
     size_t* value_size);
 
+/**
+ * \brief Check whether a key is in a datastore.
+ *
+ * This is cheaper than vcdb_database_datastore_get(), since no value buffer is
+ * needed and the value is not deserialized.  Engines which support it can
+ * answer without reading the value at all.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the datastore.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the datastore.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_contains(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Check whether a key is in a secondary index.
+ *
+ * This is cheaper than vcdb_database_index_get(), since no value buffer is
+ * needed and the value is not deserialized.
+ *
+ * \param database      The database instance to use.
+ * \param index         The secondary index to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the index.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_index_contains(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Get the primary key that a secondary index key maps to.
+ *
+ * The primary value is not deserialized.  Engines which support it answer
+ * without a second lookup into the primary datastore.
+ *
+ * \param database          The database instance to use.
+ * \param index             The secondary index to use.
+ * \param key               The secondary key to use for the query.
+ * \param key_size          The size of the secondary key.
+ * \param primary_key       The buffer to receive the primary key.
+ * \param primary_key_size  The size pointer.  Must be set to the size of the
+ *                          primary key buffer.  On success, this pointer is
+ *                          updated to the size of the primary key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ *            In this case, primary_key_size is updated to the size needed.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_index_get_primary_key(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size);
+
+/**
+ * \brief Get the projection stored in a covering index for a given key.
+ *
+ * The index must have a projection writer.  The projection is returned in its
+ * serialized form, straight from the index entry, without reading the primary
+ * datastore.  If the engine does not store projections, the value is read via
+ * the index and projected.  Projections are kept current because merge
+ * operands can't be recorded against a datastore with an index.
+ *
+ * \param database          The database instance to use.
+ * \param index             The covering index to use.
+ * \param key               The secondary key to use for the query.
+ * \param key_size          The size of the secondary key.
+ * \param projection        The buffer to receive the projection.
+ * \param projection_size   The size pointer.  Must be set to the size of the
+ *                          projection buffer.  On success, this pointer is
+ *                          updated to the size of the projection.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the projection_size is too small.
+ *            In this case, projection_size is updated to the size needed.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the index has no projection
+ *            writer.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_index_get_projection(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t* projection_size);
+
+/**
+ * \brief Take a snapshot of the operation counters of a database.
+ *
+ * Counters are kept per thread stripe, so updating them adds no contention.
+ * They are summed when the snapshot is taken, and count operations since the
+ * database was created or opened.  The counters of a datastore or index are
+ * at instances[correlation_id].  Counters must be enabled with
+ * vcdb_builder_stats_enable().
+ *
+ * \param database      The database instance to use.
+ * \param stats         The snapshot to initialize.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if operation counters are not enabled.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_stats(
+    vcdb_database_t* database,
+    vcdb_database_stats_t* stats);
+
+/**
+ * \brief Summarize the latency histogram of an engine method.
+ *
+ * Latency histograms are enabled with vcdb_builder_latency_histograms_enable().
+ * Datastore and index methods are recorded per correlation ID.  Transaction
+ * begins, commits, and rollbacks are recorded under correlation ID -1.  The
+ * summary covers calls since the database was created or opened.
+ *
+ * \param database      The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index, or -1
+ *                      for a transaction method.
+ * \param method        The engine method to summarize.
+ * \param latency       The summary to fill in.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if latency histograms are disabled.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the correlation ID or method is
+ *            out of range.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_latency_get(
+    vcdb_database_t* database,
+    int correlation_id,
+    vcdb_database_method_t method,
+    vcdb_database_latency_t* latency);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -28,8 +28,14 @@
 extern "C" {
 #endif  //__cplusplus
 
+#include <stdbool.h>
 #include <stdlib.h>
 
+/**
+ * \brief The maximum size of a key copied by a key getter.
+ *
+ * Keys returned by a key reference getter are not limited in size.
+ */
 #define VCDB_MAX_KEY_SIZE 1024
 
 /**
@@ -42,6 +48,17 @@ extern "C" {
 typedef void (*vcdb_datastore_key_getter_method_t)(
     const void* value, void* key, size_t* key_size);
 
+/**
+ * \brief Get a reference to the key inside of the data structure.
+ *
+ * \param value     The value being interrogated.
+ * \param key_size  Pointer to be updated with the size of the key.
+ *
+ * \returns a pointer to the key, which must point into the value.
+ */
+typedef const void* (*vcdb_datastore_key_reference_getter_method_t)(
+    const void* value, size_t* key_size);
+
 /**
  * \brief Read a value instance from serialized data.
  *
@@ -84,6 +101,36 @@ typedef int (*vcdb_datastore_value_reader_method_t)(
 typedef int (*vcdb_datastore_value_writer_method_t)(
     const void* value, void* serial_output, size_t* serial_output_size);
 
+/**
+ * \brief Fold a merge operand into an existing serialized value.
+ *
+ * Merge operands are recorded with vcdb_database_datastore_merge() without
+ * reading the current value.  The database engine calls this method lazily,
+ * for instance when the value is read or compacted, to combine operands with
+ * the stored value.
+ *
+ * \param existing          The existing serialized value, or NULL if there is
+ *                          no value stored for this key.
+ * \param existing_size     The size of the existing serialized value.
+ * \param operand           The serialized merge operand.
+ * \param operand_size      The size of the merge operand.
+ * \param serial_output     The output buffer for the merged serialized value.
+ * \param serial_output_size On entry, the size of the output buffer.  On exit,
+ *                          the size of the merged value, or the size of buffer
+ *                          required if the buffer is too small.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_WOULD_TRUNCATE if the output buffer is too small.  In
+ *            this case, serial_output_size will be set to the size of buffer
+ *            required.
+ *          * A non-zero error code signifying error.
+ */
+typedef int (*vcdb_datastore_value_merger_method_t)(
+    const void* existing, size_t existing_size,
+    const void* operand, size_t operand_size,
+    void* serial_output, size_t* serial_output_size);
+
 /**
  * \brief This structure contains instance information for a given datastore.
  *
@@ -120,6 +167,12 @@ typedef struct vcdb_datastore
      */
     vcdb_datastore_key_getter_method_t key_getter;
 
+    /**
+     * \brief Optional method to get a reference to the key inside the data
+     * structure, used instead of the key getter when set.
+     */
+    vcdb_datastore_key_reference_getter_method_t key_reference_getter;
+
     /**
      * \brief Read a value instance from serialized data.
      */
@@ -131,10 +184,20 @@ typedef struct vcdb_datastore
     vcdb_datastore_value_writer_method_t value_writer;
 
     /**
-     * \brief Serial data size.
+     * \brief Optional method to fold a merge operand into a serialized value.
+     */
+    vcdb_datastore_value_merger_method_t value_merger;
+
+    /**
+     * \brief The maximum size of a serialized value, or 0 if it is unbounded.
      */
     size_t serial_data_size;
 
+    /**
+     * \brief Set to true if a value is its own serialized form.
+     */
+    bool identity_serialization;
+
 } vcdb_datastore_t;
 
 /**
@@ -165,6 +228,80 @@ int vcdb_datastore_init(
     vcdb_datastore_value_reader_method_t value_reader,
     vcdb_datastore_value_writer_method_t value_writer);
 
+/**
+ * \brief Set the merge method for a datastore.
+ *
+ * A datastore must have a merge method before merge operands can be recorded
+ * against it with vcdb_database_datastore_merge().
+ *
+ * \param datastore The datastore to update.
+ * \param merger    The method used to fold merge operands into values.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_value_merger_set(
+    vcdb_datastore_t* datastore,
+    vcdb_datastore_value_merger_method_t merger);
+
+/**
+ * \brief Declare the maximum size of a serialized value of a datastore.
+ *
+ * Values of a datastore with a declared serial data size are serialized into
+ * a buffer of exactly this size.  If the size fits in the library's stack
+ * buffer, which is VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE bytes, then gets
+ * and puts against this datastore do not allocate at all.  A value which
+ * turns out to be larger is still handled, with a heap buffer.
+ *
+ * \param datastore The datastore to update.
+ * \param size      The maximum size of a serialized value.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_serial_data_size_set(
+    vcdb_datastore_t* datastore,
+    size_t size);
+
+/**
+ * \brief Declare that the values of a datastore are their own serialized form.
+ *
+ * This is meant for plain-old-data values.  The value reader and writer of the
+ * datastore are bypassed: a put hands the caller's value to the engine as the
+ * serialized data, and a get has the engine read the serialized data straight
+ * into the caller's value.  The serialized data is data_size bytes.  Engines
+ * can check identity_serialization to avoid further copies.
+ *
+ * \param datastore The datastore to update.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_identity_serialization_enable(
+    vcdb_datastore_t* datastore);
+
+/**
+ * \brief Set the key reference getter for a datastore.
+ *
+ * When a datastore has a key reference getter, the key of a value is used in
+ * place, so puts do not copy it into a key buffer.  Such keys are not limited
+ * to VCDB_MAX_KEY_SIZE bytes.  The key getter is still used by code which
+ * needs its own copy of the key.
+ *
+ * \param datastore The datastore to update.
+ * \param getter    The method used to get a reference to the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_key_reference_getter_set(
+    vcdb_datastore_t* datastore,
+    vcdb_datastore_key_reference_getter_method_t getter);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
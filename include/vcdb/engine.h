@@ -18,10 +18,25 @@
 extern "C" {
 #endif  //__cplusplus
 
+#include <stdint.h>
 #include <stdlib.h>
 
+/**
+ * \brief An opaque version token for a stored value.
+ *
+ * Engines supporting versioned reads assign a new token each time a value is
+ * written.  The only token with a defined meaning is VCDB_VERSION_NONE.
+ */
+typedef uint64_t vcdb_version_t;
+
+/**
+ * \brief The version token of a key which has no value.
+ */
+#define VCDB_VERSION_NONE ((vcdb_version_t)0)
+
 /* forward declarations for structures. */
 struct vcdb_transaction;
+struct vcdb_transaction_savepoint;
 struct vcdb_builder;
 struct vcdb_database;
 struct vcdb_datastore;
@@ -30,6 +45,10 @@ struct vcdb_index;
 /**
  * \brief Database engine method for creating a database.
  *
+ * The engine should set up its object for each datastore and index in the
+ * builder, and store it with vcdb_builder_datastore_handle_set() or
+ * vcdb_builder_index_handle_set() so later calls can find it by correlation ID.
+ *
  * \param database      The database to create.
  * \param builder       The builder from which the database is created.
  *
@@ -44,6 +63,9 @@ typedef int (*vcdb_database_engine_database_create_t)(
 /**
  * \brief Database engine method for opening a database.
  *
+ * As with create, the engine should store its object for each datastore and
+ * index in the builder's handle slots.
+ *
  * \param database  The database instance to open.
  * \param builder   The builder to use to open this database.
  *
@@ -101,6 +123,39 @@ typedef int (*vcdb_database_engine_datastore_get_t)(
     void* value,
     size_t* value_size);
 
+/**
+ * \brief Database engine method for getting a value and its version token from
+ * a datastore.
+ *
+ * This method is optional.  It behaves like the datastore_get method, but also
+ * returns the version token of the value read, which can be passed to the
+ * datastore_put_if_version method.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to get the value from.
+ * \param key           The key to use for the query.
+ * \param key_size      The size of the key.
+ * \param value         The value to read.
+ * \param value_size    The size pointer.  Must be set to the maximum size of
+ *                      the value buffer.  On success, this pointer is updated
+ *                      to the size of the data read.
+ * \param version       Pointer to receive the version token of the value.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the value is not in the datastore.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the value_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_datastore_get_versioned_t)(
+    struct vcdb_database* database,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t* version);
+
 /**
  * \brief Database engine method for getting a value from a secondary index.
  *
@@ -169,7 +224,9 @@ typedef int (*vcdb_database_engine_transaction_rollback_t)(
 /**
  * \brief Put a value into the datastore using the given transaction.
  *
- * If the value already exists, it will be updated.
+ * If the value already exists, it will be updated.  Index entries are only
+ * written for indexes where vcdb_index_value_included() is true for the value,
+ * and stale entries of the old value are removed the same way.
  *
  * \param transaction   The transaction instance to use.
  * \param datastore     The datastore to put the value into.
@@ -190,9 +247,70 @@ typedef int (*vcdb_database_engine_datastore_put_t)(
     void* value,
     size_t* value_size);
 
+/**
+ * \brief Put a value into the datastore only if the stored version of the
+ * value matches the expected version.
+ *
+ * This method is optional.  The version check and the write must be atomic
+ * with respect to other writers.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param key           The key to put.
+ * \param key_size      The size of the key to put.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      VCDB_VERSION_NONE if the key must not have a value.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VERSION_MISMATCH if the stored version differs.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_datastore_put_if_version_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t version);
+
+/**
+ * \brief Record a merge operand for the given key in the given datastore.
+ *
+ * This method is optional.  The engine stores the operand without reading the
+ * current value, and folds operands into the stored value using the
+ * datastore's value_merger method when the value is next read or compacted.
+ * It is only called for datastores without indexes, so no index entries need
+ * to be updated.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to merge the operand into.
+ * \param key           The key of the value to update.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_datastore_merge_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size);
+
 /**
  * \brief Delete values matching the given key in the given datastore.
  *
+ * Only indexes where vcdb_index_value_included() is true for the stored value
+ * have entries to delete.
+ *
  * \param transaction   The transaction instance to use.
  * \param datastore     The datastore to use when deleting.
  * \param key           The key to delete.
@@ -208,6 +326,34 @@ typedef int (*vcdb_database_engine_datastore_delete_t)(
     void* key,
     size_t* key_size);
 
+/**
+ * \brief Delete all values whose keys fall in the half-open range [start, end)
+ * in the given datastore.
+ *
+ * This method is optional.  Engines should implement it as a single range
+ * operation, such as a range tombstone or a subtree drop, rather than by
+ * deleting each key in the range.  It is only called for datastores without
+ * indexes, so no index entries need to be dropped.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to use when deleting.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_datastore_delete_range_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size);
+
 /**
  * \brief Delete values matching the given key in the given secondary index.
  *
@@ -226,6 +372,244 @@ typedef int (*vcdb_database_engine_index_delete_t)(
     void* key,
     size_t* key_size);
 
+/**
+ * \brief Mark a savepoint in the given transaction.
+ *
+ * This method is optional.  Engines that do not support savepoints should set
+ * it to NULL.  Engines that do must also implement
+ * transaction_savepoint_rollback and transaction_savepoint_release; otherwise,
+ * savepoints are treated as unsupported.  On success, the engine may store
+ * savepoint-specific data in savepoint->savepoint_engine_context.
+ *
+ * \param transaction   The transaction in which the savepoint is marked.
+ * \param savepoint     The savepoint instance to mark.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_transaction_savepoint_set_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint);
+
+/**
+ * \brief Roll back all changes made in a transaction since the given savepoint
+ * was marked.
+ *
+ * This method is optional.  The savepoint remains valid after a successful
+ * roll back, so that the caller can retry the failed portion of work and roll
+ * back to the same savepoint again.
+ *
+ * \param transaction   The transaction to partially roll back.
+ * \param savepoint     The savepoint to roll back to.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_transaction_savepoint_rollback_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint);
+
+/**
+ * \brief Release a savepoint, keeping all changes made since it was marked as
+ * part of the enclosing transaction.
+ *
+ * This method is optional.
+ *
+ * \param transaction   The transaction owning the savepoint.
+ * \param savepoint     The savepoint to release.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_transaction_savepoint_release_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint);
+
+/**
+ * \brief Load the persisted negative-lookup filter for a datastore or index.
+ *
+ * This method is optional.  Engines which persist filters should implement both
+ * filter_load and filter_save.  If an engine does not, filters are only kept for
+ * databases created in the current process.
+ *
+ * \param database      The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index.
+ * \param data          The buffer to receive the filter data.
+ * \param size          The size pointer.  Must be set to the size of the data
+ *                      buffer.  On success, this pointer is updated to the size
+ *                      of the filter data read.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if no filter has been saved.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the size is too small.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_filter_load_t)(
+    struct vcdb_database* database,
+    int correlation_id,
+    void* data,
+    size_t* size);
+
+/**
+ * \brief Persist the negative-lookup filter for a datastore or index.
+ *
+ * This method is optional.  The library saves each filter when the database is
+ * closed.  After loading a filter, the library removes the saved copy by
+ * passing NULL data, so that a filter which missed writes after a crash is
+ * never loaded.
+ *
+ * \param database      The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index.
+ * \param data          The filter data to save, or NULL to remove it.
+ * \param size          The size of the filter data.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_filter_save_t)(
+    struct vcdb_database* database,
+    int correlation_id,
+    const void* data,
+    size_t size);
+
+/**
+ * \brief Database engine method for checking whether a key is in a datastore.
+ *
+ * This method is optional.  Engines which can answer from their keys alone
+ * should implement it, so the value is never read.  Without it, the library
+ * reads the value into a small scratch buffer.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the datastore.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the datastore.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_datastore_contains_t)(
+    struct vcdb_database* database,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Database engine method for checking whether a key is in a secondary
+ * index.
+ *
+ * This method is optional, and works like the datastore_contains method.
+ *
+ * \param database      The database instance to use.
+ * \param index         The secondary index to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the index.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_index_contains_t)(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Database engine method for getting the primary key that a secondary
+ * index key maps to.
+ *
+ * This method is optional.  Engines which store secondary-to-primary mappings
+ * should implement it, so the primary datastore is not read.  Without it, the
+ * library reads the value via the index and gets its key.
+ *
+ * \param database          The database instance to use.
+ * \param index             The secondary index to use.
+ * \param key               The secondary key to use for the query.
+ * \param key_size          The size of the secondary key.
+ * \param primary_key       The buffer to receive the primary key.
+ * \param primary_key_size  The size pointer.  Must be set to the size of the
+ *                          primary key buffer.  On success, this pointer is
+ *                          updated to the size of the primary key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_index_get_primary_key_t)(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size);
+
+/**
+ * \brief Database engine method for storing the projection of a value in a
+ * covering index entry under a transaction.
+ *
+ * This method is optional.  The library calls it for each covering index after
+ * a value is put into the index's datastore.  Without it, projections are
+ * computed from the value when they are read.
+ *
+ * \param transaction       The transaction instance to use.
+ * \param index             The covering index.
+ * \param key               The secondary key of the index entry.
+ * \param key_size          The size of the secondary key.
+ * \param projection        The serialized projection to store.
+ * \param projection_size   The size of the projection.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_index_projection_put_t)(
+    struct vcdb_transaction* transaction,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t projection_size);
+
+/**
+ * \brief Database engine method for getting the projection stored in a
+ * covering index entry.
+ *
+ * This method is optional, and should be implemented along with the
+ * index_projection_put method.
+ *
+ * \param database          The database instance to use.
+ * \param index             The covering index.
+ * \param key               The secondary key to use for the query.
+ * \param key_size          The size of the secondary key.
+ * \param projection        The buffer to receive the projection.
+ * \param projection_size   The size pointer.  Must be set to the size of the
+ *                          projection buffer.  On success, this pointer is
+ *                          updated to the size of the projection.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the projection_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+typedef int (*vcdb_database_engine_index_get_projection_t)(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t* projection_size);
+
 /**
  * \brief The database engine structure provides function pointers and context
  * information for a database engine implementation.
@@ -295,6 +679,91 @@ typedef struct vcdb_database_engine
      */
     vcdb_database_engine_index_delete_t index_delete;
 
+    /**
+     * \brief Optional database engine method for marking a savepoint in a
+     * transaction.
+     */
+    vcdb_database_engine_transaction_savepoint_set_t transaction_savepoint_set;
+
+    /**
+     * \brief Optional database engine method for rolling back a transaction to
+     * a savepoint.
+     */
+    vcdb_database_engine_transaction_savepoint_rollback_t
+        transaction_savepoint_rollback;
+
+    /**
+     * \brief Optional database engine method for releasing a savepoint.
+     */
+    vcdb_database_engine_transaction_savepoint_release_t
+        transaction_savepoint_release;
+
+    /**
+     * \brief Optional database engine method for recording a merge operand in
+     * a datastore under a transaction.
+     */
+    vcdb_database_engine_datastore_merge_t datastore_merge;
+
+    /**
+     * \brief Optional database engine method for getting a value and its
+     * version token from a datastore.
+     */
+    vcdb_database_engine_datastore_get_versioned_t datastore_get_versioned;
+
+    /**
+     * \brief Optional database engine method for putting a value in a
+     * datastore if its stored version matches an expected version.
+     */
+    vcdb_database_engine_datastore_put_if_version_t datastore_put_if_version;
+
+    /**
+     * \brief Optional database engine method for deleting a range of keys from
+     * a datastore.
+     */
+    vcdb_database_engine_datastore_delete_range_t datastore_delete_range;
+
+    /**
+     * \brief Optional database engine method for loading a persisted
+     * negative-lookup filter.
+     */
+    vcdb_database_engine_filter_load_t filter_load;
+
+    /**
+     * \brief Optional database engine method for persisting a negative-lookup
+     * filter.
+     */
+    vcdb_database_engine_filter_save_t filter_save;
+
+    /**
+     * \brief Optional database engine method for checking whether a key is in
+     * a datastore.
+     */
+    vcdb_database_engine_datastore_contains_t datastore_contains;
+
+    /**
+     * \brief Optional database engine method for checking whether a key is in
+     * a secondary index.
+     */
+    vcdb_database_engine_index_contains_t index_contains;
+
+    /**
+     * \brief Optional database engine method for getting the primary key that
+     * a secondary index key maps to.
+     */
+    vcdb_database_engine_index_get_primary_key_t index_get_primary_key;
+
+    /**
+     * \brief Optional database engine method for storing a projection in a
+     * covering index entry.
+     */
+    vcdb_database_engine_index_projection_put_t index_projection_put;
+
+    /**
+     * \brief Optional database engine method for getting the projection
+     * stored in a covering index entry.
+     */
+    vcdb_database_engine_index_get_projection_t index_get_projection;
+
 } vcdb_database_engine_t;
 
 /**
@@ -302,7 +771,8 @@ typedef struct vcdb_database_engine
  * the engine structure.
  *
  * This method is private to the database interface and the engine API, which is
- * used to register and look up database engine adapters.
+ * used to register and look up database engine adapters.  It is safe to call
+ * concurrently with vcdb_database_engine_register().
  *
  * \param engine        The name of the database engine looked up by this
  *                      method.
@@ -316,7 +786,9 @@ vcdb_database_engine_t* vcdb_database_engine_lookup(const char* engine);
  * \brief This method registers a database engine with the given engine name.
  *
  * This method is private to the database interface and the engine API, which is
- * used to register and look up database engine adapters.
+ * used to register and look up database engine adapters.  It is safe to call
+ * concurrently with itself and with vcdb_database_engine_lookup().  If an
+ * engine is already registered under this name, the first registration wins.
  *
  * \param eng           The engine to register.
  * \param engine        The name of the database engine under which this engine
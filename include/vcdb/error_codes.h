@@ -59,6 +59,21 @@ extern "C" {
  */
 #define VCDB_ERROR_VALUE_NOT_FOUND 0x4006
 
+/**
+ * \brief The database engine does not support this operation.
+ */
+#define VCDB_ERROR_NOT_SUPPORTED 0x4007
+
+/**
+ * \brief The stored version of a value did not match the expected version.
+ */
+#define VCDB_ERROR_VERSION_MISMATCH 0x4008
+
+/**
+ * \brief A record file could not be opened or written.
+ */
+#define VCDB_ERROR_RECORD_FILE 0x4009
+
 /**
  * \brief Misc database engine error.
  */
@@ -0,0 +1,142 @@
+/**
+ * \file hooks.h
+ *
+ * \brief The hooks interface lets external profilers observe calls into the
+ * library.
+ *
+ * A begin callback runs when a public entry point is entered, and an end
+ * callback runs when it returns.  They can be used to emit perf or USDT
+ * events, or to attribute time spent in the database to requests.  When no
+ * hooks are registered, each entry point pays a single predictable branch.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_HOOKS_HEADER_GUARD
+#define VCDB_HOOKS_HEADER_GUARD
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The public entry points which call the hooks.
+ */
+typedef enum vcdb_hook_entry_point
+{
+    VCDB_HOOK_DATABASE_CREATE,
+    VCDB_HOOK_DATABASE_OPEN,
+    VCDB_HOOK_DATABASE_DISPOSE,
+    VCDB_HOOK_DATASTORE_GET,
+    VCDB_HOOK_INDEX_GET,
+    VCDB_HOOK_DATASTORE_PUT,
+    VCDB_HOOK_DATASTORE_DELETE,
+    VCDB_HOOK_INDEX_DELETE,
+    VCDB_HOOK_TRANSACTION_BEGIN,
+    VCDB_HOOK_TRANSACTION_COMMIT,
+    VCDB_HOOK_TRANSACTION_ROLLBACK,
+
+    VCDB_HOOK_ENTRY_POINT_COUNT
+
+} vcdb_hook_entry_point_t;
+
+/**
+ * \brief The event passed to the begin and end callbacks of a call.
+ *
+ * The same event is passed to both callbacks, so a begin callback can leave
+ * a timestamp or span ID in \ref user_data for the end callback.
+ */
+typedef struct vcdb_hook_event
+{
+    /**
+     * \brief The entry point which was called.
+     */
+    vcdb_hook_entry_point_t entry_point;
+
+    /**
+     * \brief The name of the datastore or index, or NULL.
+     */
+    const char* name;
+
+    /**
+     * \brief The size of the key, or 0 if there is no key or the call failed
+     * before its key was known.
+     */
+    size_t key_size;
+
+    /**
+     * \brief The size of the value or value buffer, or 0 if there is none.
+     */
+    size_t value_size;
+
+    /**
+     * \brief The status code returned by the call.  Only valid in the end
+     * callback.
+     */
+    int status;
+
+    /**
+     * \brief Set to 0 before the begin callback, and free for its use.
+     */
+    uint64_t user_data;
+
+} vcdb_hook_event_t;
+
+/**
+ * \brief A hook callback.
+ *
+ * Callbacks may be run concurrently from any thread which uses the library,
+ * and must not call back into it.
+ *
+ * \param context       The context registered with the hooks.
+ * \param event         The event for this call.
+ */
+typedef void (*vcdb_hook_method_t)(
+    void* context,
+    vcdb_hook_event_t* event);
+
+/**
+ * \brief A set of hooks.
+ */
+typedef struct vcdb_hooks
+{
+    /**
+     * \brief Called when an entry point is entered, or NULL.
+     */
+    vcdb_hook_method_t begin;
+
+    /**
+     * \brief Called when an entry point returns, or NULL.
+     */
+    vcdb_hook_method_t end;
+
+    /**
+     * \brief Context passed to each callback.
+     */
+    void* context;
+
+} vcdb_hooks_t;
+
+/**
+ * \brief Register hooks for every public entry point.
+ *
+ * The hooks replace any which were registered before.  They are owned by the
+ * caller, and must stay in scope while they are registered and until calls
+ * which were running when they were replaced have returned.  It is safe to
+ * call this method concurrently with the rest of the library.
+ *
+ * \param hooks         The hooks to register, or NULL to remove them.
+ */
+void vcdb_hooks_register(
+    vcdb_hooks_t* hooks);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_HOOKS_HEADER_GUARD*/
@@ -22,6 +22,7 @@
 extern "C" {
 #endif  //__cplusplus
 
+#include <stdbool.h>
 #include <stdlib.h>
 
 /**
@@ -34,6 +35,37 @@ extern "C" {
 typedef void (*vcdb_index_secondary_key_getter_method_t)(
     const void* value, void* key, size_t* key_size);
 
+/**
+ * \brief Decide whether a value participates in a partial index.
+ *
+ * \param value     The value being interrogated.
+ *
+ * \returns true if the value has an entry in the index, or false if it is
+ * skipped.
+ */
+typedef bool (*vcdb_index_predicate_method_t)(const void* value);
+
+/**
+ * \brief Write the projection of a value which is stored in a covering index.
+ *
+ * A projection is a small serialized subset of the value's fields, which can
+ * be read with vcdb_database_index_get_projection() without reading the value.
+ *
+ * \param value             The value to project.
+ * \param serial_output     The output buffer for the serialized projection.
+ * \param serial_output_size The size of the output buffer.  On entry, set to
+ *                          the maximum size of the buffer.  On exit, set to the
+ *                          size of the projection on success, or the size
+ *                          required if the buffer is too small.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_WOULD_TRUNCATE if the output buffer is too small.
+ *          * A non-zero error code signifying error.
+ */
+typedef int (*vcdb_index_projection_writer_method_t)(
+    const void* value, void* serial_output, size_t* serial_output_size);
+
 /**
  * \brief This structure contains instance information for a given secondary
  * index.
@@ -69,6 +101,16 @@ typedef struct vcdb_index
      */
     vcdb_index_secondary_key_getter_method_t secondary_key_getter;
 
+    /**
+     * \brief Optional method to write the projection stored in this index.
+     */
+    vcdb_index_projection_writer_method_t projection_writer;
+
+    /**
+     * \brief Optional predicate which limits the index to matching values.
+     */
+    vcdb_index_predicate_method_t predicate;
+
 } vcdb_index_t;
 
 /**
@@ -95,6 +137,59 @@ int vcdb_index_init(
     const char* name,
     vcdb_index_secondary_key_getter_method_t key_getter);
 
+/**
+ * \brief Set the projection writer for a secondary index.
+ *
+ * This makes the index a covering index.  Each value put into the datastore is
+ * projected with this method, and the projection is stored with its index
+ * entry, so it can be read with vcdb_database_index_get_projection().
+ *
+ * \param index     The index to update.
+ * \param writer    The method used to write projections.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_index_projection_writer_set(
+    vcdb_index_t* index,
+    vcdb_index_projection_writer_method_t writer);
+
+/**
+ * \brief Set the predicate for a partial secondary index.
+ *
+ * Only values for which the predicate returns true have entries in the index,
+ * so the index scales with the matching subset of its datastore.  Values which
+ * don't match can't be found through the index.
+ *
+ * \param index     The index to update.
+ * \param predicate The method deciding whether a value is indexed.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_index_predicate_set(
+    vcdb_index_t* index,
+    vcdb_index_predicate_method_t predicate);
+
+/**
+ * \brief Check whether a value participates in an index.
+ *
+ * Engines which maintain secondary indexes use this when writing and deleting
+ * index entries.
+ *
+ * \param index     The index to check.
+ * \param value     The value being interrogated.
+ *
+ * \returns true if the value has an entry in the index.
+ */
+static inline bool vcdb_index_value_included(
+    const vcdb_index_t* index, const void* value)
+{
+    return NULL == index->predicate || index->predicate(value);
+}
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
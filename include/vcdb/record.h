@@ -0,0 +1,203 @@
+/**
+ * \file record.h
+ *
+ * \brief The record interface captures the operations made against any
+ * registered database engine, so that a workload can be replayed later.
+ *
+ * A record engine is a decorator which forwards each engine method to an inner
+ * engine and, while recording is started, appends the reads, writes, and
+ * transaction boundaries it sees to a binary record file.  Once registered
+ * with vcdb_record_engine_register(), prefixing an engine name with
+ * VCDB_RECORD_ENGINE_PREFIX, as in "record:LMDB", selects the record engine
+ * for that backend.
+ *
+ * A record file starts with the VCDB_RECORD_MAGIC bytes, followed by records
+ * in the order the calls returned.  Each record is a vcdb_record_header_t,
+ * followed by name_size bytes of datastore or index name, key_size bytes of
+ * key, value_size bytes of value, and extra_size bytes of extra data:
+ *
+ *      - DATASTORE_GET, INDEX_GET: the key.  The value is not recorded.  For
+ *        INDEX_GET, the extra data is the name of the index's datastore.
+ *      - DATASTORE_PUT: the primary key and the serialized value.  The extra
+ *        data lists the value's secondary keys.
+ *      - DATASTORE_MERGE: the primary key and the serialized operand.
+ *      - DATASTORE_DELETE: the primary key.
+ *      - INDEX_DELETE: the secondary key.  The extra data is the name of the
+ *        index's datastore.
+ *      - DATASTORE_DELETE_RANGE: the start key as the key and the end key as
+ *        the value.
+ *      - TRANSACTION_BEGIN, TRANSACTION_COMMIT, TRANSACTION_ROLLBACK: no data.
+ *
+ * Secondary keys are listed as vcdb_record_index_key_t entries, each followed
+ * by the index name and the secondary key.  Values for which an index
+ * predicate is false have no entry for that index.  Integers are in host byte
+ * order.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_RECORD_HEADER_GUARD
+#define VCDB_RECORD_HEADER_GUARD
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vcdb/error_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The engine name prefix which selects a record engine.
+ */
+#define VCDB_RECORD_ENGINE_PREFIX "record:"
+
+/**
+ * \brief The bytes at the start of a record file.
+ */
+#define VCDB_RECORD_MAGIC "VCDBREC1"
+
+/**
+ * \brief The size of VCDB_RECORD_MAGIC.
+ */
+#define VCDB_RECORD_MAGIC_SIZE 8
+
+/**
+ * \brief The operations captured by a record engine.
+ */
+typedef enum vcdb_record_op
+{
+    VCDB_RECORD_OP_DATASTORE_GET,
+    VCDB_RECORD_OP_INDEX_GET,
+    VCDB_RECORD_OP_DATASTORE_PUT,
+    VCDB_RECORD_OP_DATASTORE_MERGE,
+    VCDB_RECORD_OP_DATASTORE_DELETE,
+    VCDB_RECORD_OP_INDEX_DELETE,
+    VCDB_RECORD_OP_DATASTORE_DELETE_RANGE,
+    VCDB_RECORD_OP_TRANSACTION_BEGIN,
+    VCDB_RECORD_OP_TRANSACTION_COMMIT,
+    VCDB_RECORD_OP_TRANSACTION_ROLLBACK,
+
+    VCDB_RECORD_OP_COUNT
+
+} vcdb_record_op_t;
+
+/**
+ * \brief The fixed size header of a record.
+ */
+typedef struct vcdb_record_header
+{
+    /**
+     * \brief The size of the record, including this header.
+     */
+    uint32_t size;
+
+    /**
+     * \brief The operation, a vcdb_record_op_t value.
+     */
+    uint32_t op;
+
+    /**
+     * \brief A number identifying the calling thread.
+     */
+    uint32_t thread;
+
+    /**
+     * \brief The status code returned by the engine.
+     */
+    int32_t status;
+
+    /**
+     * \brief The time of the call, in nanoseconds since recording started.
+     */
+    uint64_t time;
+
+    /**
+     * \brief A number identifying the transaction, or 0 outside of one.  It is
+     * unique among the transactions active at the same time.
+     */
+    uint64_t transaction;
+
+    uint32_t name_size;
+    uint32_t key_size;
+    uint32_t value_size;
+    uint32_t extra_size;
+
+} vcdb_record_header_t;
+
+/**
+ * \brief An entry in the list of secondary keys of a put, followed by the
+ * index name and the secondary key.
+ */
+typedef struct vcdb_record_index_key
+{
+    uint32_t name_size;
+    uint32_t key_size;
+
+} vcdb_record_index_key_t;
+
+/**
+ * \brief Register the record engine for a registered database engine.
+ *
+ * The record engine is registered under VCDB_RECORD_ENGINE_PREFIX followed by
+ * the name of the inner engine, as in "record:LMDB".  Record engines are never
+ * registered implicitly, so applications which do not call this method don't
+ * link the record engine.  Registering the same record engine again does
+ * nothing.
+ *
+ * \param engine        The name of the inner engine, such as "LMDB".  It may
+ *                      itself be a registered decorator.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the inner engine is not
+ *            found.
+ *          - VCDB_ERROR_BAD_MEMORY_ALLOCATION if the record engine could not be
+ *            allocated or registered.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_engine_register(
+    const char* engine);
+
+/**
+ * \brief Start recording the operations made through a record engine.
+ *
+ * Any earlier record file of the engine is closed first.
+ *
+ * \param engine        The name of the record engine, such as "record:LMDB".
+ * \param path          The record file to create.  It is replaced if it
+ *                      exists.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a record engine.
+ *          - VCDB_ERROR_RECORD_FILE if the file could not be created.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_start(
+    const char* engine,
+    const char* path);
+
+/**
+ * \brief Stop recording, and close the record file.
+ *
+ * \param engine        The name of the record engine, such as "record:LMDB".
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a record engine.
+ *          - VCDB_ERROR_RECORD_FILE if a record could not be written.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_stop(
+    const char* engine);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_RECORD_HEADER_GUARD*/
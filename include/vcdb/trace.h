@@ -0,0 +1,248 @@
+/**
+ * \file trace.h
+ *
+ * \brief The trace interface profiles the engine methods of any registered
+ * database engine.
+ *
+ * A trace engine is a decorator which forwards each engine method to an inner
+ * engine while recording timings, sizes, error codes, and samples of slow
+ * calls.  Once registered with vcdb_trace_engine_register(), prefixing an
+ * engine name with VCDB_TRACE_ENGINE_PREFIX, as in "trace:LMDB", selects the
+ * trace engine for that backend.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_TRACE_HEADER_GUARD
+#define VCDB_TRACE_HEADER_GUARD
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vcdb/error_codes.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The engine name prefix which selects a trace engine.
+ */
+#define VCDB_TRACE_ENGINE_PREFIX "trace:"
+
+/**
+ * \brief The number of slow call samples kept by a trace engine.
+ */
+#define VCDB_TRACE_SAMPLES 32
+
+/**
+ * \brief The default slow call threshold, in nanoseconds.
+ */
+#define VCDB_TRACE_DEFAULT_SLOW_THRESHOLD 1000000U
+
+/**
+ * \brief The engine methods recorded by a trace engine.
+ */
+typedef enum vcdb_trace_method
+{
+    VCDB_TRACE_METHOD_DATABASE_CREATE,
+    VCDB_TRACE_METHOD_DATABASE_OPEN,
+    VCDB_TRACE_METHOD_DATABASE_CLOSE,
+    VCDB_TRACE_METHOD_DATABASE_DELETE,
+    VCDB_TRACE_METHOD_DATASTORE_GET,
+    VCDB_TRACE_METHOD_INDEX_GET,
+    VCDB_TRACE_METHOD_TRANSACTION_BEGIN,
+    VCDB_TRACE_METHOD_TRANSACTION_COMMIT,
+    VCDB_TRACE_METHOD_TRANSACTION_ROLLBACK,
+    VCDB_TRACE_METHOD_DATASTORE_PUT,
+    VCDB_TRACE_METHOD_DATASTORE_DELETE,
+    VCDB_TRACE_METHOD_INDEX_DELETE,
+    VCDB_TRACE_METHOD_TRANSACTION_SAVEPOINT_SET,
+    VCDB_TRACE_METHOD_TRANSACTION_SAVEPOINT_ROLLBACK,
+    VCDB_TRACE_METHOD_TRANSACTION_SAVEPOINT_RELEASE,
+    VCDB_TRACE_METHOD_DATASTORE_MERGE,
+    VCDB_TRACE_METHOD_DATASTORE_GET_VERSIONED,
+    VCDB_TRACE_METHOD_DATASTORE_PUT_IF_VERSION,
+    VCDB_TRACE_METHOD_DATASTORE_DELETE_RANGE,
+    VCDB_TRACE_METHOD_FILTER_LOAD,
+    VCDB_TRACE_METHOD_FILTER_SAVE,
+    VCDB_TRACE_METHOD_DATASTORE_CONTAINS,
+    VCDB_TRACE_METHOD_INDEX_CONTAINS,
+    VCDB_TRACE_METHOD_INDEX_GET_PRIMARY_KEY,
+    VCDB_TRACE_METHOD_INDEX_PROJECTION_PUT,
+    VCDB_TRACE_METHOD_INDEX_GET_PROJECTION,
+
+    VCDB_TRACE_METHOD_COUNT
+
+} vcdb_trace_method_t;
+
+/**
+ * \brief The totals recorded for a single engine method.
+ */
+typedef struct vcdb_trace_method_stats
+{
+    /**
+     * \brief The number of calls.
+     */
+    uint64_t calls;
+
+    /**
+     * \brief The number of calls which failed, not counting calls which
+     * returned VCDB_ERROR_VALUE_NOT_FOUND or VCDB_ERROR_WOULD_TRUNCATE.
+     */
+    uint64_t errors;
+
+    /**
+     * \brief The number of calls which returned VCDB_ERROR_VALUE_NOT_FOUND.
+     */
+    uint64_t not_found;
+
+    /**
+     * \brief The number of calls which returned VCDB_ERROR_WOULD_TRUNCATE.
+     */
+    uint64_t would_truncate;
+
+    /**
+     * \brief The status code of the most recent failed call, or 0.
+     */
+    int last_error;
+
+    /**
+     * \brief The total time spent in the inner engine, in nanoseconds.
+     */
+    uint64_t total_time;
+
+    /**
+     * \brief The longest call, in nanoseconds.
+     */
+    uint64_t max_time;
+
+    /**
+     * \brief The number of key and value bytes passed to or returned by
+     * successful calls.
+     */
+    uint64_t bytes;
+
+} vcdb_trace_method_stats_t;
+
+/**
+ * \brief A sample of a slow call.
+ */
+typedef struct vcdb_trace_sample
+{
+    /**
+     * \brief The engine method.
+     */
+    vcdb_trace_method_t method;
+
+    /**
+     * \brief The correlation ID of the datastore or index, or -1.
+     */
+    int correlation_id;
+
+    /**
+     * \brief The status code returned by the inner engine.
+     */
+    int status;
+
+    /**
+     * \brief The length of the call, in nanoseconds.
+     */
+    uint64_t elapsed;
+
+    /**
+     * \brief The number of key and value bytes in the call.
+     */
+    uint64_t bytes;
+
+} vcdb_trace_sample_t;
+
+/**
+ * \brief A snapshot of what a trace engine has recorded.
+ */
+typedef struct vcdb_trace_snapshot
+{
+    /**
+     * \brief The totals for each engine method, indexed by method.
+     */
+    vcdb_trace_method_stats_t methods[VCDB_TRACE_METHOD_COUNT];
+
+    /**
+     * \brief The number of valid entries in \ref samples.
+     */
+    size_t sample_count;
+
+    /**
+     * \brief The most recent slow calls, oldest first.
+     */
+    vcdb_trace_sample_t samples[VCDB_TRACE_SAMPLES];
+
+} vcdb_trace_snapshot_t;
+
+/**
+ * \brief Register the trace engine for a registered database engine.
+ *
+ * The trace engine is registered under VCDB_TRACE_ENGINE_PREFIX followed by
+ * the name of the inner engine, as in "trace:LMDB".  Trace engines are never
+ * registered implicitly, so applications which do not call this method don't
+ * link the trace engine.  Registering the same trace engine again does
+ * nothing.
+ *
+ * \param engine        The name of the inner engine, such as "LMDB".  It may
+ *                      itself be a registered trace engine.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the inner engine is not
+ *            found.
+ *          - VCDB_ERROR_BAD_MEMORY_ALLOCATION if the trace engine could not be
+ *            allocated or registered.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the target does not have lock free
+ *            64-bit atomics.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_trace_engine_register(
+    const char* engine);
+
+/**
+ * \brief Take a snapshot of what a trace engine has recorded.
+ *
+ * Totals are kept for the life of the process, across every database using
+ * the trace engine.
+ *
+ * \param engine        The name of the trace engine, such as "trace:LMDB".
+ * \param snapshot      The snapshot to fill in.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a trace engine.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_trace_snapshot(
+    const char* engine,
+    vcdb_trace_snapshot_t* snapshot);
+
+/**
+ * \brief Set the threshold above which a trace engine samples a call.
+ *
+ * \param engine        The name of the trace engine, such as "trace:LMDB".
+ * \param threshold     The threshold in nanoseconds.  Calls which take longer
+ *                      are sampled.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a trace engine.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_trace_slow_threshold_set(
+    const char* engine,
+    uint64_t threshold);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_TRACE_HEADER_GUARD*/
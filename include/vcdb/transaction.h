@@ -19,14 +19,39 @@
 extern "C" {
 #endif  //__cplusplus
 
+/* forward declarations for structures. */
+struct vcdb_transaction_cache_key;
+
 typedef struct vcdb_transaction
 {
     disposable_t hdr;
     bool in_transaction;
     vcdb_database_t* database;
     void* transaction_engine_context;
+
+    /**
+     * \brief Keys written to cached datastores, invalidated on commit.
+     */
+    struct vcdb_transaction_cache_key* cache_keys;
+    size_t cache_keys_size;
+    size_t cache_keys_max;
 } vcdb_transaction_t;
 
+/**
+ * \brief A savepoint marks a position inside of a transaction which can be
+ * rolled back to without discarding the work done before it.
+ *
+ * Savepoints can be nested by marking additional savepoints after an earlier
+ * one.  A savepoint is only valid while its transaction is active.
+ */
+typedef struct vcdb_transaction_savepoint
+{
+    disposable_t hdr;
+    bool active;
+    vcdb_transaction_t* transaction;
+    void* savepoint_engine_context;
+} vcdb_transaction_savepoint_t;
+
 /**
  * \brief Begin a transaction using the given database.
  *
@@ -75,6 +100,62 @@ int vcdb_transaction_commit(
 int vcdb_transaction_rollback(
     vcdb_transaction_t* transaction);
 
+/**
+ * \brief Mark a savepoint in the given transaction.
+ *
+ * The transaction must stay in scope as long as the savepoint is in scope.  The
+ * savepoint is owned by the caller and must be disposed of by calling dispose()
+ * on it.  Disposing an active savepoint releases it.
+ *
+ * \param savepoint     The savepoint instance to mark.
+ * \param transaction   The transaction in which the savepoint is marked.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_BAD_TRANSACTION if the transaction is not active.
+ *          * VCDB_ERROR_NOT_SUPPORTED if the engine does not implement
+ *            all three savepoint methods.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_transaction_savepoint_set(
+    vcdb_transaction_savepoint_t* savepoint,
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Roll back all changes made since the given savepoint was marked.
+ *
+ * The transaction remains active, and the savepoint remains valid, so the
+ * failed portion of work can be retried and rolled back again if needed.
+ *
+ * \param savepoint     The savepoint to roll back to.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_BAD_TRANSACTION if the savepoint or its transaction is
+ *            not active.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_transaction_savepoint_rollback(
+    vcdb_transaction_savepoint_t* savepoint);
+
+/**
+ * \brief Release a savepoint.
+ *
+ * All changes made since the savepoint was marked become part of the enclosing
+ * transaction.  After this action is performed, the savepoint is no longer
+ * active.
+ *
+ * \param savepoint     The savepoint to release.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_BAD_TRANSACTION if the savepoint or its transaction is
+ *            not active.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_transaction_savepoint_release(
+    vcdb_transaction_savepoint_t* savepoint);
+
 /**
  * \brief Put a value into the datastore using the given transaction.
  *
@@ -95,6 +176,71 @@ int vcdb_database_datastore_put(
     void* value,
     size_t* value_size);
 
+/**
+ * \brief Put a value into the datastore only if the stored value has not
+ * changed since it was read.
+ *
+ * The engine atomically compares the version token of the stored value with
+ * the expected version and only writes the value if they match.  This allows
+ * a value to be read with vcdb_database_datastore_get_versioned() outside of a
+ * transaction, updated, and written back with a short-lived transaction.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      VCDB_VERSION_NONE if the key must not have a value.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VERSION_MISMATCH if the stored version differs.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support
+ *            versioned writes.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_put_if_version(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t version);
+
+/**
+ * \brief Record a merge operand for a value in the datastore using the given
+ * transaction.
+ *
+ * The current value is not read.  The operand is folded into the stored value
+ * by the datastore's value_merger method when the engine next reads or
+ * compacts the value, so read-modify-write updates such as counters become
+ * blind writes.
+ *
+ * Merge is not available for datastores with indexes, because secondary keys
+ * and the projections of covering indexes are only written when a whole value
+ * is put.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to merge the operand into.  It must have
+ *                      a value_merger method.
+ * \param key           The key of the value to update.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support merge,
+ *            or if the datastore has an index.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_merge(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size);
+
 /**
  * \brief Delete values matching the given key in the given datastore.
  *
@@ -113,6 +259,37 @@ int vcdb_database_datastore_delete(
     void* key,
     size_t* key_size);
 
+/**
+ * \brief Delete all values whose keys fall in the half-open range [start, end)
+ * in the given datastore.
+ *
+ * Keys are compared using the engine's key ordering.  The engine performs the
+ * delete as a single range operation, so pruning a large contiguous range of
+ * keys does not require a delete per key.  Range deletes are not available
+ * for datastores with indexes, because the secondary keys of the deleted
+ * values are not known.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to use when deleting.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support range
+ *            deletes, or if the datastore has an index.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_delete_range(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size);
+
 /**
  * \brief Delete values matching the given key in the given secondary index.
  *
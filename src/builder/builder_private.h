@@ -33,6 +33,59 @@ extern "C" {
 int vcdb_builder_add_generic(
     vcdb_builder_t* builder, void* datastore, int type);
 
+/**
+ * \brief Marker for an empty slot in the schema name table.
+ */
+#define VCDB_BUILDER_SCHEMA_EMPTY ((size_t)-1)
+
+/**
+ * \brief Build the schema name table and index adjacency list for the builder.
+ *
+ * Any previously built schema is released first.  If more than one instance
+ * of the same type has the same name, the first one added wins.
+ *
+ * \param builder   The builder instance for which the schema is built.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_builder_schema_build(
+    vcdb_builder_t* builder);
+
+/**
+ * \brief Release the schema name table and index adjacency list for the
+ * builder.
+ *
+ * \param builder   The builder instance for which the schema is released.
+ */
+void vcdb_builder_schema_release(
+    vcdb_builder_t* builder);
+
+/**
+ * \brief Get the schema hash for the given instance type and name.
+ *
+ * \param type      The instance type.
+ * \param name      The instance name.
+ *
+ * \returns the hash for this type and name.
+ */
+size_t vcdb_builder_schema_hash(
+    int type, const char* name);
+
+/**
+ * \brief Find an instance in the schema name table by type and name.
+ *
+ * \param builder   The builder instance to search.
+ * \param type      The instance type to find.
+ * \param name      The instance name to find.
+ *
+ * \returns the instance array offset of the matching instance, or
+ * VCDB_BUILDER_SCHEMA_EMPTY if it is not found.
+ */
+size_t vcdb_builder_schema_find(
+    vcdb_builder_t* builder, int type, const char* name);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -44,8 +44,12 @@ int vcdb_builder_add_generic(
     if (builder->instance_array_size == builder->instance_array_max)
     {
         /* grow the array.  Return on failure. */
-        void* newdata = realloc(builder->instance_array,
-            builder->instance_array_max + DEFAULT_INSTANCE_SIZE);
+        void* newdata = vcdb_builder_memory_reallocate(
+            builder, builder->instance_array,
+            sizeof(vcdb_builder_datastore_instance_t)
+                * builder->instance_array_max,
+            sizeof(vcdb_builder_datastore_instance_t)
+                * (builder->instance_array_max + DEFAULT_INSTANCE_SIZE));
         if (NULL == newdata)
         {
             return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
@@ -61,6 +65,8 @@ int vcdb_builder_add_generic(
         (vcdb_datastore_t*)datastore;
     builder->instance_array[builder->instance_array_size].instance_type = type;
     builder->instance_array[builder->instance_array_size].handle = NULL;
+    builder->instance_array[builder->instance_array_size].cache_size = 0;
+    builder->instance_array[builder->instance_array_size].filter_size = 0;
 
     /* we now have one more entry. */
     ++builder->instance_array_size;
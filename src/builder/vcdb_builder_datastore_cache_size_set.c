@@ -0,0 +1,61 @@
+/**
+ * \file vcdb_builder_datastore_cache_size_set.c
+ *
+ * \brief Implementation of the vcdb_builder_datastore_cache_size_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Enable the database read cache for a datastore.
+ *
+ * When enabled, vcdb_database_datastore_get() keeps up to the given number of
+ * deserialized values for this datastore in memory, keyed by primary key.  A
+ * cached value is returned without calling the engine or the value reader.
+ * Keys written by a transaction are invalidated when it commits.  The cache
+ * must be sized before the database is created or opened.
+ *
+ * \param builder   The builder to which the datastore was added.
+ * \param datastore The datastore to cache.
+ * \param entries   The number of values to cache, or 0 to disable caching.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the datastore is not in this
+ *            builder, or if the database is already open.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_cache_size_set(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    size_t entries)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(!builder->database_opened);
+
+    /* parameter sanity check. */
+    if (NULL == builder || NULL == datastore || builder->database_opened)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* the correlation ID is the datastore's offset in the instance array. */
+    size_t offset = (size_t)datastore->correlation_id;
+    if (datastore->correlation_id < 0
+     || offset >= builder->instance_array_size
+     || VCDB_BUILDER_INSTANCE_TYPE_DATASTORE
+            != builder->instance_array[offset].instance_type
+     || datastore != builder->instance_array[offset].instance.datastore)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    builder->instance_array[offset].cache_size = entries;
+
+    return VCDB_STATUS_SUCCESS;
+}
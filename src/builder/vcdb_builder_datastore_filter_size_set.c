@@ -0,0 +1,66 @@
+/**
+ * \file vcdb_builder_datastore_filter_size_set.c
+ *
+ * \brief Implementation of the vcdb_builder_datastore_filter_size_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Enable the negative-lookup filter for a datastore.
+ *
+ * When enabled, the library keeps a blocked bloom filter of the keys put into
+ * this datastore.  vcdb_database_datastore_get() returns
+ * VCDB_ERROR_VALUE_NOT_FOUND without calling the engine for most keys which
+ * were never put.  Deleted keys stay in the filter, so they still go to the
+ * engine.  The filter must be sized before the database is created or opened.
+ *
+ * A filter is complete for a database created in this process.  When a
+ * database is opened, the filter is loaded using the engine's filter_load
+ * method.  If the engine can't supply it, the filter is disabled until the
+ * database is next created.
+ *
+ * \param builder   The builder to which the datastore was added.
+ * \param datastore The datastore to filter.
+ * \param keys      The expected number of keys, or 0 to disable the filter.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the datastore is not in this
+ *            builder, or if the database is already open.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_filter_size_set(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    size_t keys)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(!builder->database_opened);
+
+    /* parameter sanity check. */
+    if (NULL == builder || NULL == datastore || builder->database_opened)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* the correlation ID is the datastore's offset in the instance array. */
+    size_t offset = (size_t)datastore->correlation_id;
+    if (datastore->correlation_id < 0
+     || offset >= builder->instance_array_size
+     || VCDB_BUILDER_INSTANCE_TYPE_DATASTORE
+            != builder->instance_array[offset].instance_type
+     || datastore != builder->instance_array[offset].instance.datastore)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    builder->instance_array[offset].filter_size = keys;
+
+    return VCDB_STATUS_SUCCESS;
+}
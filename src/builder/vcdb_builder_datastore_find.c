@@ -0,0 +1,63 @@
+/**
+ * \file vcdb_builder_datastore_find.c
+ *
+ * \brief Implementation of the vcdb_builder_datastore_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+#include "builder_private.h"
+
+/**
+ * \brief Find a datastore in the builder by name.
+ *
+ * This lookup takes constant time, using the schema built when the database
+ * was created or opened.
+ *
+ * \param builder   The builder instance to search.
+ * \param datastore Pointer to receive the datastore on success.
+ * \param name      The name of the datastore to find.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_VALUE_NOT_FOUND if no datastore has this name.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database has not been created
+ *            or opened.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_find(
+    vcdb_builder_t* builder,
+    vcdb_datastore_t** datastore,
+    const char* name)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != name);
+
+    /* parameter sanity check. */
+    if (NULL == builder || NULL == datastore || NULL == name)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* the schema is built when the database is created or opened. */
+    if (NULL == builder->schema_name_table)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    size_t offset = vcdb_builder_schema_find(
+        builder, VCDB_BUILDER_INSTANCE_TYPE_DATASTORE, name);
+    if (VCDB_BUILDER_SCHEMA_EMPTY == offset)
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    *datastore = builder->instance_array[offset].instance.datastore;
+
+    return VCDB_STATUS_SUCCESS;
+}
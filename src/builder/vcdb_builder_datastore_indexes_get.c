@@ -0,0 +1,72 @@
+/**
+ * \file vcdb_builder_datastore_indexes_get.c
+ *
+ * \brief Implementation of the vcdb_builder_datastore_indexes_get() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+#include "builder_private.h"
+
+/**
+ * \brief Get the secondary indexes which belong to the given datastore.
+ *
+ * The returned array is owned by the builder and remains valid while the
+ * database is open.
+ *
+ * \param builder   The builder instance to search.
+ * \param datastore The datastore whose indexes are returned.  It must have
+ *                  been added to this builder.
+ * \param indexes   Pointer to receive the array of indexes.
+ * \param count     Pointer to receive the number of indexes in the array.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the datastore is not in this
+ *            builder, or if the database has not been created or opened.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_datastore_indexes_get(
+    vcdb_builder_t* builder,
+    const vcdb_datastore_t* datastore,
+    vcdb_index_t* const** indexes,
+    size_t* count)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != indexes);
+    MODEL_ASSERT(NULL != count);
+
+    /* parameter sanity check. */
+    if (NULL == builder || NULL == datastore || NULL == indexes || NULL == count)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* the schema is built when the database is created or opened. */
+    if (NULL == builder->schema_index_offset)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* the correlation ID is the datastore's offset in the instance array. */
+    size_t offset = (size_t)datastore->correlation_id;
+    if (datastore->correlation_id < 0
+     || offset >= builder->instance_array_size
+     || VCDB_BUILDER_INSTANCE_TYPE_DATASTORE
+            != builder->instance_array[offset].instance_type
+     || datastore != builder->instance_array[offset].instance.datastore)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    size_t begin = builder->schema_index_offset[offset];
+    *indexes = builder->schema_index_list + begin;
+    *count = builder->schema_index_offset[offset + 1] - begin;
+
+    return VCDB_STATUS_SUCCESS;
+}
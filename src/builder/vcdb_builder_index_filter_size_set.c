@@ -0,0 +1,58 @@
+/**
+ * \file vcdb_builder_index_filter_size_set.c
+ *
+ * \brief Implementation of the vcdb_builder_index_filter_size_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Enable the negative-lookup filter for a secondary index.
+ *
+ * This works like vcdb_builder_datastore_filter_size_set(), using secondary
+ * keys, and lets vcdb_database_index_get() reject keys which were never put.
+ *
+ * \param builder   The builder to which the index was added.
+ * \param index     The index to filter.
+ * \param keys      The expected number of keys, or 0 to disable the filter.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the index is not in this builder,
+ *            or if the database is already open.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_index_filter_size_set(
+    vcdb_builder_t* builder,
+    const vcdb_index_t* index,
+    size_t keys)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(!builder->database_opened);
+
+    /* parameter sanity check. */
+    if (NULL == builder || NULL == index || builder->database_opened)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* the correlation ID is the index's offset in the instance array. */
+    size_t offset = (size_t)index->correlation_id;
+    if (index->correlation_id < 0
+     || offset >= builder->instance_array_size
+     || VCDB_BUILDER_INSTANCE_TYPE_INDEX
+            != builder->instance_array[offset].instance_type
+     || index != builder->instance_array[offset].instance.index)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    builder->instance_array[offset].filter_size = keys;
+
+    return VCDB_STATUS_SUCCESS;
+}
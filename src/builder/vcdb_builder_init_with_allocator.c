@@ -0,0 +1,148 @@
+/**
+ * \file vcdb_builder_init.c
+ *
+ * \brief Implementation of the vcdb_builder_init_with_allocator method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+#include "builder_private.h"
+
+/* forward decls */
+static void vcdb_builder_dispose(void* disposable);
+
+/**
+ * \brief Initialize a builder instance which uses the given allocator.
+ *
+ * This behaves like vcdb_builder_init(), except that the builder, the
+ * databases built from it, and the transactions against those databases
+ * allocate all of their memory from the given allocator.  Database engines are
+ * expected to do the same via vcdb_builder_memory_allocate().  This allows a
+ * memory cap, an arena, or instrumentation to be applied to the library.
+ *
+ * The allocator must remain in scope until the builder is disposed.
+ *
+ * \param builder       The builder instance to initialize.
+ * \param alloc_opts    The allocator to use, or NULL to use the C library
+ *                      allocator.
+ * \param engine        The database engine to use.
+ * \param connect       The implementation-dependent connection string for a
+ *                      database instance.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_init_with_allocator(
+    vcdb_builder_t* builder,
+    allocator_options_t* alloc_opts,
+    const char* engine,
+    const char* connect)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != engine);
+    MODEL_ASSERT(NULL != connect);
+
+    /* parameter check */
+    if (NULL == builder || NULL == engine || NULL == connect)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* look up the database engine. */
+    vcdb_database_engine_t* eng = vcdb_database_engine_lookup(engine);
+    if (NULL == eng)
+    {
+        return VCDB_ERROR_MISSING_DATABASE_ENGINE;
+    }
+
+    /* set up the builder instance. */
+    builder->hdr.dispose = &vcdb_builder_dispose;
+    builder->engine = eng;
+    builder->instance_array_max = DEFAULT_INSTANCE_SIZE;
+    builder->instance_array_size = 0;
+    builder->database_opened = false;
+    builder->schema_name_table = NULL;
+    builder->schema_name_table_size = 0;
+    builder->schema_index_offset = NULL;
+    builder->schema_index_list = NULL;
+    builder->latency_clock = NULL;
+    builder->stats_enabled = false;
+    builder->alloc_opts = alloc_opts;
+
+    /* attempt to duplicate the connection string. */
+    size_t connect_size = strlen(connect) + 1;
+    builder->connection_string = (char*)
+        vcdb_builder_memory_allocate(builder, connect_size);
+    if (NULL == builder->connection_string)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memcpy(builder->connection_string, connect, connect_size);
+
+    MODEL_ASSERT(NULL != builder->connection_string);
+
+    /* attempt to allocate the instance array. */
+    builder->instance_array = (vcdb_builder_datastore_instance_t*)
+        vcdb_builder_memory_allocate(
+            builder,
+            sizeof(vcdb_builder_datastore_instance_t)
+                * builder->instance_array_max);
+    if (NULL == builder->instance_array)
+    {
+        vcdb_builder_memory_release(builder, builder->connection_string);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    MODEL_ASSERT(NULL != builder->instance_array);
+
+    /* clear the array. */
+    memset(builder->instance_array,
+        0,
+        sizeof(vcdb_builder_datastore_instance_t) * builder->instance_array_max);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Clean up the builder instance.
+ *
+ * \param disposable        The builder instance to be disposed.
+ */
+static void vcdb_builder_dispose(void* disposable)
+{
+    vcdb_builder_t* builder = (vcdb_builder_t*)disposable;
+
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != builder->connection_string);
+    MODEL_ASSERT(NULL != builder->instance_array);
+    MODEL_ASSERT(!builder->database_opened);
+
+    /* clean up the connection string. */
+    vcdb_builder_memory_release(builder, builder->connection_string);
+
+    /* clean up each active instance */
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        /* both datastore and index HAS-A disposable_t as a first member, so
+         * this cast is safe.
+         */
+        dispose((disposable_t*)builder->instance_array[i].instance.datastore);
+    }
+
+    /* clean up the instance array. */
+    vcdb_builder_memory_release(builder, builder->instance_array);
+
+    /* clean up the schema. */
+    vcdb_builder_schema_release(builder);
+
+    /* clear out the structure. */
+    memset(builder, 0, sizeof(vcdb_builder_t));
+}
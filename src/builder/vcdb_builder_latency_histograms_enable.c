@@ -0,0 +1,59 @@
+/**
+ * \file vcdb_builder_latency_histograms_enable.c
+ *
+ * \brief Implementation of the vcdb_builder_latency_histograms_enable()
+ * method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+#include "../latency/latency_private.h"
+
+/**
+ * \brief Enable latency histograms for the engine methods of a database.
+ *
+ * When enabled, every get, put, merge, delete, index get, index delete,
+ * begin, commit, and rollback sent to the engine is timed and recorded in a
+ * log-bucketed histogram for its datastore or index.  Recording is lock free.
+ * Use vcdb_database_latency_get() to read a summary of a histogram.  Latency
+ * histograms must be enabled before the database is created or opened.
+ *
+ * \param builder   The builder for the database.
+ * \param clock     The clock to use, or NULL to use the monotonic clock in
+ *                  nanoseconds.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database is already open.
+ *          * VCDB_ERROR_NOT_SUPPORTED if the target does not have lock free
+ *            64-bit atomics.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_latency_histograms_enable(
+    vcdb_builder_t* builder,
+    vcdb_builder_clock_method_t clock)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(!builder->database_opened);
+
+    /* parameter sanity check. */
+    if (NULL == builder || builder->database_opened)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+#if VCDB_LATENCY_SUPPORTED
+    builder->latency_clock =
+        NULL != clock ? clock : &vcdb_latency_clock_monotonic;
+
+    return VCDB_STATUS_SUCCESS;
+#else
+    (void)clock;
+
+    return VCDB_ERROR_NOT_SUPPORTED;
+#endif
+}
@@ -0,0 +1,169 @@
+/**
+ * \file vcdb_builder_schema_build.c
+ *
+ * \brief Implementation of the vcdb_builder_schema_build() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/builder.h>
+
+#include "builder_private.h"
+
+/* forward decls */
+static size_t vcdb_builder_index_owner(
+    vcdb_builder_t* builder, vcdb_index_t* index);
+
+/**
+ * \brief Build the schema name table and index adjacency list for the builder.
+ *
+ * Any previously built schema is released first.  If more than one instance
+ * of the same type has the same name, the first one added wins.
+ *
+ * \param builder   The builder instance for which the schema is built.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_builder_schema_build(
+    vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != builder);
+
+    size_t count = builder->instance_array_size;
+
+    /* start from scratch. */
+    vcdb_builder_schema_release(builder);
+
+    /* keep the name table at most half full. */
+    size_t table_size = 8;
+    while (table_size < 2 * count)
+    {
+        table_size <<= 1;
+    }
+
+    /* allocate the schema. */
+    builder->schema_name_table = (size_t*)
+        vcdb_builder_memory_allocate(builder, table_size * sizeof(size_t));
+    builder->schema_index_offset = (size_t*)
+        vcdb_builder_memory_allocate(builder, (count + 1) * sizeof(size_t));
+    builder->schema_index_list = (vcdb_index_t**)
+        vcdb_builder_memory_allocate(
+            builder, (count + 1) * sizeof(vcdb_index_t*));
+    if (NULL == builder->schema_name_table
+     || NULL == builder->schema_index_offset
+     || NULL == builder->schema_index_list)
+    {
+        vcdb_builder_schema_release(builder);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    /* every slot starts out empty, and every datastore has no indexes. */
+    memset(builder->schema_name_table, 0xff, table_size * sizeof(size_t));
+    memset(builder->schema_index_offset, 0, (count + 1) * sizeof(size_t));
+    builder->schema_name_table_size = table_size;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        vcdb_builder_datastore_instance_t* inst = &builder->instance_array[i];
+        int type = (int)inst->instance_type;
+        const char* name =
+            (VCDB_BUILDER_INSTANCE_TYPE_DATASTORE == type)
+                ? inst->instance.datastore->name
+                : inst->instance.index->name;
+
+        /* count each index against its datastore. */
+        if (VCDB_BUILDER_INSTANCE_TYPE_INDEX == type)
+        {
+            size_t owner =
+                vcdb_builder_index_owner(builder, inst->instance.index);
+            if (VCDB_BUILDER_SCHEMA_EMPTY != owner)
+            {
+                ++builder->schema_index_offset[owner + 1];
+            }
+        }
+
+        /* unnamed and duplicate instances are not added to the name table. */
+        if (NULL == name
+         || VCDB_BUILDER_SCHEMA_EMPTY
+                != vcdb_builder_schema_find(builder, type, name))
+        {
+            continue;
+        }
+
+        /* insert into the first free slot. */
+        size_t mask = table_size - 1;
+        size_t slot = vcdb_builder_schema_hash(type, name) & mask;
+        while (VCDB_BUILDER_SCHEMA_EMPTY != builder->schema_name_table[slot])
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        builder->schema_name_table[slot] = i;
+    }
+
+    /* turn the per-datastore counts into start offsets. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        builder->schema_index_offset[i + 1] += builder->schema_index_offset[i];
+    }
+
+    /* place each index, in the order it was added, at the next free position
+     * of its datastore.  This advances each datastore's offset to the start of
+     * the next datastore, so shift the offsets back by one entry afterward. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        vcdb_builder_datastore_instance_t* inst = &builder->instance_array[i];
+        if (VCDB_BUILDER_INSTANCE_TYPE_INDEX != inst->instance_type)
+        {
+            continue;
+        }
+
+        size_t owner = vcdb_builder_index_owner(builder, inst->instance.index);
+        if (VCDB_BUILDER_SCHEMA_EMPTY != owner)
+        {
+            builder->schema_index_list[builder->schema_index_offset[owner]++] =
+                inst->instance.index;
+        }
+    }
+
+    memmove(builder->schema_index_offset + 1, builder->schema_index_offset,
+        count * sizeof(size_t));
+    builder->schema_index_offset[0] = 0;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Get the instance array offset of the datastore that owns an index.
+ *
+ * \param builder   The builder instance.
+ * \param index     The index to resolve.
+ *
+ * \returns the offset of the owning datastore, or VCDB_BUILDER_SCHEMA_EMPTY if
+ * the datastore was not added to this builder.
+ */
+static size_t vcdb_builder_index_owner(
+    vcdb_builder_t* builder, vcdb_index_t* index)
+{
+    vcdb_datastore_t* datastore = index->datastore;
+    if (NULL == datastore || datastore->correlation_id < 0
+     || (size_t)datastore->correlation_id >= builder->instance_array_size)
+    {
+        return VCDB_BUILDER_SCHEMA_EMPTY;
+    }
+
+    vcdb_builder_datastore_instance_t* inst =
+        &builder->instance_array[datastore->correlation_id];
+    if (VCDB_BUILDER_INSTANCE_TYPE_DATASTORE != inst->instance_type
+     || datastore != inst->instance.datastore)
+    {
+        return VCDB_BUILDER_SCHEMA_EMPTY;
+    }
+
+    return (size_t)datastore->correlation_id;
+}
@@ -0,0 +1,64 @@
+/**
+ * \file vcdb_builder_schema_find.c
+ *
+ * \brief Implementation of the vcdb_builder_schema_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/builder.h>
+
+#include "builder_private.h"
+
+/**
+ * \brief Find an instance in the schema name table by type and name.
+ *
+ * \param builder   The builder instance to search.
+ * \param type      The instance type to find.
+ * \param name      The instance name to find.
+ *
+ * \returns the instance array offset of the matching instance, or
+ * VCDB_BUILDER_SCHEMA_EMPTY if it is not found.
+ */
+size_t vcdb_builder_schema_find(
+    vcdb_builder_t* builder, int type, const char* name)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != builder->schema_name_table);
+    MODEL_ASSERT(NULL != name);
+
+    size_t mask = builder->schema_name_table_size - 1;
+    size_t slot = vcdb_builder_schema_hash(type, name) & mask;
+
+    /* linear probe until we find the instance or an empty slot.  The table is
+     * never more than half full, so this terminates. */
+    for (;;)
+    {
+        size_t offset = builder->schema_name_table[slot];
+        if (VCDB_BUILDER_SCHEMA_EMPTY == offset)
+        {
+            return VCDB_BUILDER_SCHEMA_EMPTY;
+        }
+
+        /* datastore and index both have the name in their instance, but at
+         * different offsets, so check the type first. */
+        vcdb_builder_datastore_instance_t* inst =
+            &builder->instance_array[offset];
+        if ((int)inst->instance_type == type)
+        {
+            const char* inst_name =
+                (VCDB_BUILDER_INSTANCE_TYPE_DATASTORE == type)
+                    ? inst->instance.datastore->name
+                    : inst->instance.index->name;
+
+            if (!strcmp(name, inst_name))
+            {
+                return offset;
+            }
+        }
+
+        slot = (slot + 1) & mask;
+    }
+}
@@ -0,0 +1,35 @@
+/**
+ * \file vcdb_builder_schema_hash.c
+ *
+ * \brief Implementation of the vcdb_builder_schema_hash() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/builder.h>
+
+#include "../hash/hash_private.h"
+#include "builder_private.h"
+
+/**
+ * \brief Get the schema hash for the given instance type and name.
+ *
+ * \param type      The instance type.
+ * \param name      The instance name.
+ *
+ * \returns the hash for this type and name.
+ */
+size_t vcdb_builder_schema_hash(
+    int type, const char* name)
+{
+    MODEL_ASSERT(NULL != name);
+
+    /* datastores and indexes live in separate namespaces, so fold the type
+     * into the hash. */
+    uint64_t hash = vcdb_hash_fnv1a(name, strlen(name));
+    hash ^= (uint64_t)type * 0x9e3779b97f4a7c15ULL;
+
+    return (size_t)hash;
+}
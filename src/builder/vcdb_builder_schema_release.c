@@ -0,0 +1,33 @@
+/**
+ * \file vcdb_builder_schema_release.c
+ *
+ * \brief Implementation of the vcdb_builder_schema_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+
+#include "builder_private.h"
+
+/**
+ * \brief Release the schema name table and index adjacency list for the
+ * builder.
+ *
+ * \param builder   The builder instance for which the schema is released.
+ */
+void vcdb_builder_schema_release(
+    vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != builder);
+
+    vcdb_builder_memory_release(builder, builder->schema_name_table);
+    vcdb_builder_memory_release(builder, builder->schema_index_offset);
+    vcdb_builder_memory_release(builder, builder->schema_index_list);
+
+    builder->schema_name_table = NULL;
+    builder->schema_name_table_size = 0;
+    builder->schema_index_offset = NULL;
+    builder->schema_index_list = NULL;
+}
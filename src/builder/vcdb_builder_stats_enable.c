@@ -0,0 +1,53 @@
+/**
+ * \file vcdb_builder_stats_enable.c
+ *
+ * \brief Implementation of the vcdb_builder_stats_enable() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/builder.h>
+#include <vpr/parameters.h>
+
+#include "../stats/stats_private.h"
+
+/**
+ * \brief Enable operation counters for the datastores and indexes of a
+ * database.
+ *
+ * When enabled, gets, puts, deletes, commits, and rollbacks are counted in
+ * per-thread stripes, and vcdb_database_stats() returns a snapshot of the
+ * counters.  When disabled, which is the default, each operation only pays for
+ * a single branch.  Operation counters must be enabled before the database is
+ * created or opened.
+ *
+ * \param builder   The builder for the database.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_INVALID_PARAMETER if the database is already open.
+ *          * VCDB_ERROR_NOT_SUPPORTED if the target does not have lock free
+ *            64-bit atomics.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_builder_stats_enable(
+    vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(!builder->database_opened);
+
+    /* parameter sanity check. */
+    if (NULL == builder || builder->database_opened)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+#if VCDB_STATS_SUPPORTED
+    builder->stats_enabled = true;
+
+    return VCDB_STATUS_SUCCESS;
+#else
+    return VCDB_ERROR_NOT_SUPPORTED;
+#endif
+}
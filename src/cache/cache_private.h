@@ -0,0 +1,234 @@
+/**
+ * \file cache_private.h
+ *
+ * \brief Private details for the deserialized value read cache.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_CACHE_PRIVATE_HEADER_GUARD
+#define VCDB_CACHE_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vcdb/builder.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The largest key which can be cached.  Values with longer keys are
+ * always read from the engine.
+ */
+#define VCDB_CACHE_MAX_KEY_SIZE 64
+
+/**
+ * \brief The number of shards in a cache.  This must be a power of two.
+ */
+#define VCDB_CACHE_SHARD_COUNT 16
+
+/**
+ * \brief The shift which selects a shard from the top bits of a key hash.
+ */
+#define VCDB_CACHE_SHARD_SHIFT 60
+
+/**
+ * \brief Marker for the end of a bucket chain.
+ */
+#define VCDB_CACHE_NIL UINT32_MAX
+
+/**
+ * \brief The slot holds a value.
+ */
+#define VCDB_CACHE_SLOT_USED 0x01
+
+/**
+ * \brief The slot has been hit since the clock hand last passed it.
+ */
+#define VCDB_CACHE_SLOT_REFERENCED 0x02
+
+/**
+ * \brief The slot is in the protected segment.
+ */
+#define VCDB_CACHE_SLOT_PROTECTED 0x04
+
+/**
+ * \brief A single cache slot.
+ */
+typedef struct vcdb_cache_slot
+{
+    uint64_t hash;
+    uint32_t next;
+    uint16_t key_size;
+    uint8_t flags;
+    uint8_t key[VCDB_CACHE_MAX_KEY_SIZE];
+} vcdb_cache_slot_t;
+
+/**
+ * \brief A cache shard, guarded by its own spinlock.
+ *
+ * Eviction uses a segmented CLOCK.  New values enter the probationary segment.
+ * A value which is hit again while its referenced bit is still set is promoted
+ * to the protected segment.  The clock hand clears referenced bits, demotes
+ * unreferenced protected values to probation, and evicts unreferenced
+ * probationary values, so a scan of one-time reads cannot flush hot values.
+ *
+ * The generation counter is bumped on every invalidation.  A reader records
+ * the generation on a miss, and its fill is dropped if the generation changed
+ * in the meantime, so a value read before a commit is never cached after it.
+ */
+typedef struct vcdb_cache_shard
+{
+    atomic_flag lock;
+    uint64_t generation;
+    uint32_t capacity;
+    uint32_t hand;
+    uint32_t bucket_mask;
+    uint32_t* buckets;
+    vcdb_cache_slot_t* slots;
+    uint8_t* values;
+} vcdb_cache_shard_t;
+
+/**
+ * \brief A read cache of deserialized values for one datastore.
+ */
+typedef struct vcdb_cache
+{
+    vcdb_builder_t* builder;
+    size_t value_size;
+    vcdb_cache_shard_t shards[VCDB_CACHE_SHARD_COUNT];
+} vcdb_cache_t;
+
+/**
+ * \brief Acquire a cache shard's spinlock.
+ *
+ * \param shard     The shard to lock.
+ */
+static inline void vcdb_cache_shard_lock(vcdb_cache_shard_t* shard)
+{
+    while (atomic_flag_test_and_set_explicit(
+                &shard->lock, memory_order_acquire))
+    {
+    }
+}
+
+/**
+ * \brief Release a cache shard's spinlock.
+ *
+ * \param shard     The shard to unlock.
+ */
+static inline void vcdb_cache_shard_unlock(vcdb_cache_shard_t* shard)
+{
+    atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+}
+
+/**
+ * \brief Create a cache.
+ *
+ * \param cache         Pointer to receive the cache on success.
+ * \param builder       The builder whose allocator is used.
+ * \param capacity      The number of values which the cache holds.
+ * \param value_size    The size of each deserialized value.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_cache_create(
+    vcdb_cache_t** cache, vcdb_builder_t* builder, size_t capacity,
+    size_t value_size);
+
+/**
+ * \brief Release a cache and all of its values.
+ *
+ * \param cache         The cache to release.
+ */
+void vcdb_cache_release(
+    vcdb_cache_t* cache);
+
+/**
+ * \brief Find a key in a cache shard.  The shard must be locked.
+ *
+ * \param shard         The shard to search.
+ * \param hash          The hash of the key.
+ * \param key           The key to find.
+ * \param key_size      The size of the key.
+ *
+ * \returns the slot offset of the key, or VCDB_CACHE_NIL if it is not found.
+ */
+uint32_t vcdb_cache_shard_find(
+    vcdb_cache_shard_t* shard, uint64_t hash, const void* key,
+    size_t key_size);
+
+/**
+ * \brief Unlink a slot from its bucket chain.  The shard must be locked.
+ *
+ * \param shard         The shard which owns the slot.
+ * \param offset        The offset of the slot to unlink.
+ */
+void vcdb_cache_shard_unlink(
+    vcdb_cache_shard_t* shard, uint32_t offset);
+
+/**
+ * \brief Look up a value in the cache.
+ *
+ * On a hit, the value is copied to the caller's buffer.  On a miss, the
+ * current generation of the key's shard is returned, which must be passed to
+ * vcdb_cache_insert() when the value has been read from the engine.
+ *
+ * \param cache         The cache to search.
+ * \param key           The key to look up.
+ * \param key_size      The size of the key.
+ * \param value         The buffer to receive the value on a hit.
+ * \param generation    Pointer to receive the shard generation on a miss.
+ *
+ * \returns true on a hit, or false on a miss.
+ */
+bool vcdb_cache_lookup(
+    vcdb_cache_t* cache, const void* key, size_t key_size, void* value,
+    uint64_t* generation);
+
+/**
+ * \brief Insert a value into the cache.
+ *
+ * The value is dropped if its shard has been invalidated since the given
+ * generation was read.
+ *
+ * \param cache         The cache to fill.
+ * \param key           The key of the value.
+ * \param key_size      The size of the key.
+ * \param value         The deserialized value.
+ * \param generation    The shard generation returned by vcdb_cache_lookup().
+ */
+void vcdb_cache_insert(
+    vcdb_cache_t* cache, const void* key, size_t key_size, const void* value,
+    uint64_t generation);
+
+/**
+ * \brief Remove a key from the cache.
+ *
+ * \param cache         The cache to update.
+ * \param key           The key to remove.
+ * \param key_size      The size of the key.
+ */
+void vcdb_cache_invalidate(
+    vcdb_cache_t* cache, const void* key, size_t key_size);
+
+/**
+ * \brief Remove every value from the cache.
+ *
+ * \param cache         The cache to clear.
+ */
+void vcdb_cache_clear(
+    vcdb_cache_t* cache);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_CACHE_PRIVATE_HEADER_GUARD*/
@@ -0,0 +1,40 @@
+/**
+ * \file vcdb_cache_clear.c
+ *
+ * \brief Implementation of the vcdb_cache_clear() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "cache_private.h"
+
+/**
+ * \brief Remove every value from the cache.
+ *
+ * \param cache         The cache to clear.
+ */
+void vcdb_cache_clear(
+    vcdb_cache_t* cache)
+{
+    MODEL_ASSERT(NULL != cache);
+
+    for (size_t i = 0; i < VCDB_CACHE_SHARD_COUNT; ++i)
+    {
+        vcdb_cache_shard_t* shard = &cache->shards[i];
+
+        vcdb_cache_shard_lock(shard);
+
+        /* fence off fills which read values before they were written. */
+        ++shard->generation;
+
+        memset(shard->buckets, 0xff,
+            (shard->bucket_mask + 1) * sizeof(uint32_t));
+        memset(shard->slots, 0, shard->capacity * sizeof(vcdb_cache_slot_t));
+        shard->hand = 0;
+
+        vcdb_cache_shard_unlock(shard);
+    }
+}
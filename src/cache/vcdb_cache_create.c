@@ -0,0 +1,94 @@
+/**
+ * \file vcdb_cache_create.c
+ *
+ * \brief Implementation of the vcdb_cache_create() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/error_codes.h>
+
+#include "cache_private.h"
+
+/**
+ * \brief Create a cache.
+ *
+ * \param cache         Pointer to receive the cache on success.
+ * \param builder       The builder whose allocator is used.
+ * \param capacity      The number of values which the cache holds.
+ * \param value_size    The size of each deserialized value.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_cache_create(
+    vcdb_cache_t** cache, vcdb_builder_t* builder, size_t capacity,
+    size_t value_size)
+{
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(0 != capacity);
+    MODEL_ASSERT(0 != value_size);
+
+    /* parameter sanity check. */
+    if (NULL == cache || NULL == builder || 0 == capacity || 0 == value_size
+     || capacity >= VCDB_CACHE_NIL)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_cache_t* c = (vcdb_cache_t*)
+        vcdb_builder_memory_allocate(builder, sizeof(vcdb_cache_t));
+    if (NULL == c)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memset(c, 0, sizeof(vcdb_cache_t));
+    c->builder = builder;
+    c->value_size = value_size;
+
+    /* split the capacity evenly over the shards. */
+    uint32_t shard_capacity = (uint32_t)
+        ((capacity + VCDB_CACHE_SHARD_COUNT - 1) / VCDB_CACHE_SHARD_COUNT);
+
+    /* give each bucket about one slot. */
+    uint32_t bucket_count = 1;
+    while (bucket_count < shard_capacity)
+    {
+        bucket_count <<= 1;
+    }
+
+    for (size_t i = 0; i < VCDB_CACHE_SHARD_COUNT; ++i)
+    {
+        vcdb_cache_shard_t* shard = &c->shards[i];
+
+        atomic_flag_clear(&shard->lock);
+        shard->capacity = shard_capacity;
+        shard->bucket_mask = bucket_count - 1;
+        shard->buckets = (uint32_t*)vcdb_builder_memory_allocate(
+            builder, bucket_count * sizeof(uint32_t));
+        shard->slots = (vcdb_cache_slot_t*)vcdb_builder_memory_allocate(
+            builder, shard_capacity * sizeof(vcdb_cache_slot_t));
+        shard->values = (uint8_t*)vcdb_builder_memory_allocate(
+            builder, shard_capacity * value_size);
+        if (NULL == shard->buckets || NULL == shard->slots
+         || NULL == shard->values)
+        {
+            vcdb_cache_release(c);
+
+            return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+        }
+
+        /* every bucket and slot starts out empty. */
+        memset(shard->buckets, 0xff, bucket_count * sizeof(uint32_t));
+        memset(shard->slots, 0, shard_capacity * sizeof(vcdb_cache_slot_t));
+    }
+
+    *cache = c;
+
+    return VCDB_STATUS_SUCCESS;
+}
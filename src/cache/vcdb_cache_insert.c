@@ -0,0 +1,116 @@
+/**
+ * \file vcdb_cache_insert.c
+ *
+ * \brief Implementation of the vcdb_cache_insert() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "../hash/hash_private.h"
+#include "cache_private.h"
+
+/* forward decls */
+static uint32_t vcdb_cache_shard_evict(vcdb_cache_shard_t* shard);
+
+/**
+ * \brief Insert a value into the cache.
+ *
+ * The value is dropped if its shard has been invalidated since the given
+ * generation was read.
+ *
+ * \param cache         The cache to fill.
+ * \param key           The key of the value.
+ * \param key_size      The size of the key.
+ * \param value         The deserialized value.
+ * \param generation    The shard generation returned by vcdb_cache_lookup().
+ */
+void vcdb_cache_insert(
+    vcdb_cache_t* cache, const void* key, size_t key_size, const void* value,
+    uint64_t generation)
+{
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != value);
+
+    /* long keys are never cached. */
+    if (key_size > VCDB_CACHE_MAX_KEY_SIZE)
+    {
+        return;
+    }
+
+    uint64_t hash = vcdb_hash_fnv1a(key, key_size);
+    vcdb_cache_shard_t* shard =
+        &cache->shards[hash >> VCDB_CACHE_SHARD_SHIFT];
+
+    vcdb_cache_shard_lock(shard);
+
+    /* drop the fill if this value may have been written since it was read. */
+    if (generation != shard->generation)
+    {
+        goto unlock;
+    }
+
+    /* another reader may have filled this value already. */
+    uint32_t offset = vcdb_cache_shard_find(shard, hash, key, key_size);
+    if (VCDB_CACHE_NIL == offset)
+    {
+        offset = vcdb_cache_shard_evict(shard);
+
+        /* new values start out in the probationary segment. */
+        vcdb_cache_slot_t* slot = &shard->slots[offset];
+        uint32_t* bucket = &shard->buckets[hash & shard->bucket_mask];
+        slot->hash = hash;
+        slot->key_size = (uint16_t)key_size;
+        slot->flags = VCDB_CACHE_SLOT_USED;
+        memcpy(slot->key, key, key_size);
+        slot->next = *bucket;
+        *bucket = offset;
+    }
+
+    memcpy(shard->values + (size_t)offset * cache->value_size, value,
+        cache->value_size);
+
+unlock:
+    vcdb_cache_shard_unlock(shard);
+}
+
+/**
+ * \brief Advance the clock hand until a slot can be reused.
+ *
+ * \param shard         The shard from which a slot is evicted.
+ *
+ * \returns the offset of a free slot.
+ */
+static uint32_t vcdb_cache_shard_evict(vcdb_cache_shard_t* shard)
+{
+    /* each pass clears at least one bit per slot, so three passes are enough
+     * to find a victim. */
+    for (;;)
+    {
+        uint32_t offset = shard->hand;
+        vcdb_cache_slot_t* slot = &shard->slots[offset];
+
+        shard->hand = (shard->hand + 1) % shard->capacity;
+
+        if (!(slot->flags & VCDB_CACHE_SLOT_USED))
+        {
+            return offset;
+        }
+        else if (slot->flags & VCDB_CACHE_SLOT_REFERENCED)
+        {
+            slot->flags &= ~VCDB_CACHE_SLOT_REFERENCED;
+        }
+        else if (slot->flags & VCDB_CACHE_SLOT_PROTECTED)
+        {
+            slot->flags &= ~VCDB_CACHE_SLOT_PROTECTED;
+        }
+        else
+        {
+            vcdb_cache_shard_unlink(shard, offset);
+            return offset;
+        }
+    }
+}
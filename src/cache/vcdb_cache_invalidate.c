@@ -0,0 +1,49 @@
+/**
+ * \file vcdb_cache_invalidate.c
+ *
+ * \brief Implementation of the vcdb_cache_invalidate() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "../hash/hash_private.h"
+#include "cache_private.h"
+
+/**
+ * \brief Remove a key from the cache.
+ *
+ * \param cache         The cache to update.
+ * \param key           The key to remove.
+ * \param key_size      The size of the key.
+ */
+void vcdb_cache_invalidate(
+    vcdb_cache_t* cache, const void* key, size_t key_size)
+{
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(NULL != key);
+
+    /* long keys are never cached. */
+    if (key_size > VCDB_CACHE_MAX_KEY_SIZE)
+    {
+        return;
+    }
+
+    uint64_t hash = vcdb_hash_fnv1a(key, key_size);
+    vcdb_cache_shard_t* shard =
+        &cache->shards[hash >> VCDB_CACHE_SHARD_SHIFT];
+
+    vcdb_cache_shard_lock(shard);
+
+    /* fence off fills which read this key before it was written. */
+    ++shard->generation;
+
+    uint32_t offset = vcdb_cache_shard_find(shard, hash, key, key_size);
+    if (VCDB_CACHE_NIL != offset)
+    {
+        vcdb_cache_shard_unlink(shard, offset);
+    }
+
+    vcdb_cache_shard_unlock(shard);
+}
@@ -0,0 +1,75 @@
+/**
+ * \file vcdb_cache_lookup.c
+ *
+ * \brief Implementation of the vcdb_cache_lookup() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "../hash/hash_private.h"
+#include "cache_private.h"
+
+/**
+ * \brief Look up a value in the cache.
+ *
+ * On a hit, the value is copied to the caller's buffer.  On a miss, the
+ * current generation of the key's shard is returned, which must be passed to
+ * vcdb_cache_insert() when the value has been read from the engine.
+ *
+ * \param cache         The cache to search.
+ * \param key           The key to look up.
+ * \param key_size      The size of the key.
+ * \param value         The buffer to receive the value on a hit.
+ * \param generation    Pointer to receive the shard generation on a miss.
+ *
+ * \returns true on a hit, or false on a miss.
+ */
+bool vcdb_cache_lookup(
+    vcdb_cache_t* cache, const void* key, size_t key_size, void* value,
+    uint64_t* generation)
+{
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != generation);
+
+    /* long keys are never cached. */
+    if (key_size > VCDB_CACHE_MAX_KEY_SIZE)
+    {
+        *generation = 0;
+        return false;
+    }
+
+    uint64_t hash = vcdb_hash_fnv1a(key, key_size);
+    vcdb_cache_shard_t* shard =
+        &cache->shards[hash >> VCDB_CACHE_SHARD_SHIFT];
+
+    vcdb_cache_shard_lock(shard);
+
+    uint32_t offset = vcdb_cache_shard_find(shard, hash, key, key_size);
+    if (VCDB_CACHE_NIL == offset)
+    {
+        *generation = shard->generation;
+        vcdb_cache_shard_unlock(shard);
+
+        return false;
+    }
+
+    /* a second hit before the clock hand comes around promotes the value. */
+    vcdb_cache_slot_t* slot = &shard->slots[offset];
+    if (slot->flags & VCDB_CACHE_SLOT_REFERENCED)
+    {
+        slot->flags |= VCDB_CACHE_SLOT_PROTECTED;
+    }
+    slot->flags |= VCDB_CACHE_SLOT_REFERENCED;
+
+    memcpy(value, shard->values + (size_t)offset * cache->value_size,
+        cache->value_size);
+
+    vcdb_cache_shard_unlock(shard);
+
+    return true;
+}
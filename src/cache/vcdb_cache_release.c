@@ -0,0 +1,33 @@
+/**
+ * \file vcdb_cache_release.c
+ *
+ * \brief Implementation of the vcdb_cache_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "cache_private.h"
+
+/**
+ * \brief Release a cache and all of its values.
+ *
+ * \param cache         The cache to release.
+ */
+void vcdb_cache_release(
+    vcdb_cache_t* cache)
+{
+    MODEL_ASSERT(NULL != cache);
+
+    vcdb_builder_t* builder = cache->builder;
+
+    for (size_t i = 0; i < VCDB_CACHE_SHARD_COUNT; ++i)
+    {
+        vcdb_builder_memory_release(builder, cache->shards[i].buckets);
+        vcdb_builder_memory_release(builder, cache->shards[i].slots);
+        vcdb_builder_memory_release(builder, cache->shards[i].values);
+    }
+
+    vcdb_builder_memory_release(builder, cache);
+}
@@ -0,0 +1,45 @@
+/**
+ * \file vcdb_cache_shard_find.c
+ *
+ * \brief Implementation of the vcdb_cache_shard_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "cache_private.h"
+
+/**
+ * \brief Find a key in a cache shard.  The shard must be locked.
+ *
+ * \param shard         The shard to search.
+ * \param hash          The hash of the key.
+ * \param key           The key to find.
+ * \param key_size      The size of the key.
+ *
+ * \returns the slot offset of the key, or VCDB_CACHE_NIL if it is not found.
+ */
+uint32_t vcdb_cache_shard_find(
+    vcdb_cache_shard_t* shard, uint64_t hash, const void* key,
+    size_t key_size)
+{
+    MODEL_ASSERT(NULL != shard);
+    MODEL_ASSERT(NULL != key);
+
+    uint32_t i = shard->buckets[hash & shard->bucket_mask];
+    while (VCDB_CACHE_NIL != i)
+    {
+        vcdb_cache_slot_t* slot = &shard->slots[i];
+        if (slot->hash == hash && slot->key_size == key_size
+         && !memcmp(slot->key, key, key_size))
+        {
+            return i;
+        }
+
+        i = slot->next;
+    }
+
+    return VCDB_CACHE_NIL;
+}
@@ -0,0 +1,42 @@
+/**
+ * \file vcdb_cache_shard_unlink.c
+ *
+ * \brief Implementation of the vcdb_cache_shard_unlink() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "cache_private.h"
+
+/**
+ * \brief Unlink a slot from its bucket chain.  The shard must be locked.
+ *
+ * \param shard         The shard which owns the slot.
+ * \param offset        The offset of the slot to unlink.
+ */
+void vcdb_cache_shard_unlink(
+    vcdb_cache_shard_t* shard, uint32_t offset)
+{
+    MODEL_ASSERT(NULL != shard);
+    MODEL_ASSERT(offset < shard->capacity);
+
+    vcdb_cache_slot_t* slot = &shard->slots[offset];
+    uint32_t* link = &shard->buckets[slot->hash & shard->bucket_mask];
+
+    /* walk the chain to the link which points at this slot. */
+    while (VCDB_CACHE_NIL != *link)
+    {
+        if (offset == *link)
+        {
+            *link = slot->next;
+            break;
+        }
+
+        link = &shard->slots[*link].next;
+    }
+
+    slot->next = VCDB_CACHE_NIL;
+    slot->flags = 0;
+}
@@ -9,6 +9,7 @@
 #ifndef VCDB_DATABASE_PRIVATE_HEADER_GUARD
 #define VCDB_DATABASE_PRIVATE_HEADER_GUARD
 
+#include <stdbool.h>
 #include <vcdb/database.h>
 
 /* make this header C++ friendly. */
@@ -23,6 +24,97 @@ extern "C" {
  */
 void vcdb_database_dispose(void* disposable);
 
+/**
+ * \brief Create the read caches for a database, as sized in its builder.
+ *
+ * \param database          The database for which caches are created.
+ * \param builder           The builder describing the database.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_database_cache_create(
+    vcdb_database_t* database, vcdb_builder_t* builder);
+
+/**
+ * \brief Release the read caches for a database.
+ *
+ * \param database          The database whose caches are released.
+ * \param builder           The builder describing the database.
+ */
+void vcdb_database_cache_release(
+    vcdb_database_t* database, vcdb_builder_t* builder);
+
+/**
+ * \brief Get the read cache for a datastore.
+ *
+ * \param database          The database instance.
+ * \param datastore         The datastore whose cache is returned.
+ *
+ * \returns the cache for this datastore, or NULL if it is not cached.
+ */
+struct vcdb_cache* vcdb_database_cache_find(
+    vcdb_database_t* database, vcdb_datastore_t* datastore);
+
+/**
+ * \brief Create the negative-lookup filters for a database, as sized in its
+ * builder.
+ *
+ * This is called after the engine has created or opened the database.  When
+ * loading, each filter is read using the engine's filter_load method, and the
+ * saved copy is removed.  A filter which can't be loaded is disabled.
+ *
+ * \param database          The database for which filters are created.
+ * \param builder           The builder describing the database.
+ * \param load              Set to true if saved filters should be loaded.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_database_filter_create(
+    vcdb_database_t* database, vcdb_builder_t* builder, bool load);
+
+/**
+ * \brief Release the negative-lookup filters for a database.
+ *
+ * If the engine has a filter_save method, each filter is saved first, so it
+ * can be loaded when the database is next opened.
+ *
+ * \param database          The database whose filters are released.
+ * \param builder           The builder describing the database.
+ */
+void vcdb_database_filter_release(
+    vcdb_database_t* database, vcdb_builder_t* builder);
+
+/**
+ * \brief Get the negative-lookup filter for a datastore or index.
+ *
+ * \param database          The database instance.
+ * \param correlation_id    The correlation ID of the datastore or index.
+ *
+ * \returns the filter, or NULL if it is not filtered.
+ */
+struct vcdb_filter* vcdb_database_filter_find(
+    vcdb_database_t* database, int correlation_id);
+
+/**
+ * \brief Add the keys of a value being written to the negative-lookup filters
+ * of its datastore and that datastore's indexes.
+ *
+ * \param database          The database instance.
+ * \param datastore         The datastore being written.
+ * \param key               The key of the value.
+ * \param key_size          The size of the key.
+ * \param value             The value being written, or NULL if the value is
+ *                          not known, in which case the index filters are
+ *                          saturated.
+ */
+void vcdb_database_filter_add_value(
+    vcdb_database_t* database, vcdb_datastore_t* datastore,
+    const void* key, size_t key_size, const void* value);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
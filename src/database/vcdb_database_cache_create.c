@@ -0,0 +1,80 @@
+/**
+ * \file vcdb_database_cache_create.c
+ *
+ * \brief Implementation of the vcdb_database_cache_create() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/database.h>
+
+#include "../cache/cache_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Create the read caches for a database, as sized in its builder.
+ *
+ * \param database          The database for which caches are created.
+ * \param builder           The builder describing the database.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_database_cache_create(
+    vcdb_database_t* database, vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != builder);
+
+    database->datastore_cache = NULL;
+
+    /* only pay for the cache table if a datastore is cached. */
+    bool cached = false;
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        if (0 != builder->instance_array[i].cache_size)
+        {
+            cached = true;
+            break;
+        }
+    }
+
+    if (!cached)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    size_t table_size = builder->instance_array_size * sizeof(vcdb_cache_t*);
+    database->datastore_cache = (vcdb_cache_t**)
+        vcdb_builder_memory_allocate(builder, table_size);
+    if (NULL == database->datastore_cache)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memset(database->datastore_cache, 0, table_size);
+
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        vcdb_builder_datastore_instance_t* inst = &builder->instance_array[i];
+        if (0 == inst->cache_size)
+        {
+            continue;
+        }
+
+        int retval = vcdb_cache_create(
+            &database->datastore_cache[i], builder, inst->cache_size,
+            inst->instance.datastore->data_size);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            vcdb_database_cache_release(database, builder);
+
+            return retval;
+        }
+    }
+
+    return VCDB_STATUS_SUCCESS;
+}
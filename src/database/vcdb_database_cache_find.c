@@ -0,0 +1,37 @@
+/**
+ * \file vcdb_database_cache_find.c
+ *
+ * \brief Implementation of the vcdb_database_cache_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+
+#include "database_private.h"
+
+/**
+ * \brief Get the read cache for a datastore.
+ *
+ * \param database          The database instance.
+ * \param datastore         The datastore whose cache is returned.
+ *
+ * \returns the cache for this datastore, or NULL if it is not cached.
+ */
+struct vcdb_cache* vcdb_database_cache_find(
+    vcdb_database_t* database, vcdb_datastore_t* datastore)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != datastore);
+
+    if (NULL == database->datastore_cache
+     || datastore->correlation_id < 0
+     || (size_t)datastore->correlation_id
+            >= database->builder->instance_array_size)
+    {
+        return NULL;
+    }
+
+    return database->datastore_cache[datastore->correlation_id];
+}
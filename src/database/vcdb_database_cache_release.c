@@ -0,0 +1,42 @@
+/**
+ * \file vcdb_database_cache_release.c
+ *
+ * \brief Implementation of the vcdb_database_cache_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+
+#include "../cache/cache_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Release the read caches for a database.
+ *
+ * \param database          The database whose caches are released.
+ * \param builder           The builder describing the database.
+ */
+void vcdb_database_cache_release(
+    vcdb_database_t* database, vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != builder);
+
+    if (NULL == database->datastore_cache)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        if (NULL != database->datastore_cache[i])
+        {
+            vcdb_cache_release(database->datastore_cache[i]);
+        }
+    }
+
+    vcdb_builder_memory_release(builder, database->datastore_cache);
+    database->datastore_cache = NULL;
+}
@@ -10,8 +10,17 @@
 #include <vcdb/database.h>
 #include <vpr/parameters.h>
 
+#include "../builder/builder_private.h"
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
 #include "database_private.h"
 
+/* forward decls */
+static int vcdb_database_create_from_builder_unhooked(
+    vcdb_database_t* database,
+    vcdb_builder_t* builder);
+
 /**
  * \brief Create a database from the given builder.
  *
@@ -28,6 +37,42 @@
 int vcdb_database_create_from_builder(
     vcdb_database_t* database,
     vcdb_builder_t* builder)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_database_create_from_builder_unhooked(database, builder);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(hooks, &event, VCDB_HOOK_DATABASE_CREATE, NULL, 0, 0);
+
+    int retval = vcdb_database_create_from_builder_unhooked(database, builder);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_database_create_from_builder(), run with or
+ * without hooks.
+ *
+ * The builder must stay in scope as long as the handle is in scope.  The handle
+ * is owned by the caller and must be disposed of by calling dispose() on it.
+ *
+ * \param database  The database instance to create.
+ * \param builder   The builder to use to create this database.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+static int vcdb_database_create_from_builder_unhooked(
+    vcdb_database_t* database,
+    vcdb_builder_t* builder)
 {
     /* TODO - add data structure invariant checks for database and builder. */
     MODEL_ASSERT(NULL != database);
@@ -40,8 +85,42 @@ int vcdb_database_create_from_builder(
         return VCDB_ERROR_INVALID_PARAMETER;
     }
 
+    /* build the schema so the engine can resolve datastores and indexes. */
+    int retval = vcdb_builder_schema_build(builder);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* set up the read caches. */
+    retval = vcdb_database_cache_create(database, builder);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* set up the operation counters. */
+    retval = vcdb_stats_create(
+        &database->stats, builder, builder->instance_array_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        vcdb_database_cache_release(database, builder);
+
+        return retval;
+    }
+
+    /* set up the latency histograms. */
+    retval = vcdb_latency_create(&database->latency, builder);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        vcdb_database_cache_release(database, builder);
+        vcdb_stats_release(database->stats);
+
+        return retval;
+    }
+
     /* create the database using the engine-specific create method. */
-    int retval = builder->engine->database_create(database, builder);
+    retval = builder->engine->database_create(database, builder);
 
     /* if successful, set the opened flag and the builder pointer. */
     if (retval == VCDB_STATUS_SUCCESS)
@@ -50,6 +129,21 @@ int vcdb_database_create_from_builder(
         database->hdr.dispose = &vcdb_database_dispose;
         database->builder = builder;
     }
+    else
+    {
+        vcdb_database_cache_release(database, builder);
+        vcdb_stats_release(database->stats);
+        vcdb_latency_release(database->latency);
+
+        return retval;
+    }
+
+    /* set up the negative-lookup filters. */
+    retval = vcdb_database_filter_create(database, builder, false);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)database);
+    }
 
     return retval;
 }
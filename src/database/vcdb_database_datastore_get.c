@@ -10,11 +10,28 @@
 #include <vcdb/database.h>
 #include <vpr/parameters.h>
 
+#include "../cache/cache_private.h"
+#include "../datastore/datastore_private.h"
+#include "../filter/filter_private.h"
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "database_private.h"
+
 /* set a sane default for allocation. */
 #ifndef VCDB_DATABASE_DATASTORE_GET_DEFAULT_DESERIALIZATION_BUFFER_SIZE
 #define VCDB_DATABASE_DATASTORE_GET_DEFAULT_DESERIALIZATION_BUFFER_SIZE 1024
 #endif
 
+/* forward decls */
+static int vcdb_database_datastore_get_unhooked(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size);
+
 /**
  * \brief Get a value from the database corresponding to a given key.
  *
@@ -40,6 +57,55 @@ int vcdb_database_datastore_get(
     size_t key_size,
     void* value,
     size_t* value_size)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_database_datastore_get_unhooked(
+            database, datastore, key, key_size, value, value_size);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(
+        hooks, &event, VCDB_HOOK_DATASTORE_GET,
+        NULL == datastore ? NULL : datastore->name, key_size,
+        NULL == value_size ? 0 : *value_size);
+
+    int retval = vcdb_database_datastore_get_unhooked(
+        database, datastore, key, key_size, value, value_size);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_database_datastore_get(), run with or without hooks.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to get the value from.
+ * \param key           The key to use for the query.
+ * \param key_size      The size of the key.
+ * \param value         The value to read.
+ * \param value_size    The size pointer.  Must be set to the maximum size of
+ *                      the value buffer.  On success, this pointer is updated
+ *                      to the size of the data read.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the value is not in the datastore.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the value_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+static int vcdb_database_datastore_get_unhooked(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size)
 {
     /* TODO - add data structure invariant checks for database. */
     MODEL_ASSERT(NULL != database);
@@ -66,18 +132,48 @@ int vcdb_database_datastore_get(
         return VCDB_ERROR_WOULD_TRUNCATE;
     }
 
-    /* allocate temporary buffer for deserialization. */
+    int id = datastore->correlation_id;
+    vcdb_stats_add(database->stats, id, VCDB_STATS_GETS, 1);
+
+    /* skip the engine for keys which were never put. */
+    vcdb_filter_t* filter = vcdb_database_filter_find(database, id);
+    if (NULL != filter && !vcdb_filter_maybe_contains(filter, key, key_size))
+    {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_FILTER_REJECTS, 1);
+        vcdb_stats_add(database->stats, id, VCDB_STATS_MISSES, 1);
+
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    /* serve hot values from the read cache. */
+    uint64_t generation = 0;
+    vcdb_cache_t* cache = vcdb_database_cache_find(database, datastore);
+    if (NULL != cache
+     && vcdb_cache_lookup(cache, key, key_size, value, &generation))
+    {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_CACHE_HITS, 1);
+        vcdb_stats_add(database->stats, id, VCDB_STATS_HITS, 1);
+
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    /* use the stack when the datastore's serial data size allows it. */
+    uint8_t stack_buffer[VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE];
     size_t buffer_size =
         VCDB_DATABASE_DATASTORE_GET_DEFAULT_DESERIALIZATION_BUFFER_SIZE;
-    void* buffer = malloc(buffer_size);
+    void* buffer = vcdb_datastore_serial_buffer_get(
+        database->builder, datastore, value, stack_buffer, &buffer_size);
+    size_t buffer_max = buffer_size;
     if (buffer == NULL)
     {
         return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
     }
 
     /* read the data from the engine */
+    uint64_t timer = vcdb_latency_start(database->latency);
     int retval = database->builder->engine->datastore_get(
         database, datastore, key, key_size, buffer, &buffer_size);
+    vcdb_latency_record(database->latency, id, VCDB_DATABASE_METHOD_GET, timer);
     if (retval != VCDB_STATUS_SUCCESS && retval != VCDB_ERROR_WOULD_TRUNCATE)
     {
         goto cleanup_allocation;
@@ -85,8 +181,12 @@ int vcdb_database_datastore_get(
     /* was our buffer too small? */
     else if (retval == VCDB_ERROR_WOULD_TRUNCATE)
     {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_TRUNCATE_RETRIES, 1);
+
         /* try to reallocate the buffer. */
-        void* buf2 = realloc(buffer, buffer_size);
+        void* buf2 = vcdb_datastore_serial_buffer_grow(
+            database->builder, buffer, value, stack_buffer, buffer_max,
+            buffer_size);
         if (NULL == buf2)
         {
             retval = VCDB_ERROR_BAD_MEMORY_ALLOCATION;
@@ -95,8 +195,11 @@ int vcdb_database_datastore_get(
         buffer = buf2;
 
         /* retry the datastore_get with the larger size. */
+        timer = vcdb_latency_start(database->latency);
         retval = database->builder->engine->datastore_get(
             database, datastore, key, key_size, buffer, &buffer_size);
+        vcdb_latency_record(
+            database->latency, id, VCDB_DATABASE_METHOD_GET, timer);
         if (retval != VCDB_STATUS_SUCCESS)
         {
             goto cleanup_allocation;
@@ -104,10 +207,27 @@ int vcdb_database_datastore_get(
     }
 
     /* convert the serialized data back to the raw value. */
-    retval = datastore->value_reader(buffer, buffer_size, value);
+    retval =
+        vcdb_datastore_serial_buffer_read(
+            datastore, buffer, buffer_size, value);
+    vcdb_stats_add(database->stats, id, VCDB_STATS_HITS, 1);
+    vcdb_stats_add(
+        database->stats, id, VCDB_STATS_BYTES_DESERIALIZED, buffer_size);
+
+    /* remember the value for the next reader. */
+    if (VCDB_STATUS_SUCCESS == retval && NULL != cache)
+    {
+        vcdb_cache_insert(cache, key, key_size, value, generation);
+    }
 
 cleanup_allocation:
-    free(buffer);
+    vcdb_datastore_serial_buffer_release(
+        database->builder, buffer, value, stack_buffer);
+
+    if (VCDB_ERROR_VALUE_NOT_FOUND == retval)
+    {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_MISSES, 1);
+    }
 
     return retval;
 }
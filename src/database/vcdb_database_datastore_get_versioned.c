@@ -0,0 +1,171 @@
+/**
+ * \file vcdb_database_datastore_get_versioned.c
+ *
+ * \brief Implementation of the vcdb_database_datastore_get_versioned() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+#include <vpr/parameters.h>
+
+#include "../datastore/datastore_private.h"
+#include "../filter/filter_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "database_private.h"
+
+/* set a sane default for allocation. */
+#ifndef VCDB_DATABASE_DATASTORE_GET_DEFAULT_DESERIALIZATION_BUFFER_SIZE
+#define VCDB_DATABASE_DATASTORE_GET_DEFAULT_DESERIALIZATION_BUFFER_SIZE 1024
+#endif
+
+/**
+ * \brief Get a value and its version token from the database corresponding to
+ * a given key.
+ *
+ * The version token can be passed to vcdb_database_datastore_put_if_version()
+ * to update the value only if it has not changed since it was read.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to get the value from.
+ * \param key           The key to use for the query.
+ * \param key_size      The size of the key.
+ * \param value         The value to read.
+ * \param value_size    The size pointer.  Must be set to the maximum size of
+ *                      the value buffer.  On success, this pointer is updated
+ *                      to the size of the data read.
+ * \param version       Pointer to receive the version token of the value.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the value is not in the datastore.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the value_size is too small.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support
+ *            versioned reads.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_get_versioned(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t* version)
+{
+    /* TODO - add data structure invariant checks for database. */
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(0 < key_size);
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != value_size);
+    MODEL_ASSERT(0 < *value_size);
+    MODEL_ASSERT(NULL != version);
+
+    /* parameter check */
+    if (
+        NULL == database || NULL == datastore || NULL == key || 0 >= key_size || NULL == value || NULL == value_size || 0 >= *value_size || NULL == version)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* versioned reads are optional for engines. */
+    vcdb_database_engine_t* engine = database->builder->engine;
+    if (NULL == engine->datastore_get_versioned)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    /* verify that the value size is correct for this type. */
+    if (*value_size < datastore->data_size)
+    {
+        /* let the caller know how much data we need. */
+        *value_size = datastore->data_size;
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    int id = datastore->correlation_id;
+    vcdb_stats_add(database->stats, id, VCDB_STATS_GETS, 1);
+
+    /* skip the engine for keys which were never put. */
+    vcdb_filter_t* filter = vcdb_database_filter_find(database, id);
+    if (NULL != filter && !vcdb_filter_maybe_contains(filter, key, key_size))
+    {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_FILTER_REJECTS, 1);
+        vcdb_stats_add(database->stats, id, VCDB_STATS_MISSES, 1);
+
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    /* use the stack when the datastore's serial data size allows it. */
+    uint8_t stack_buffer[VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE];
+    size_t buffer_size =
+        VCDB_DATABASE_DATASTORE_GET_DEFAULT_DESERIALIZATION_BUFFER_SIZE;
+    void* buffer = vcdb_datastore_serial_buffer_get(
+        database->builder, datastore, value, stack_buffer, &buffer_size);
+    size_t buffer_max = buffer_size;
+    if (buffer == NULL)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    /* read the data from the engine */
+    uint64_t timer = vcdb_latency_start(database->latency);
+    int retval = engine->datastore_get_versioned(
+        database, datastore, key, key_size, buffer, &buffer_size, version);
+    vcdb_latency_record(database->latency, id, VCDB_DATABASE_METHOD_GET, timer);
+    if (retval != VCDB_STATUS_SUCCESS && retval != VCDB_ERROR_WOULD_TRUNCATE)
+    {
+        goto cleanup_allocation;
+    }
+    /* was our buffer too small? */
+    else if (retval == VCDB_ERROR_WOULD_TRUNCATE)
+    {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_TRUNCATE_RETRIES, 1);
+
+        /* try to reallocate the buffer. */
+        void* buf2 = vcdb_datastore_serial_buffer_grow(
+            database->builder, buffer, value, stack_buffer, buffer_max,
+            buffer_size);
+        if (NULL == buf2)
+        {
+            retval = VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+            goto cleanup_allocation;
+        }
+        buffer = buf2;
+
+        /* retry the read with the larger size. */
+        timer = vcdb_latency_start(database->latency);
+        retval = engine->datastore_get_versioned(
+            database, datastore, key, key_size, buffer, &buffer_size, version);
+        vcdb_latency_record(
+            database->latency, id, VCDB_DATABASE_METHOD_GET, timer);
+        if (retval != VCDB_STATUS_SUCCESS)
+        {
+            goto cleanup_allocation;
+        }
+    }
+
+    /* convert the serialized data back to the raw value. */
+    retval =
+        vcdb_datastore_serial_buffer_read(
+            datastore, buffer, buffer_size, value);
+    vcdb_stats_add(database->stats, id, VCDB_STATS_HITS, 1);
+    vcdb_stats_add(
+        database->stats, id, VCDB_STATS_BYTES_DESERIALIZED, buffer_size);
+
+cleanup_allocation:
+    vcdb_datastore_serial_buffer_release(
+        database->builder, buffer, value, stack_buffer);
+
+    if (VCDB_ERROR_VALUE_NOT_FOUND == retval)
+    {
+        vcdb_stats_add(database->stats, id, VCDB_STATS_MISSES, 1);
+    }
+
+    return retval;
+}
@@ -9,6 +9,9 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
 #include "database_private.h"
 
 /**
@@ -19,13 +22,38 @@
 void vcdb_database_dispose(void* disposable)
 {
     vcdb_database_t* database = (vcdb_database_t*)disposable;
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+    vcdb_hook_event_t event;
+
+    if (NULL != hooks)
+    {
+        vcdb_hooks_begin(
+            hooks, &event, VCDB_HOOK_DATABASE_DISPOSE, NULL, 0, 0);
+    }
+
+    /* save and release the negative-lookup filters. */
+    vcdb_database_filter_release(database, database->builder);
 
     /* close the database. */
     database->builder->engine->database_close(database);
 
+    /* release the read caches. */
+    vcdb_database_cache_release(database, database->builder);
+
+    /* release the operation counters. */
+    vcdb_stats_release(database->stats);
+
+    /* release the latency histograms. */
+    vcdb_latency_release(database->latency);
+
     /* the database is no longer opened. */
     database->builder->database_opened = false;
 
     /* clear the database data structure. */
     memset(database, 0, sizeof(vcdb_database_t));
+
+    if (NULL != hooks)
+    {
+        vcdb_hooks_end(hooks, &event, VCDB_STATUS_SUCCESS);
+    }
 }
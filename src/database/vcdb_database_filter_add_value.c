@@ -0,0 +1,84 @@
+/**
+ * \file vcdb_database_filter_add_value.c
+ *
+ * \brief Implementation of the vcdb_database_filter_add_value() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+
+#include "../filter/filter_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Add the keys of a value being written to the negative-lookup filters
+ * of its datastore and that datastore's indexes.
+ *
+ * \param database          The database instance.
+ * \param datastore         The datastore being written.
+ * \param key               The key of the value.
+ * \param key_size          The size of the key.
+ * \param value             The value being written, or NULL if the value is
+ *                          not known, in which case the index filters are
+ *                          saturated.
+ */
+void vcdb_database_filter_add_value(
+    vcdb_database_t* database, vcdb_datastore_t* datastore,
+    const void* key, size_t key_size, const void* value)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != key);
+
+    if (NULL == database->instance_filter)
+    {
+        return;
+    }
+
+    vcdb_filter_t* filter =
+        vcdb_database_filter_find(database, datastore->correlation_id);
+    if (NULL != filter)
+    {
+        vcdb_filter_add(filter, key, key_size);
+    }
+
+    /* the engine maintains the indexes, so mirror their keys here. */
+    vcdb_index_t* const* indexes;
+    size_t count;
+    if (VCDB_STATUS_SUCCESS
+            != vcdb_builder_datastore_indexes_get(
+                    database->builder, datastore, &indexes, &count))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        filter = vcdb_database_filter_find(database, indexes[i]->correlation_id);
+        if (NULL == filter)
+        {
+            continue;
+        }
+
+        if (NULL == value)
+        {
+            vcdb_filter_saturate(filter);
+            continue;
+        }
+
+        /* values outside a partial index have no secondary key in it. */
+        if (!vcdb_index_value_included(indexes[i], value))
+        {
+            continue;
+        }
+
+        char secondary_key[VCDB_MAX_KEY_SIZE];
+        size_t secondary_key_size = sizeof(secondary_key);
+        indexes[i]->secondary_key_getter(
+            value, secondary_key, &secondary_key_size);
+
+        vcdb_filter_add(filter, secondary_key, secondary_key_size);
+    }
+}
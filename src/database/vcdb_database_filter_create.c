@@ -0,0 +1,131 @@
+/**
+ * \file vcdb_database_filter_create.c
+ *
+ * \brief Implementation of the vcdb_database_filter_create() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/database.h>
+
+#include "../filter/filter_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Create the negative-lookup filters for a database, as sized in its
+ * builder.
+ *
+ * This is called after the engine has created or opened the database.  When
+ * loading, each filter is read using the engine's filter_load method, and the
+ * saved copy is removed.  A filter which can't be loaded is disabled.
+ *
+ * \param database          The database for which filters are created.
+ * \param builder           The builder describing the database.
+ * \param load              Set to true if saved filters should be loaded.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_database_filter_create(
+    vcdb_database_t* database, vcdb_builder_t* builder, bool load)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != builder);
+
+    int retval;
+    database->instance_filter = NULL;
+
+    /* only pay for the filter table if something is filtered. */
+    bool filtered = false;
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        if (0 != builder->instance_array[i].filter_size)
+        {
+            filtered = true;
+            break;
+        }
+    }
+
+    if (!filtered)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    size_t table_size = builder->instance_array_size * sizeof(vcdb_filter_t*);
+    database->instance_filter = (vcdb_filter_t**)
+        vcdb_builder_memory_allocate(builder, table_size);
+    if (NULL == database->instance_filter)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memset(database->instance_filter, 0, table_size);
+
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        size_t filter_size = builder->instance_array[i].filter_size;
+        if (0 == filter_size)
+        {
+            continue;
+        }
+
+        /* without saved data, an opened database's filter is incomplete. */
+        if (load && (NULL == builder->engine->filter_load
+                  || NULL == builder->engine->filter_save))
+        {
+            continue;
+        }
+
+        vcdb_filter_t* filter;
+        retval = vcdb_filter_create(&filter, builder, filter_size);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_filters;
+        }
+
+        if (load)
+        {
+            size_t expected_size =
+                filter->block_count * VCDB_FILTER_BLOCK_SIZE;
+            size_t size = expected_size;
+
+            /* a filter saved with a different size can't be used. */
+            retval = builder->engine->filter_load(
+                database, (int)i, (void*)filter->blocks, &size);
+            if (VCDB_STATUS_SUCCESS != retval || size != expected_size)
+            {
+                vcdb_filter_release(filter);
+                continue;
+            }
+
+            /* a crash must not leave a filter which misses later writes. */
+            retval = builder->engine->filter_save(database, (int)i, NULL, 0);
+            if (VCDB_STATUS_SUCCESS != retval)
+            {
+                vcdb_filter_release(filter);
+                continue;
+            }
+        }
+
+        database->instance_filter[i] = filter;
+    }
+
+    return VCDB_STATUS_SUCCESS;
+
+cleanup_filters:
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        if (NULL != database->instance_filter[i])
+        {
+            vcdb_filter_release(database->instance_filter[i]);
+        }
+    }
+
+    vcdb_builder_memory_release(builder, database->instance_filter);
+    database->instance_filter = NULL;
+
+    return retval;
+}
@@ -0,0 +1,36 @@
+/**
+ * \file vcdb_database_filter_find.c
+ *
+ * \brief Implementation of the vcdb_database_filter_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+
+#include "../filter/filter_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Get the negative-lookup filter for a datastore or index.
+ *
+ * \param database          The database instance.
+ * \param correlation_id    The correlation ID of the datastore or index.
+ *
+ * \returns the filter, or NULL if it is not filtered.
+ */
+struct vcdb_filter* vcdb_database_filter_find(
+    vcdb_database_t* database, int correlation_id)
+{
+    MODEL_ASSERT(NULL != database);
+
+    if (NULL == database->instance_filter
+     || correlation_id < 0
+     || (size_t)correlation_id >= database->builder->instance_array_size)
+    {
+        return NULL;
+    }
+
+    return database->instance_filter[correlation_id];
+}
@@ -0,0 +1,57 @@
+/**
+ * \file vcdb_database_filter_release.c
+ *
+ * \brief Implementation of the vcdb_database_filter_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+
+#include "../filter/filter_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Release the negative-lookup filters for a database.
+ *
+ * If the engine has a filter_save method, each filter is saved first, so it
+ * can be loaded when the database is next opened.
+ *
+ * \param database          The database whose filters are released.
+ * \param builder           The builder describing the database.
+ */
+void vcdb_database_filter_release(
+    vcdb_database_t* database, vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != builder);
+
+    if (NULL == database->instance_filter)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        vcdb_filter_t* filter = database->instance_filter[i];
+        if (NULL == filter)
+        {
+            continue;
+        }
+
+        /* a saturated filter is useless, so leave nothing to load. */
+        if (NULL != builder->engine->filter_save
+         && !atomic_load(&filter->saturated))
+        {
+            builder->engine->filter_save(
+                database, (int)i, (const void*)filter->blocks,
+                filter->block_count * VCDB_FILTER_BLOCK_SIZE);
+        }
+
+        vcdb_filter_release(filter);
+    }
+
+    vcdb_builder_memory_release(builder, database->instance_filter);
+    database->instance_filter = NULL;
+}
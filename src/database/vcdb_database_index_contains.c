@@ -0,0 +1,82 @@
+/**
+ * \file vcdb_database_index_contains.c
+ *
+ * \brief Implementation of the vcdb_database_index_contains() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/database.h>
+#include <vpr/parameters.h>
+
+#include "../filter/filter_private.h"
+#include "database_private.h"
+
+/* the fallback reads the value into a scratch buffer of this size. */
+#ifndef VCDB_DATABASE_INDEX_CONTAINS_SCRATCH_BUFFER_SIZE
+#define VCDB_DATABASE_INDEX_CONTAINS_SCRATCH_BUFFER_SIZE 16
+#endif
+
+/**
+ * \brief Check whether a key is in a secondary index.
+ *
+ * This is cheaper than vcdb_database_index_get(), since no value buffer is
+ * needed and the value is not deserialized.
+ *
+ * \param database      The database instance to use.
+ * \param index         The secondary index to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the index.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_index_contains(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size)
+{
+    /* TODO - add data structure invariant checks for database. */
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(0 < key_size);
+
+    /* parameter check */
+    if (
+        NULL == database || NULL == index || NULL == key || 0 >= key_size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* skip the engine for keys which were never put. */
+    vcdb_filter_t* filter =
+        vcdb_database_filter_find(database, index->correlation_id);
+    if (NULL != filter && !vcdb_filter_maybe_contains(filter, key, key_size))
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    /* let the engine check membership if it can. */
+    vcdb_database_engine_t* engine = database->builder->engine;
+    if (NULL != engine->index_contains)
+    {
+        return engine->index_contains(database, index, key, key_size);
+    }
+
+    /* otherwise, a value which doesn't fit the scratch buffer still exists. */
+    char scratch[VCDB_DATABASE_INDEX_CONTAINS_SCRATCH_BUFFER_SIZE];
+    size_t scratch_size = sizeof(scratch);
+    int retval = engine->index_get(
+        database, index, key, key_size, scratch, &scratch_size);
+    if (VCDB_ERROR_WOULD_TRUNCATE == retval)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    return retval;
+}
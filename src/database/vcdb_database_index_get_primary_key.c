@@ -0,0 +1,197 @@
+/**
+ * \file vcdb_database_index_get_primary_key.c
+ *
+ * \brief Implementation of the vcdb_database_index_get_primary_key() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/database.h>
+#include <vpr/parameters.h>
+
+#include "../datastore/datastore_private.h"
+#include "../filter/filter_private.h"
+#include "database_private.h"
+
+/* forward decls */
+static VCDB_DATASTORE_KEY_COPY_NOINLINE int
+vcdb_database_index_get_primary_key_copy(
+    vcdb_datastore_t* datastore,
+    const void* value,
+    void* primary_key,
+    size_t* primary_key_size);
+static int vcdb_database_index_get_primary_key_store(
+    const void* found_key,
+    size_t found_key_size,
+    void* primary_key,
+    size_t* primary_key_size);
+
+/**
+ * \brief Get the primary key that a secondary index key maps to.
+ *
+ * The primary value is not deserialized.  Engines which support it answer
+ * without a second lookup into the primary datastore.
+ *
+ * \param database          The database instance to use.
+ * \param index             The secondary index to use.
+ * \param key               The secondary key to use for the query.
+ * \param key_size          The size of the secondary key.
+ * \param primary_key       The buffer to receive the primary key.
+ * \param primary_key_size  The size pointer.  Must be set to the size of the
+ *                          primary key buffer.  On success, this pointer is
+ *                          updated to the size of the primary key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ *            In this case, primary_key_size is updated to the size needed.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_index_get_primary_key(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size)
+{
+    /* TODO - add data structure invariant checks for database. */
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(NULL != index->datastore);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(0 < key_size);
+    MODEL_ASSERT(NULL != primary_key);
+    MODEL_ASSERT(NULL != primary_key_size);
+
+    /* parameter check */
+    if (
+        NULL == database || NULL == index || NULL == index->datastore || NULL == key || 0 >= key_size || NULL == primary_key || NULL == primary_key_size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* skip the engine for keys which were never put. */
+    vcdb_filter_t* filter =
+        vcdb_database_filter_find(database, index->correlation_id);
+    if (NULL != filter && !vcdb_filter_maybe_contains(filter, key, key_size))
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    /* let the engine resolve the mapping if it can. */
+    vcdb_database_engine_t* engine = database->builder->engine;
+    if (NULL != engine->index_get_primary_key)
+    {
+        return engine->index_get_primary_key(
+            database, index, key, key_size, primary_key, primary_key_size);
+    }
+
+    /* otherwise, read the value and get its key. */
+    size_t value_size = index->datastore->data_size;
+    void* value = vcdb_builder_memory_allocate(database->builder, value_size);
+    if (NULL == value)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    int retval =
+        vcdb_database_index_get(
+            database, index, key, key_size, value, &value_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_value;
+    }
+
+    /* a key reference is copied straight out of the value. */
+    if (NULL != index->datastore->key_reference_getter)
+    {
+        size_t found_key_size;
+        const void* found_key =
+            index->datastore->key_reference_getter(value, &found_key_size);
+
+        retval =
+            vcdb_database_index_get_primary_key_store(
+                found_key, found_key_size, primary_key, primary_key_size);
+    }
+    else
+    {
+        retval =
+            vcdb_database_index_get_primary_key_copy(
+                index->datastore, value, primary_key, primary_key_size);
+    }
+
+cleanup_value:
+    vcdb_builder_memory_release(database->builder, value);
+
+    return retval;
+}
+
+/**
+ * \brief Get a copy of the key from the value, then store it for the caller.
+ *
+ * The key buffer lives in this frame only, so datastores with a key reference
+ * getter do not pay for it.
+ *
+ * \param datastore         The datastore of the value.
+ * \param value             The value read from the index.
+ * \param primary_key       The buffer to receive the primary key.
+ * \param primary_key_size  The size of the primary key buffer, updated to the
+ *                          size of the primary key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ */
+static VCDB_DATASTORE_KEY_COPY_NOINLINE int
+vcdb_database_index_get_primary_key_copy(
+    vcdb_datastore_t* datastore,
+    const void* value,
+    void* primary_key,
+    size_t* primary_key_size)
+{
+    char key_buffer[VCDB_MAX_KEY_SIZE];
+    size_t found_key_size = sizeof(key_buffer);
+    datastore->key_getter(value, key_buffer, &found_key_size);
+
+    return
+        vcdb_database_index_get_primary_key_store(
+            key_buffer, found_key_size, primary_key, primary_key_size);
+}
+
+/**
+ * \brief Store a primary key in the caller's buffer.
+ *
+ * \param found_key         The primary key.
+ * \param found_key_size    The size of the primary key.
+ * \param primary_key       The buffer to receive the primary key.
+ * \param primary_key_size  The size of the primary key buffer, updated to the
+ *                          size of the primary key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ *            In this case, primary_key_size is updated to the size needed.
+ */
+static int vcdb_database_index_get_primary_key_store(
+    const void* found_key,
+    size_t found_key_size,
+    void* primary_key,
+    size_t* primary_key_size)
+{
+    /* let the caller know how much space the key needs. */
+    if (*primary_key_size < found_key_size)
+    {
+        *primary_key_size = found_key_size;
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(primary_key, found_key, found_key_size);
+    *primary_key_size = found_key_size;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/**
+ * \file vcdb_database_index_get_projection.c
+ *
+ * \brief Implementation of the vcdb_database_index_get_projection() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/database.h>
+#include <vpr/parameters.h>
+
+#include "../filter/filter_private.h"
+#include "../index/index_private.h"
+#include "database_private.h"
+
+/**
+ * \brief Get the projection stored in a covering index for a given key.
+ *
+ * The index must have a projection writer.  The projection is returned in its
+ * serialized form, straight from the index entry, without reading the primary
+ * datastore.  If the engine does not store projections, the value is read via
+ * the index and projected.  Projections are kept current because merge
+ * operands can't be recorded against a datastore with an index.
+ *
+ * \param database          The database instance to use.
+ * \param index             The covering index to use.
+ * \param key               The secondary key to use for the query.
+ * \param key_size          The size of the secondary key.
+ * \param projection        The buffer to receive the projection.
+ * \param projection_size   The size pointer.  Must be set to the size of the
+ *                          projection buffer.  On success, this pointer is
+ *                          updated to the size of the projection.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the projection_size is too small.
+ *            In this case, projection_size is updated to the size needed.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the index has no projection
+ *            writer.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_index_get_projection(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t* projection_size)
+{
+    /* TODO - add data structure invariant checks for database. */
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(NULL != index->datastore);
+    MODEL_ASSERT(NULL != index->projection_writer);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(0 < key_size);
+    MODEL_ASSERT(NULL != projection);
+    MODEL_ASSERT(NULL != projection_size);
+
+    /* parameter check */
+    if (
+        NULL == database || NULL == index || NULL == index->datastore || NULL == index->projection_writer || NULL == key || 0 >= key_size || NULL == projection || NULL == projection_size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* skip the engine for keys which were never put. */
+    vcdb_filter_t* filter =
+        vcdb_database_filter_find(database, index->correlation_id);
+    if (NULL != filter && !vcdb_filter_maybe_contains(filter, key, key_size))
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    /* read the projection from the index entry if the engine stores it. */
+    vcdb_database_engine_t* engine = database->builder->engine;
+    if (NULL != engine->index_get_projection)
+    {
+        return engine->index_get_projection(
+            database, index, key, key_size, projection, projection_size);
+    }
+
+    /* otherwise, read the value and project it. */
+    size_t value_size = index->datastore->data_size;
+    void* value = vcdb_builder_memory_allocate(database->builder, value_size);
+    if (NULL == value)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    int retval =
+        vcdb_database_index_get(
+            database, index, key, key_size, value, &value_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_value;
+    }
+
+    void* found;
+    size_t found_size;
+    retval = vcdb_index_projection_write(
+            database->builder, index, value, &found, &found_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_value;
+    }
+
+    /* let the caller know how much space the projection needs. */
+    if (*projection_size < found_size)
+    {
+        retval = VCDB_ERROR_WOULD_TRUNCATE;
+    }
+    else
+    {
+        memcpy(projection, found, found_size);
+    }
+
+    *projection_size = found_size;
+    vcdb_builder_memory_release(database->builder, found);
+
+cleanup_value:
+    vcdb_builder_memory_release(database->builder, value);
+
+    return retval;
+}
@@ -0,0 +1,140 @@
+/**
+ * \file vcdb_database_latency_get.c
+ *
+ * \brief Implementation of the vcdb_database_latency_get() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/database.h>
+#include <vpr/parameters.h>
+
+#include "../latency/latency_private.h"
+
+#if VCDB_LATENCY_SUPPORTED
+/* forward decls */
+static uint64_t vcdb_database_latency_percentile(
+    const uint64_t* buckets, uint64_t total, uint64_t per_mille, uint64_t max);
+#endif
+
+/**
+ * \brief Summarize the latency histogram of an engine method.
+ *
+ * Latency histograms are enabled with vcdb_builder_latency_histograms_enable().
+ * Datastore and index methods are recorded per correlation ID.  Transaction
+ * begins, commits, and rollbacks are recorded under correlation ID -1.  The
+ * summary covers calls since the database was created or opened.
+ *
+ * \param database      The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index, or -1
+ *                      for a transaction method.
+ * \param method        The engine method to summarize.
+ * \param latency       The summary to fill in.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if latency histograms are disabled.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the correlation ID or method is
+ *            out of range.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_latency_get(
+    vcdb_database_t* database,
+    int correlation_id,
+    vcdb_database_method_t method,
+    vcdb_database_latency_t* latency)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != latency);
+
+    /* parameter sanity check. */
+    if (NULL == database || NULL == latency)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* latency histograms must be enabled in the builder. */
+    if (NULL == database->latency)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+#if VCDB_LATENCY_SUPPORTED
+    vcdb_latency_histogram_t* h =
+        vcdb_latency_histogram_find(database->latency, correlation_id, method);
+    if (NULL == h)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* take a copy of the buckets, so percentiles agree with each other. */
+    uint64_t buckets[VCDB_LATENCY_BUCKETS];
+    uint64_t total = 0;
+    for (size_t i = 0; i < VCDB_LATENCY_BUCKETS; ++i)
+    {
+        buckets[i] =
+            atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+        total += buckets[i];
+    }
+
+    memset(latency, 0, sizeof(vcdb_database_latency_t));
+    if (0 == total)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    latency->count = total;
+    latency->max = atomic_load_explicit(&h->max, memory_order_relaxed);
+    latency->mean =
+        atomic_load_explicit(&h->sum, memory_order_relaxed) / total;
+    latency->p50 =
+        vcdb_database_latency_percentile(buckets, total, 500, latency->max);
+    latency->p99 =
+        vcdb_database_latency_percentile(buckets, total, 990, latency->max);
+    latency->p999 =
+        vcdb_database_latency_percentile(buckets, total, 999, latency->max);
+
+    return VCDB_STATUS_SUCCESS;
+#else
+    (void)correlation_id;
+    (void)method;
+
+    return VCDB_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+#if VCDB_LATENCY_SUPPORTED
+
+/**
+ * \brief Find a percentile in a copy of histogram buckets.
+ *
+ * \param buckets       The bucket counts.
+ * \param total         The sum of the bucket counts.
+ * \param per_mille     The percentile, in tenths of a percent.
+ * \param max           The largest recorded value.
+ *
+ * \returns the upper bound of the bucket holding the percentile, capped at
+ *          the largest recorded value.
+ */
+static uint64_t vcdb_database_latency_percentile(
+    const uint64_t* buckets, uint64_t total, uint64_t per_mille, uint64_t max)
+{
+    uint64_t rank = (total * per_mille + 999) / 1000;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < VCDB_LATENCY_BUCKETS - 1; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            uint64_t upper = vcdb_latency_bucket_lower(i + 1) - 1;
+
+            return upper < max ? upper : max;
+        }
+    }
+
+    return max;
+}
+#endif
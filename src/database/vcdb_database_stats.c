@@ -0,0 +1,104 @@
+/**
+ * \file vcdb_database_stats.c
+ *
+ * \brief Implementation of the vcdb_database_stats() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/database.h>
+#include <vpr/parameters.h>
+
+#include "../stats/stats_private.h"
+
+/* forward decls */
+static void vcdb_database_stats_dispose(void* disposable);
+
+/**
+ * \brief Take a snapshot of the operation counters of a database.
+ *
+ * Counters are kept per thread stripe, so updating them adds no contention.
+ * They are summed when the snapshot is taken, and count operations since the
+ * database was created or opened.  The counters of a datastore or index are
+ * at instances[correlation_id].  Counters must be enabled with
+ * vcdb_builder_stats_enable().
+ *
+ * \param database      The database instance to use.
+ * \param stats         The snapshot to initialize.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if operation counters are not enabled.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_stats(
+    vcdb_database_t* database,
+    vcdb_database_stats_t* stats)
+{
+    MODEL_ASSERT(NULL != database);
+    MODEL_ASSERT(NULL != stats);
+
+    /* parameter check */
+    if (NULL == database || NULL == stats)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* operation counters are optional. */
+    if (NULL == database->stats)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    vcdb_stats_t* s = database->stats;
+
+    memset(stats, 0, sizeof(vcdb_database_stats_t));
+    stats->instances = (vcdb_database_counters_t*)
+        calloc(s->instance_count + 1, sizeof(vcdb_database_counters_t));
+    if (NULL == stats->instances)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    stats->hdr.dispose = &vcdb_database_stats_dispose;
+    stats->instance_count = s->instance_count;
+    stats->commits = vcdb_stats_sum(s, -1, VCDB_STATS_COMMITS);
+    stats->rollbacks = vcdb_stats_sum(s, -1, VCDB_STATS_ROLLBACKS);
+
+    for (size_t i = 0; i < s->instance_count; ++i)
+    {
+        vcdb_database_counters_t* c = &stats->instances[i];
+        int id = (int)i;
+
+        c->gets = vcdb_stats_sum(s, id, VCDB_STATS_GETS);
+        c->hits = vcdb_stats_sum(s, id, VCDB_STATS_HITS);
+        c->misses = vcdb_stats_sum(s, id, VCDB_STATS_MISSES);
+        c->cache_hits = vcdb_stats_sum(s, id, VCDB_STATS_CACHE_HITS);
+        c->filter_rejects = vcdb_stats_sum(s, id, VCDB_STATS_FILTER_REJECTS);
+        c->puts = vcdb_stats_sum(s, id, VCDB_STATS_PUTS);
+        c->deletes = vcdb_stats_sum(s, id, VCDB_STATS_DELETES);
+        c->truncate_retries =
+            vcdb_stats_sum(s, id, VCDB_STATS_TRUNCATE_RETRIES);
+        c->bytes_serialized =
+            vcdb_stats_sum(s, id, VCDB_STATS_BYTES_SERIALIZED);
+        c->bytes_deserialized =
+            vcdb_stats_sum(s, id, VCDB_STATS_BYTES_DESERIALIZED);
+    }
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of a statistics snapshot.
+ *
+ * \param disposable        The snapshot to dispose.
+ */
+static void vcdb_database_stats_dispose(void* disposable)
+{
+    vcdb_database_stats_t* stats = (vcdb_database_stats_t*)disposable;
+
+    free(stats->instances);
+    memset(stats, 0, sizeof(vcdb_database_stats_t));
+}
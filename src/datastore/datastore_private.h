@@ -0,0 +1,169 @@
+/**
+ * \file datastore_private.h
+ *
+ * \brief Private details for datastore serialization buffers.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_DATASTORE_PRIVATE_HEADER_GUARD
+#define VCDB_DATASTORE_PRIVATE_HEADER_GUARD
+
+#include <stdint.h>
+#include <vcdb/builder.h>
+#include <vcdb/datastore.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The size of the stack buffer used to serialize values of datastores
+ * with a declared serial data size.
+ *
+ * Datastores whose declared serial data size fits in this buffer are read and
+ * written without touching the heap.
+ */
+#ifndef VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE
+#define VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE 256
+#endif
+
+/**
+ * \brief Keep a helper which holds a VCDB_MAX_KEY_SIZE key buffer out of its
+ * caller, so the caller's frame stays small when no key is copied.
+ */
+#if defined(__GNUC__)
+#define VCDB_DATASTORE_KEY_COPY_NOINLINE __attribute__((noinline))
+#else
+#define VCDB_DATASTORE_KEY_COPY_NOINLINE
+#endif
+
+/**
+ * \brief Get a buffer for serialized data of the given datastore.
+ *
+ * If the datastore uses identity serialization, the caller's value is the
+ * buffer.  If it declares a serial data size which fits in the stack buffer,
+ * the stack buffer is used.  If it declares a larger size, a heap buffer of
+ * exactly that size is allocated.  Otherwise, a heap buffer of the given
+ * default size is allocated.
+ *
+ * \param builder       The builder whose allocator is used.
+ * \param datastore     The datastore of the serialized data.
+ * \param value         The caller's value, which holds at least data_size
+ *                      bytes.
+ * \param stack_buffer  A buffer of VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE
+ *                      bytes owned by the caller.
+ * \param size          On entry, the default buffer size.  On exit, the size
+ *                      of the returned buffer.
+ *
+ * \returns the buffer, or NULL if it could not be allocated.
+ */
+static inline void* vcdb_datastore_serial_buffer_get(
+    vcdb_builder_t* builder, const vcdb_datastore_t* datastore, void* value,
+    uint8_t* stack_buffer, size_t* size)
+{
+    if (datastore->identity_serialization)
+    {
+        *size = datastore->data_size;
+        return value;
+    }
+
+    size_t declared = datastore->serial_data_size;
+    if (0 != declared)
+    {
+        *size = declared;
+        if (declared <= VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE)
+        {
+            return stack_buffer;
+        }
+    }
+
+    return vcdb_builder_memory_allocate(builder, *size);
+}
+
+/**
+ * \brief Grow a buffer returned by vcdb_datastore_serial_buffer_get().
+ *
+ * The contents of the buffer are not preserved when it moves off the stack or
+ * out of the caller's value, since the serialized data is always rewritten
+ * after growing.
+ *
+ * \param builder       The builder whose allocator is used.
+ * \param buffer        The buffer to grow.
+ * \param value         The caller's value.
+ * \param stack_buffer  The caller's stack buffer.
+ * \param old_size      The current size of the buffer.
+ * \param new_size      The new size of the buffer.
+ *
+ * \returns the grown buffer, or NULL on failure, in which case the original
+ * buffer is unchanged.
+ */
+static inline void* vcdb_datastore_serial_buffer_grow(
+    vcdb_builder_t* builder, void* buffer, const void* value,
+    const uint8_t* stack_buffer, size_t old_size, size_t new_size)
+{
+    if (buffer == value || buffer == stack_buffer)
+    {
+        return vcdb_builder_memory_allocate(builder, new_size);
+    }
+
+    return vcdb_builder_memory_reallocate(builder, buffer, old_size, new_size);
+}
+
+/**
+ * \brief Release a buffer returned by vcdb_datastore_serial_buffer_get().
+ *
+ * \param builder       The builder whose allocator is used.
+ * \param buffer        The buffer to release.
+ * \param value         The caller's value.
+ * \param stack_buffer  The caller's stack buffer.
+ */
+static inline void vcdb_datastore_serial_buffer_release(
+    vcdb_builder_t* builder, void* buffer, const void* value,
+    const uint8_t* stack_buffer)
+{
+    if (buffer != value && buffer != stack_buffer)
+    {
+        vcdb_builder_memory_release(builder, buffer);
+    }
+}
+
+/**
+ * \brief Read a value from a buffer returned by
+ * vcdb_datastore_serial_buffer_get().
+ *
+ * Identity serialized data was read straight into the caller's value, so only
+ * its size is checked.  Otherwise, the datastore's value reader is used.
+ *
+ * \param datastore     The datastore of the serialized data.
+ * \param buffer        The serialized data.
+ * \param size          The size of the serialized data.
+ * \param value         The caller's value.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_DATABASE_ENGINE if identity serialized data has the
+ *            wrong size.
+ *          - the value reader's failure code on failure.
+ */
+static inline int vcdb_datastore_serial_buffer_read(
+    const vcdb_datastore_t* datastore, const void* buffer, size_t size,
+    void* value)
+{
+    if (buffer == value)
+    {
+        return (size == datastore->data_size)
+            ? VCDB_STATUS_SUCCESS
+            : VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    return datastore->value_reader(buffer, size, value);
+}
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_DATASTORE_PRIVATE_HEADER_GUARD*/
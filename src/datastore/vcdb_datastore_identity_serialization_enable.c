@@ -0,0 +1,42 @@
+/**
+ * \file vcdb_datastore_identity_serialization_enable.c
+ *
+ * \brief Implementation of the vcdb_datastore_identity_serialization_enable()
+ * function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/datastore.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Declare that the values of a datastore are their own serialized form.
+ *
+ * This is meant for plain-old-data values.  The value reader and writer of the
+ * datastore are bypassed: a put hands the caller's value to the engine as the
+ * serialized data, and a get has the engine read the serialized data straight
+ * into the caller's value.  The serialized data is data_size bytes.  Engines
+ * can check identity_serialization to avoid further copies.
+ *
+ * \param datastore The datastore to update.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_identity_serialization_enable(
+    vcdb_datastore_t* datastore)
+{
+    MODEL_ASSERT(NULL != datastore);
+
+    if (NULL == datastore)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    datastore->identity_serialization = true;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file vcdb_datastore_key_reference_getter_set.c
+ *
+ * \brief Implementation of the vcdb_datastore_key_reference_getter_set()
+ * function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/datastore.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Set the key reference getter for a datastore.
+ *
+ * When a datastore has a key reference getter, the key of a value is used in
+ * place, so puts do not copy it into a key buffer.  Such keys are not limited
+ * to VCDB_MAX_KEY_SIZE bytes.  The key getter is still used by code which
+ * needs its own copy of the key.
+ *
+ * \param datastore The datastore to update.
+ * \param getter    The method used to get a reference to the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_key_reference_getter_set(
+    vcdb_datastore_t* datastore,
+    vcdb_datastore_key_reference_getter_method_t getter)
+{
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != getter);
+
+    if (NULL == datastore || NULL == getter)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    datastore->key_reference_getter = getter;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file vcdb_datastore_serial_data_size_set.c
+ *
+ * \brief Implementation of the vcdb_datastore_serial_data_size_set() function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/datastore.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Declare the maximum size of a serialized value of a datastore.
+ *
+ * Values of a datastore with a declared serial data size are serialized into
+ * a buffer of exactly this size.  If the size fits in the library's stack
+ * buffer, which is VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE bytes, then gets
+ * and puts against this datastore do not allocate at all.  A value which
+ * turns out to be larger is still handled, with a heap buffer.
+ *
+ * \param datastore The datastore to update.
+ * \param size      The maximum size of a serialized value.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_serial_data_size_set(
+    vcdb_datastore_t* datastore,
+    size_t size)
+{
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(0 != size);
+
+    if (NULL == datastore || 0 == size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    datastore->serial_data_size = size;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,41 @@
+/**
+ * \file vcdb_datastore_value_merger_set.c
+ *
+ * \brief Implementation of the vcdb_datastore_value_merger_set() function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/datastore.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Set the merge method for a datastore.
+ *
+ * A datastore must have a merge method before merge operands can be recorded
+ * against it with vcdb_database_datastore_merge().
+ *
+ * \param datastore The datastore to update.
+ * \param merger    The method used to fold merge operands into values.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_datastore_value_merger_set(
+    vcdb_datastore_t* datastore,
+    vcdb_datastore_value_merger_method_t merger)
+{
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != merger);
+
+    if (NULL == datastore || NULL == merger)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    datastore->value_merger = merger;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -16,34 +16,59 @@
 extern "C" {
 #endif  //__cplusplus
 
+#include <stdatomic.h>
 #include <stdlib.h>
 
+/**
+ * \brief The number of buckets in the internal database engine registry.
+ *
+ * This must be a power of two.
+ */
+#define VCDB_DATABASE_ENGINE_REGISTRY_BUCKETS 64
+
 /**
  * \brief Internal data structure used for maintaining database engine entries.
+ *
+ * Entries are immutable once they have been published to a bucket, and are
+ * never removed, so readers can walk a bucket chain without locking.
  */
 typedef struct vcdb_database_engine_entry
 {
     char* name;
     vcdb_database_engine_t* engine;
+    struct vcdb_database_engine_entry* next;
 } vcdb_database_engine_entry_t;
 
 /**
  * \brief The internal database engine registry.
  *
- * This array is used by vcdb_database_engine_lookup() and
- * vcdb_database_engine_register().
+ * This is a fixed-size hash table of singly linked bucket chains, keyed by
+ * engine name.  New entries are pushed onto the head of a chain with an atomic
+ * compare and swap, which lets vcdb_database_engine_lookup() run concurrently
+ * with vcdb_database_engine_register().
  */
-extern vcdb_database_engine_entry_t* vcdb_database_engine_registry;
+extern _Atomic(vcdb_database_engine_entry_t*)
+    vcdb_database_engine_registry[VCDB_DATABASE_ENGINE_REGISTRY_BUCKETS];
 
 /**
- * \brief The maximum size of the internal database engine registry.
+ * \brief Get the registry bucket for the given engine name.
+ *
+ * \param engine        The name of the database engine.
+ *
+ * \returns the bucket index for this name.
  */
-extern size_t vcdb_database_engine_registry_size_max;
+size_t vcdb_database_engine_registry_bucket(const char* engine);
 
 /**
- * \brief The number of entries in the internal database engine registry.
+ * \brief Find an entry in the given bucket chain by engine name.
+ *
+ * \param head          The head of the bucket chain to search.
+ * \param engine        The name of the database engine to find.
+ *
+ * \returns the matching entry, or NULL if the engine is not in this chain.
  */
-extern size_t vcdb_database_engine_registry_size;
+vcdb_database_engine_entry_t* vcdb_database_engine_registry_find(
+    vcdb_database_engine_entry_t* head, const char* engine);
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
@@ -18,7 +18,8 @@
  * the engine structure.
  *
  * This method is private to the database interface and the engine API, which is
- * used to register and look up database engine adapters.
+ * used to register and look up database engine adapters.  It is safe to call
+ * concurrently with vcdb_database_engine_register().
  *
  * \param engine        The name of the database engine looked up by this
  *                      method.
@@ -30,17 +31,23 @@ vcdb_database_engine_t*
 vcdb_database_engine_lookup(
     const char* engine)
 {
-    /* scan the registry for this engine */
-    for (size_t i = 0; i < vcdb_database_engine_registry_size; ++i)
+    MODEL_ASSERT(NULL != engine);
+
+    /* the acquire load pairs with the release in register, so the entry and
+     * everything it points to are visible once the head is seen. */
+    size_t bucket = vcdb_database_engine_registry_bucket(engine);
+    vcdb_database_engine_entry_t* head =
+        atomic_load_explicit(
+            &vcdb_database_engine_registry[bucket], memory_order_acquire);
+
+    /* scan the bucket for this engine */
+    vcdb_database_engine_entry_t* entry =
+        vcdb_database_engine_registry_find(head, engine);
+    if (NULL == entry)
     {
-        /* if the entry has been found... */
-        if (!strcmp(engine, vcdb_database_engine_registry[i].name))
-        {
-            /* ...return it. */
-            return vcdb_database_engine_registry[i].engine;
-        }
+        /* the engine was not found in the registry. */
+        return NULL;
     }
 
-    /* the engine was not found in the registry. */
-    return NULL;
+    return entry->engine;
 }
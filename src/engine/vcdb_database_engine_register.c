@@ -17,7 +17,9 @@
  * \brief This method registers a database engine with the given engine name.
  *
  * This method is private to the database interface and the engine API, which is
- * used to register and look up database engine adapters.
+ * used to register and look up database engine adapters.  It is safe to call
+ * concurrently with itself and with vcdb_database_engine_lookup().  If an
+ * engine is already registered under this name, the first registration wins.
  *
  * \param eng           The engine to register.
  * \param engine        The name of the database engine under which this engine
@@ -26,48 +28,57 @@
 void vcdb_database_engine_register(
     vcdb_database_engine_t* eng, const char* engine)
 {
-    /* allocate the registry if it does not already exist. */
-    if (vcdb_database_engine_registry_size_max == 0)
+    MODEL_ASSERT(NULL != eng);
+    MODEL_ASSERT(NULL != engine);
+
+    size_t bucket = vcdb_database_engine_registry_bucket(engine);
+    vcdb_database_engine_entry_t* head =
+        atomic_load_explicit(
+            &vcdb_database_engine_registry[bucket], memory_order_acquire);
+
+    /* don't allocate anything if this engine is already registered. */
+    if (NULL != vcdb_database_engine_registry_find(head, engine))
     {
-        vcdb_database_engine_registry_size_max = 5;
-        vcdb_database_engine_registry_size = 0;
-        vcdb_database_engine_registry = (vcdb_database_engine_entry_t*)
-            malloc(vcdb_database_engine_registry_size_max * sizeof(vcdb_database_engine_entry_t));
+        return;
     }
 
-    /* if the registry is NULL at this point, allocation failed. Clean up. */
-    if (NULL == vcdb_database_engine_registry)
+    /* allocate the new entry. */
+    vcdb_database_engine_entry_t* entry = (vcdb_database_engine_entry_t*)
+        malloc(sizeof(vcdb_database_engine_entry_t));
+    if (NULL == entry)
     {
-        vcdb_database_engine_registry_size_max = 0;
-        vcdb_database_engine_registry_size = 0;
+        return;
+    }
+
+    /* Set the new entry. */
+    entry->name = strdup(engine);
+    entry->engine = eng;
 
+    /* edge case - strdup() fails.  Clean up the entry. */
+    if (NULL == entry->name)
+    {
+        free(entry);
         return;
     }
 
-    /* if we can't register entries, increase the registry size. */
-    if (vcdb_database_engine_registry_size == vcdb_database_engine_registry_size_max)
+    /* publish the entry at the head of the bucket. */
+    for (;;)
     {
-        /* grow the array.  Return on failure. */
-        void* newdata = realloc(vcdb_database_engine_registry,
-            vcdb_database_engine_registry_size_max + 5);
-        if (NULL == newdata)
+        entry->next = head;
+        if (atomic_compare_exchange_weak_explicit(
+                &vcdb_database_engine_registry[bucket], &head, entry,
+                memory_order_release, memory_order_acquire))
         {
             return;
         }
 
-        /* on success, switch out the array and increase the max size */
-        vcdb_database_engine_registry = (vcdb_database_engine_entry_t*)newdata;
-        vcdb_database_engine_registry_size_max += 5;
-    }
-
-    /* Set the new entry. */
-    size_t offset = vcdb_database_engine_registry_size++;
-    vcdb_database_engine_registry[offset].name = strdup(engine);
-    vcdb_database_engine_registry[offset].engine = eng;
-
-    /* edge case - strdup() fails.  Clean up by decrementing size. */
-    if (NULL == vcdb_database_engine_registry[offset].name)
-    {
-        --vcdb_database_engine_registry_size;
+        /* the head moved.  If another thread registered this name first, it
+         * wins. */
+        if (NULL != vcdb_database_engine_registry_find(head, engine))
+        {
+            free(entry->name);
+            free(entry);
+            return;
+        }
     }
 }
@@ -1,13 +1,57 @@
 /**
  * \file vcdb_database_engine_registry.c
  *
- * \brief Global data for the database engine registry.
+ * \brief Global data and helpers for the database engine registry.
  *
  * \copyright 2018 Velo Payments, Inc.  All rights reserved.
  */
 
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "../hash/hash_private.h"
 #include "vcdb_database_engine.h"
 
-vcdb_database_engine_entry_t* vcdb_database_engine_registry = NULL;
-size_t vcdb_database_engine_registry_size_max = 0U;
-size_t vcdb_database_engine_registry_size = 0U;
+_Atomic(vcdb_database_engine_entry_t*)
+    vcdb_database_engine_registry[VCDB_DATABASE_ENGINE_REGISTRY_BUCKETS];
+
+/**
+ * \brief Get the registry bucket for the given engine name.
+ *
+ * \param engine        The name of the database engine.
+ *
+ * \returns the bucket index for this name.
+ */
+size_t vcdb_database_engine_registry_bucket(const char* engine)
+{
+    MODEL_ASSERT(NULL != engine);
+
+    return (size_t)vcdb_hash_fnv1a(engine, strlen(engine))
+         & (VCDB_DATABASE_ENGINE_REGISTRY_BUCKETS - 1);
+}
+
+/**
+ * \brief Find an entry in the given bucket chain by engine name.
+ *
+ * \param head          The head of the bucket chain to search.
+ * \param engine        The name of the database engine to find.
+ *
+ * \returns the matching entry, or NULL if the engine is not in this chain.
+ */
+vcdb_database_engine_entry_t* vcdb_database_engine_registry_find(
+    vcdb_database_engine_entry_t* head, const char* engine)
+{
+    MODEL_ASSERT(NULL != engine);
+
+    /* scan the chain for this engine. */
+    for (vcdb_database_engine_entry_t* i = head; NULL != i; i = i->next)
+    {
+        if (!strcmp(engine, i->name))
+        {
+            return i;
+        }
+    }
+
+    /* the engine was not found in this chain. */
+    return NULL;
+}
@@ -0,0 +1,161 @@
+/**
+ * \file filter_private.h
+ *
+ * \brief Private details for the negative-lookup filter.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_FILTER_PRIVATE_HEADER_GUARD
+#define VCDB_FILTER_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vcdb/builder.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The size of a filter block in bytes.  One block is one cache line.
+ */
+#define VCDB_FILTER_BLOCK_SIZE 64
+
+/**
+ * \brief The number of 32-bit words in a filter block.
+ *
+ * Words are 32 bits wide so that setting a bit is a lock free atomic operation
+ * on targets without 64-bit atomics, such as Cortex-M4.
+ */
+#define VCDB_FILTER_BLOCK_WORDS (VCDB_FILTER_BLOCK_SIZE / 4)
+
+/**
+ * \brief The number of filter bits to reserve for each expected key.
+ */
+#define VCDB_FILTER_BITS_PER_KEY 10
+
+/**
+ * \brief The number of bits set in a block for each key.
+ */
+#define VCDB_FILTER_PROBES 7
+
+/**
+ * \brief A blocked bloom filter.
+ *
+ * Each key hashes to a single block, and sets VCDB_FILTER_PROBES bits within
+ * it, so a lookup touches one cache line.  Bits are set with relaxed atomic
+ * operations, so keys can be added while other threads query the filter.  The
+ * filter can report false positives but never false negatives.  Keys can't be
+ * removed, so deleted keys remain as false positives.
+ */
+typedef struct vcdb_filter
+{
+    vcdb_builder_t* builder;
+    size_t block_count;
+    _Atomic uint32_t* blocks;
+    void* blocks_memory;
+    atomic_bool saturated;
+} vcdb_filter_t;
+
+/**
+ * \brief Get the first word of the block for a key hash.
+ *
+ * \param filter        The filter.
+ * \param hash          The key hash.
+ *
+ * \returns a pointer to the first word of the key's block.
+ */
+static inline _Atomic uint32_t* vcdb_filter_block(
+    vcdb_filter_t* filter, uint64_t hash)
+{
+    /* map the top 32 bits of the hash onto the block range. */
+    size_t block = (size_t)(((hash >> 32) * filter->block_count) >> 32);
+
+    return filter->blocks + block * VCDB_FILTER_BLOCK_WORDS;
+}
+
+/**
+ * \brief Get the probe bits within a block for a key hash.
+ *
+ * The hash is remixed so the probes are independent of the block choice.
+ *
+ * \param hash          The key hash.
+ *
+ * \returns a word containing VCDB_FILTER_PROBES 9-bit probe offsets.
+ */
+static inline uint64_t vcdb_filter_probes(uint64_t hash)
+{
+    hash ^= hash >> 31;
+    hash *= 0x7fb5d329728ea185ULL;
+    hash ^= hash >> 27;
+    hash *= 0x81dadef4bc2dd44dULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/**
+ * \brief Create a filter sized for the given number of keys.
+ *
+ * \param filter        Pointer to receive the filter on success.
+ * \param builder       The builder whose allocator is used.
+ * \param expected_keys The number of keys expected in the filter.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_filter_create(
+    vcdb_filter_t** filter, vcdb_builder_t* builder, size_t expected_keys);
+
+/**
+ * \brief Release a filter.
+ *
+ * \param filter        The filter to release.
+ */
+void vcdb_filter_release(
+    vcdb_filter_t* filter);
+
+/**
+ * \brief Add a key to a filter.
+ *
+ * \param filter        The filter to update.
+ * \param key           The key to add.
+ * \param key_size      The size of the key.
+ */
+void vcdb_filter_add(
+    vcdb_filter_t* filter, const void* key, size_t key_size);
+
+/**
+ * \brief Saturate a filter, so that it reports every key as present.
+ *
+ * This is used when keys are written which the library can't see.
+ *
+ * \param filter        The filter to saturate.
+ */
+void vcdb_filter_saturate(
+    vcdb_filter_t* filter);
+
+/**
+ * \brief Check whether a key may be in a filter.
+ *
+ * \param filter        The filter to query.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns false if the key is definitely not in the filter, or true if it may
+ * be.
+ */
+bool vcdb_filter_maybe_contains(
+    vcdb_filter_t* filter, const void* key, size_t key_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_FILTER_PRIVATE_HEADER_GUARD*/
@@ -0,0 +1,38 @@
+/**
+ * \file vcdb_filter_add.c
+ *
+ * \brief Implementation of the vcdb_filter_add() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "../hash/hash_private.h"
+#include "filter_private.h"
+
+/**
+ * \brief Add a key to a filter.
+ *
+ * \param filter        The filter to update.
+ * \param key           The key to add.
+ * \param key_size      The size of the key.
+ */
+void vcdb_filter_add(
+    vcdb_filter_t* filter, const void* key, size_t key_size)
+{
+    MODEL_ASSERT(NULL != filter);
+    MODEL_ASSERT(NULL != key);
+
+    uint64_t hash = vcdb_hash_fnv1a(key, key_size);
+    _Atomic uint32_t* block = vcdb_filter_block(filter, hash);
+    uint64_t probes = vcdb_filter_probes(hash);
+
+    for (int i = 0; i < VCDB_FILTER_PROBES; ++i, probes >>= 9)
+    {
+        unsigned bit = (unsigned)(probes & 0x1ff);
+
+        atomic_fetch_or_explicit(
+            &block[bit >> 5], 1UL << (bit & 31), memory_order_relaxed);
+    }
+}
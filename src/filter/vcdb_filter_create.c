@@ -0,0 +1,76 @@
+/**
+ * \file vcdb_filter_create.c
+ *
+ * \brief Implementation of the vcdb_filter_create() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/error_codes.h>
+
+#include "filter_private.h"
+
+/**
+ * \brief Create a filter sized for the given number of keys.
+ *
+ * \param filter        Pointer to receive the filter on success.
+ * \param builder       The builder whose allocator is used.
+ * \param expected_keys The number of keys expected in the filter.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_filter_create(
+    vcdb_filter_t** filter, vcdb_builder_t* builder, size_t expected_keys)
+{
+    MODEL_ASSERT(NULL != filter);
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(0 != expected_keys);
+
+    /* parameter sanity check. */
+    if (NULL == filter || NULL == builder || 0 == expected_keys)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_filter_t* f = (vcdb_filter_t*)
+        vcdb_builder_memory_allocate(builder, sizeof(vcdb_filter_t));
+    if (NULL == f)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    f->builder = builder;
+
+    /* round the bit count up to whole blocks. */
+    size_t bits_per_block = VCDB_FILTER_BLOCK_SIZE * 8;
+    f->block_count =
+        (expected_keys * VCDB_FILTER_BITS_PER_KEY + bits_per_block - 1)
+            / bits_per_block;
+
+    /* align the blocks to cache lines.  The allocator makes no alignment
+     * promise beyond malloc's, so over-allocate by one block. */
+    size_t size = f->block_count * VCDB_FILTER_BLOCK_SIZE;
+    f->blocks_memory =
+        vcdb_builder_memory_allocate(builder, size + VCDB_FILTER_BLOCK_SIZE);
+    if (NULL == f->blocks_memory)
+    {
+        vcdb_builder_memory_release(builder, f);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    f->blocks = (_Atomic uint32_t*)
+        (((uintptr_t)f->blocks_memory + VCDB_FILTER_BLOCK_SIZE - 1)
+            & ~(uintptr_t)(VCDB_FILTER_BLOCK_SIZE - 1));
+
+    memset((void*)f->blocks, 0, size);
+    atomic_init(&f->saturated, false);
+
+    *filter = f;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file vcdb_filter_maybe_contains.c
+ *
+ * \brief Implementation of the vcdb_filter_maybe_contains() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "../hash/hash_private.h"
+#include "filter_private.h"
+
+/**
+ * \brief Check whether a key may be in a filter.
+ *
+ * \param filter        The filter to query.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns false if the key is definitely not in the filter, or true if it may
+ * be.
+ */
+bool vcdb_filter_maybe_contains(
+    vcdb_filter_t* filter, const void* key, size_t key_size)
+{
+    MODEL_ASSERT(NULL != filter);
+    MODEL_ASSERT(NULL != key);
+
+    if (atomic_load_explicit(&filter->saturated, memory_order_relaxed))
+    {
+        return true;
+    }
+
+    uint64_t hash = vcdb_hash_fnv1a(key, key_size);
+    _Atomic uint32_t* block = vcdb_filter_block(filter, hash);
+    uint64_t probes = vcdb_filter_probes(hash);
+
+    for (int i = 0; i < VCDB_FILTER_PROBES; ++i, probes >>= 9)
+    {
+        unsigned bit = (unsigned)(probes & 0x1ff);
+
+        uint32_t word =
+            atomic_load_explicit(&block[bit >> 5], memory_order_relaxed);
+        if (!(word & (1UL << (bit & 31))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
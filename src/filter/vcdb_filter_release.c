@@ -0,0 +1,27 @@
+/**
+ * \file vcdb_filter_release.c
+ *
+ * \brief Implementation of the vcdb_filter_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "filter_private.h"
+
+/**
+ * \brief Release a filter.
+ *
+ * \param filter        The filter to release.
+ */
+void vcdb_filter_release(
+    vcdb_filter_t* filter)
+{
+    MODEL_ASSERT(NULL != filter);
+
+    vcdb_builder_t* builder = filter->builder;
+
+    vcdb_builder_memory_release(builder, filter->blocks_memory);
+    vcdb_builder_memory_release(builder, filter);
+}
@@ -0,0 +1,26 @@
+/**
+ * \file vcdb_filter_saturate.c
+ *
+ * \brief Implementation of the vcdb_filter_saturate() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "filter_private.h"
+
+/**
+ * \brief Saturate a filter, so that it reports every key as present.
+ *
+ * This is used when keys are written which the library can't see.
+ *
+ * \param filter        The filter to saturate.
+ */
+void vcdb_filter_saturate(
+    vcdb_filter_t* filter)
+{
+    MODEL_ASSERT(NULL != filter);
+
+    atomic_store_explicit(&filter->saturated, true, memory_order_relaxed);
+}
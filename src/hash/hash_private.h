@@ -0,0 +1,35 @@
+/**
+ * \file hash_private.h
+ *
+ * \brief Private hash function shared by the registry and schema lookups.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_HASH_PRIVATE_HEADER_GUARD
+#define VCDB_HASH_PRIVATE_HEADER_GUARD
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief Compute the 64-bit FNV-1a hash of the given data.
+ *
+ * \param data          The data to hash.
+ * \param size          The size of the data to hash.
+ *
+ * \returns the hash of the data.
+ */
+uint64_t vcdb_hash_fnv1a(const void* data, size_t size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_HASH_PRIVATE_HEADER_GUARD*/
@@ -0,0 +1,46 @@
+/**
+ * \file vcdb_hash_fnv1a.c
+ *
+ * \brief Implementation of the vcdb_hash_fnv1a() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "hash_private.h"
+
+/**
+ * \brief The 64-bit FNV offset basis.
+ */
+#define FNV1A_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/**
+ * \brief The 64-bit FNV prime.
+ */
+#define FNV1A_PRIME 0x100000001b3ULL
+
+/**
+ * \brief Compute the 64-bit FNV-1a hash of the given data.
+ *
+ * \param data          The data to hash.
+ * \param size          The size of the data to hash.
+ *
+ * \returns the hash of the data.
+ */
+uint64_t vcdb_hash_fnv1a(const void* data, size_t size)
+{
+    MODEL_ASSERT(NULL != data || 0 == size);
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint64_t hash = FNV1A_OFFSET_BASIS;
+
+    /* fold in each byte. */
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV1A_PRIME;
+    }
+
+    return hash;
+}
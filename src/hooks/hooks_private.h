@@ -0,0 +1,89 @@
+/**
+ * \file hooks_private.h
+ *
+ * \brief Private details for the entry point hooks.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_HOOKS_PRIVATE_HEADER_GUARD
+#define VCDB_HOOKS_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <vcdb/hooks.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The registered hooks, or NULL.
+ */
+extern _Atomic(vcdb_hooks_t*) vcdb_hooks_registered;
+
+/**
+ * \brief Get the registered hooks.
+ *
+ * Entry points read the hooks once, and use the same hooks for both
+ * callbacks.
+ *
+ * \returns the registered hooks, or NULL if none are registered.
+ */
+static inline vcdb_hooks_t* vcdb_hooks_get(void)
+{
+    return atomic_load_explicit(&vcdb_hooks_registered, memory_order_acquire);
+}
+
+/**
+ * \brief Set up the event for a call and run the begin callback.
+ *
+ * \param hooks         The registered hooks.
+ * \param event         The event to set up.
+ * \param entry_point   The entry point which was called.
+ * \param name          The name of the datastore or index, or NULL.
+ * \param key_size      The size of the key, or 0.
+ * \param value_size    The size of the value, or 0.
+ */
+static inline void vcdb_hooks_begin(
+    vcdb_hooks_t* hooks, vcdb_hook_event_t* event,
+    vcdb_hook_entry_point_t entry_point, const char* name, size_t key_size,
+    size_t value_size)
+{
+    event->entry_point = entry_point;
+    event->name = name;
+    event->key_size = key_size;
+    event->value_size = value_size;
+    event->status = 0;
+    event->user_data = 0;
+
+    if (NULL != hooks->begin)
+    {
+        hooks->begin(hooks->context, event);
+    }
+}
+
+/**
+ * \brief Run the end callback for a call.
+ *
+ * \param hooks         The hooks used to begin the call.
+ * \param event         The event for the call.
+ * \param status        The status code returned by the call.
+ */
+static inline void vcdb_hooks_end(
+    vcdb_hooks_t* hooks, vcdb_hook_event_t* event, int status)
+{
+    event->status = status;
+
+    if (NULL != hooks->end)
+    {
+        hooks->end(hooks->context, event);
+    }
+}
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_HOOKS_PRIVATE_HEADER_GUARD*/
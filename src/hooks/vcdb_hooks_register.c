@@ -0,0 +1,26 @@
+/**
+ * \file vcdb_hooks_register.c
+ *
+ * \brief Implementation of the vcdb_hooks_register() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "hooks_private.h"
+
+/**
+ * \brief Register hooks for every public entry point.
+ *
+ * The hooks replace any which were registered before.  They are owned by the
+ * caller, and must stay in scope while they are registered and until calls
+ * which were running when they were replaced have returned.  It is safe to
+ * call this method concurrently with the rest of the library.
+ *
+ * \param hooks         The hooks to register, or NULL to remove them.
+ */
+void vcdb_hooks_register(
+    vcdb_hooks_t* hooks)
+{
+    /* the release pairs with the acquire in vcdb_hooks_get(). */
+    atomic_store_explicit(&vcdb_hooks_registered, hooks, memory_order_release);
+}
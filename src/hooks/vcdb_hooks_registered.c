@@ -0,0 +1,14 @@
+/**
+ * \file vcdb_hooks_registered.c
+ *
+ * \brief Global data for the entry point hooks.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "hooks_private.h"
+
+/**
+ * \brief The registered hooks, or NULL.
+ */
+_Atomic(vcdb_hooks_t*) vcdb_hooks_registered = NULL;
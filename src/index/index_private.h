@@ -0,0 +1,49 @@
+/**
+ * \file index_private.h
+ *
+ * \brief Private details for the index interface.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_INDEX_PRIVATE_HEADER_GUARD
+#define VCDB_INDEX_PRIVATE_HEADER_GUARD
+
+#include <vcdb/builder.h>
+#include <vcdb/index.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/* set a sane default for allocation. */
+#ifndef VCDB_INDEX_PROJECTION_DEFAULT_SERIALIZATION_BUFFER_SIZE
+#define VCDB_INDEX_PROJECTION_DEFAULT_SERIALIZATION_BUFFER_SIZE 128
+#endif
+
+/**
+ * \brief Write the projection of a value into a newly allocated buffer.
+ *
+ * \param builder           The builder whose allocator is used.
+ * \param index             The covering index.
+ * \param value             The value to project.
+ * \param projection        Pointer to receive the projection buffer, which is
+ *                          owned by the caller and must be released
+ *                          with vcdb_builder_memory_release().
+ * \param projection_size   Pointer to receive the size of the projection.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_index_projection_write(
+    vcdb_builder_t* builder, vcdb_index_t* index, const void* value,
+    void** projection, size_t* projection_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_INDEX_PRIVATE_HEADER_GUARD*/
@@ -0,0 +1,42 @@
+/**
+ * \file vcdb_index_predicate_set.c
+ *
+ * \brief Implementation of the vcdb_index_predicate_set() function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/index.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Set the predicate for a partial secondary index.
+ *
+ * Only values for which the predicate returns true have entries in the index,
+ * so the index scales with the matching subset of its datastore.  Values which
+ * don't match can't be found through the index.
+ *
+ * \param index     The index to update.
+ * \param predicate The method deciding whether a value is indexed.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_index_predicate_set(
+    vcdb_index_t* index,
+    vcdb_index_predicate_method_t predicate)
+{
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(NULL != predicate);
+
+    if (NULL == index || NULL == predicate)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    index->predicate = predicate;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**
+ * \file vcdb_index_projection_write.c
+ *
+ * \brief Implementation of the vcdb_index_projection_write() function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "index_private.h"
+
+/**
+ * \brief Write the projection of a value into a newly allocated buffer.
+ *
+ * \param builder           The builder whose allocator is used.
+ * \param index             The covering index.
+ * \param value             The value to project.
+ * \param projection        Pointer to receive the projection buffer, which is
+ *                          owned by the caller and must be released
+ *                          with vcdb_builder_memory_release().
+ * \param projection_size   Pointer to receive the size of the projection.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_index_projection_write(
+    vcdb_builder_t* builder, vcdb_index_t* index, const void* value,
+    void** projection, size_t* projection_size)
+{
+    int retval;
+
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(NULL != index->projection_writer);
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != projection);
+    MODEL_ASSERT(NULL != projection_size);
+
+    /* allocate a sane default serialization buffer. */
+    size_t allocation_size =
+        VCDB_INDEX_PROJECTION_DEFAULT_SERIALIZATION_BUFFER_SIZE;
+    void* buffer = vcdb_builder_memory_allocate(builder, allocation_size);
+    if (NULL == buffer)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    /* serialize the projection. */
+    retval = index->projection_writer(value, buffer, &allocation_size);
+    if (VCDB_ERROR_WOULD_TRUNCATE == retval)
+    {
+        /* reallocate a larger buffer. */
+        void* newbuf = vcdb_builder_memory_reallocate(
+            builder, buffer,
+            VCDB_INDEX_PROJECTION_DEFAULT_SERIALIZATION_BUFFER_SIZE,
+            allocation_size);
+        if (NULL == newbuf)
+        {
+            retval = VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+            goto cleanup_buffer;
+        }
+
+        buffer = newbuf;
+
+        /* attempt serialization with the larger buffer. */
+        retval = index->projection_writer(value, buffer, &allocation_size);
+    }
+
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_buffer;
+    }
+
+    *projection = buffer;
+    *projection_size = allocation_size;
+
+    return VCDB_STATUS_SUCCESS;
+
+cleanup_buffer:
+    vcdb_builder_memory_release(builder, buffer);
+
+    return retval;
+}
@@ -0,0 +1,42 @@
+/**
+ * \file vcdb_index_projection_writer_set.c
+ *
+ * \brief Implementation of the vcdb_index_projection_writer_set() function.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/index.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Set the projection writer for a secondary index.
+ *
+ * This makes the index a covering index.  Each value put into the datastore is
+ * projected with this method, and the projection is stored with its index
+ * entry, so it can be read with vcdb_database_index_get_projection().
+ *
+ * \param index     The index to update.
+ * \param writer    The method used to write projections.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_index_projection_writer_set(
+    vcdb_index_t* index,
+    vcdb_index_projection_writer_method_t writer)
+{
+    MODEL_ASSERT(NULL != index);
+    MODEL_ASSERT(NULL != writer);
+
+    if (NULL == index || NULL == writer)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    index->projection_writer = writer;
+
+    return VCDB_STATUS_SUCCESS;
+}
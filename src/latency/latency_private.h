@@ -0,0 +1,209 @@
+/**
+ * \file latency_private.h
+ *
+ * \brief Private details for the engine method latency histograms.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_LATENCY_PRIVATE_HEADER_GUARD
+#define VCDB_LATENCY_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief Set to 1 when the target has lock free 64-bit atomics.
+ *
+ * Latency histograms are only built for such targets, so that targets such as
+ * Cortex-M4 never need libatomic.
+ */
+#if 2 == ATOMIC_LLONG_LOCK_FREE
+#define VCDB_LATENCY_SUPPORTED 1
+#else
+#define VCDB_LATENCY_SUPPORTED 0
+#endif
+
+/**
+ * \brief The number of sub-buckets per power of two is 1 << this value.
+ *
+ * With four sub-buckets, each bucket is at most a quarter of its lower bound
+ * wide, so a reported percentile is within 25% of the recorded value.
+ */
+#define VCDB_LATENCY_SUB_BUCKET_BITS 2
+
+/**
+ * \brief The number of buckets in a histogram, enough for any 64-bit value.
+ */
+#define VCDB_LATENCY_BUCKETS 256
+
+/**
+ * \brief A log-bucketed latency histogram.
+ */
+typedef struct vcdb_latency_histogram
+{
+    _Atomic uint64_t count;
+    _Atomic uint64_t sum;
+    _Atomic uint64_t max;
+    _Atomic uint64_t buckets[VCDB_LATENCY_BUCKETS];
+} vcdb_latency_histogram_t;
+
+/**
+ * \brief Latency histograms for a database.
+ *
+ * Histograms are laid out as [instance][method].  The instance is a
+ * correlation ID, and the instance at instance_count holds the database-wide
+ * transaction methods.
+ */
+typedef struct vcdb_latency
+{
+    vcdb_builder_t* builder;
+    vcdb_builder_clock_method_t clock;
+    size_t instance_count;
+    vcdb_latency_histogram_t* histograms;
+} vcdb_latency_t;
+
+/**
+ * \brief Read the monotonic clock.
+ *
+ * This is the default clock for latency histograms.
+ *
+ * \returns the monotonic clock, in nanoseconds.
+ */
+uint64_t vcdb_latency_clock_monotonic(void);
+
+/**
+ * \brief Get the bucket for a value.
+ *
+ * Values below the sub-bucket count have their own bucket.  Larger values are
+ * bucketed by their most significant bit and the bits just below it.
+ *
+ * \param value         The value to bucket.
+ *
+ * \returns the bucket index.
+ */
+static inline size_t vcdb_latency_bucket(uint64_t value)
+{
+    const uint64_t sub_buckets = 1U << VCDB_LATENCY_SUB_BUCKET_BITS;
+
+    if (value < sub_buckets)
+    {
+        return (size_t)value;
+    }
+
+    size_t msb = 63 - (size_t)__builtin_clzll(value);
+    size_t shift = msb - VCDB_LATENCY_SUB_BUCKET_BITS;
+
+    return (msb - VCDB_LATENCY_SUB_BUCKET_BITS + 1) * sub_buckets
+         + (size_t)((value >> shift) & (sub_buckets - 1));
+}
+
+/**
+ * \brief Get the smallest value which falls in a bucket.
+ *
+ * \param bucket        The bucket index.
+ *
+ * \returns the lower bound of this bucket.
+ */
+static inline uint64_t vcdb_latency_bucket_lower(size_t bucket)
+{
+    const size_t sub_buckets = 1U << VCDB_LATENCY_SUB_BUCKET_BITS;
+
+    if (bucket < sub_buckets)
+    {
+        return (uint64_t)bucket;
+    }
+
+    size_t shift = bucket / sub_buckets - 1;
+
+    return (uint64_t)(sub_buckets + bucket % sub_buckets) << shift;
+}
+
+/**
+ * \brief Start timing an engine method.
+ *
+ * \param latency       The latency histograms, or NULL if disabled.
+ *
+ * \returns the start time, or 0 if latency histograms are disabled.
+ */
+static inline uint64_t vcdb_latency_start(vcdb_latency_t* latency)
+{
+    if (NULL == latency)
+    {
+        return 0;
+    }
+
+    return latency->clock();
+}
+
+/**
+ * \brief Record the latency of an engine method.
+ *
+ * \param latency       The latency histograms, or NULL to do nothing.
+ * \param instance      The correlation ID, or -1 for a database-wide method.
+ * \param method        The engine method which was timed.
+ * \param start         The start time returned by vcdb_latency_start().
+ */
+void vcdb_latency_record(
+    vcdb_latency_t* latency, int instance, vcdb_database_method_t method,
+    uint64_t start);
+
+/**
+ * \brief Get the histogram for an instance and method.
+ *
+ * \param latency       The latency histograms.
+ * \param instance      The correlation ID, or -1 for a database-wide method.
+ * \param method        The engine method.
+ *
+ * \returns the histogram, or NULL if the instance is out of range.
+ */
+static inline vcdb_latency_histogram_t* vcdb_latency_histogram_find(
+    vcdb_latency_t* latency, int instance, vcdb_database_method_t method)
+{
+    size_t slot = instance < 0 ? latency->instance_count : (size_t)instance;
+    if (slot > latency->instance_count
+     || (unsigned)method >= VCDB_DATABASE_METHOD_COUNT)
+    {
+        return NULL;
+    }
+
+    return &latency->histograms[slot * VCDB_DATABASE_METHOD_COUNT + method];
+}
+
+/**
+ * \brief Create the latency histograms for a database.
+ *
+ * \param latency       Pointer to receive the histograms on success.  It is
+ *                      set to NULL if the builder does not enable latency
+ *                      histograms.
+ * \param builder       The builder describing the database.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_latency_create(
+    vcdb_latency_t** latency, vcdb_builder_t* builder);
+
+/**
+ * \brief Release the latency histograms for a database.
+ *
+ * \param latency       The histograms to release, or NULL.
+ */
+void vcdb_latency_release(
+    vcdb_latency_t* latency);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_LATENCY_PRIVATE_HEADER_GUARD*/
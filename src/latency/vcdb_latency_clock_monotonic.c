@@ -0,0 +1,27 @@
+/**
+ * \file vcdb_latency_clock_monotonic.c
+ *
+ * \brief Implementation of the vcdb_latency_clock_monotonic() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <time.h>
+
+#include "latency_private.h"
+
+/**
+ * \brief Read the monotonic clock.
+ *
+ * This is the default clock for latency histograms.
+ *
+ * \returns the monotonic clock, in nanoseconds.
+ */
+uint64_t vcdb_latency_clock_monotonic(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
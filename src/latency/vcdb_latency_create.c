@@ -0,0 +1,73 @@
+/**
+ * \file vcdb_latency_create.c
+ *
+ * \brief Implementation of the vcdb_latency_create() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/error_codes.h>
+
+#include "latency_private.h"
+
+/**
+ * \brief Create the latency histograms for a database.
+ *
+ * \param latency       Pointer to receive the histograms on success.  It is
+ *                      set to NULL if the builder does not enable latency
+ *                      histograms.
+ * \param builder       The builder describing the database.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_latency_create(
+    vcdb_latency_t** latency, vcdb_builder_t* builder)
+{
+    MODEL_ASSERT(NULL != latency);
+    MODEL_ASSERT(NULL != builder);
+
+    /* parameter sanity check. */
+    if (NULL == latency || NULL == builder)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* latency histograms are only kept when enabled. */
+    *latency = NULL;
+    if (NULL == builder->latency_clock)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    vcdb_latency_t* l = (vcdb_latency_t*)
+        vcdb_builder_memory_allocate(builder, sizeof(vcdb_latency_t));
+    if (NULL == l)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    /* one extra slot holds the database-wide transaction methods. */
+    size_t size = (builder->instance_array_size + 1)
+        * VCDB_DATABASE_METHOD_COUNT * sizeof(vcdb_latency_histogram_t);
+    l->builder = builder;
+    l->clock = builder->latency_clock;
+    l->instance_count = builder->instance_array_size;
+    l->histograms = (vcdb_latency_histogram_t*)
+        vcdb_builder_memory_allocate(builder, size);
+    if (NULL == l->histograms)
+    {
+        vcdb_builder_memory_release(builder, l);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memset(l->histograms, 0, size);
+
+    *latency = l;
+
+    return VCDB_STATUS_SUCCESS;
+}
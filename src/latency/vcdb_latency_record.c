@@ -0,0 +1,60 @@
+/**
+ * \file vcdb_latency_record.c
+ *
+ * \brief Implementation of the vcdb_latency_record() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "latency_private.h"
+
+/**
+ * \brief Record the latency of an engine method.
+ *
+ * \param latency       The latency histograms, or NULL to do nothing.
+ * \param instance      The correlation ID, or -1 for a database-wide method.
+ * \param method        The engine method which was timed.
+ * \param start         The start time returned by vcdb_latency_start().
+ */
+void vcdb_latency_record(
+    vcdb_latency_t* latency, int instance, vcdb_database_method_t method,
+    uint64_t start)
+{
+    /* latency histograms are optional. */
+    if (NULL == latency)
+    {
+        return;
+    }
+
+#if VCDB_LATENCY_SUPPORTED
+    vcdb_latency_histogram_t* h =
+        vcdb_latency_histogram_find(latency, instance, method);
+    if (NULL == h)
+    {
+        return;
+    }
+
+    /* a clock which steps backwards records a zero latency. */
+    uint64_t now = latency->clock();
+    uint64_t elapsed = now > start ? now - start : 0;
+
+    atomic_fetch_add_explicit(
+        &h->buckets[vcdb_latency_bucket(elapsed)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->sum, elapsed, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->count, 1, memory_order_relaxed);
+
+    uint64_t max = atomic_load_explicit(&h->max, memory_order_relaxed);
+    while (elapsed > max
+        && !atomic_compare_exchange_weak_explicit(
+                &h->max, &max, elapsed,
+                memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+#else
+    (void)instance;
+    (void)method;
+    (void)start;
+#endif
+}
@@ -0,0 +1,29 @@
+/**
+ * \file vcdb_latency_release.c
+ *
+ * \brief Implementation of the vcdb_latency_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "latency_private.h"
+
+/**
+ * \brief Release the latency histograms for a database.
+ *
+ * \param latency       The histograms to release, or NULL.
+ */
+void vcdb_latency_release(
+    vcdb_latency_t* latency)
+{
+    /* latency histograms are optional. */
+    if (NULL == latency)
+    {
+        return;
+    }
+
+    vcdb_builder_memory_release(latency->builder, latency->histograms);
+    vcdb_builder_memory_release(latency->builder, latency);
+}
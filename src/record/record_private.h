@@ -0,0 +1,320 @@
+/**
+ * \file record_private.h
+ *
+ * \brief Private details for the record engine.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_RECORD_PRIVATE_HEADER_GUARD
+#define VCDB_RECORD_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/engine.h>
+#include <vcdb/record.h>
+#include <vcdb/transaction.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief A record engine.
+ *
+ * The engine table is the first member, so an engine method can recover its
+ * record engine from the engine pointer in its builder.  Record engines are
+ * registered for the life of the process.  The file, failed flag, and start
+ * time are guarded by the spinlock.  Records are built before it is taken, so
+ * it is held for no more than a single buffered write.
+ */
+typedef struct vcdb_record_engine
+{
+    vcdb_database_engine_t engine;
+    vcdb_database_engine_t* inner;
+    _Atomic bool recording;
+    atomic_flag lock;
+    FILE* file;
+    bool failed;
+    uint64_t start;
+} vcdb_record_engine_t;
+
+/**
+ * \brief Get the record engine of a builder.
+ *
+ * \param builder       The builder, whose engine is a record engine.
+ *
+ * \returns the record engine.
+ */
+static inline vcdb_record_engine_t* vcdb_record_engine_get(
+    vcdb_builder_t* builder)
+{
+    return (vcdb_record_engine_t*)builder->engine;
+}
+
+/**
+ * \brief Check whether a record engine is recording.
+ *
+ * \param record        The record engine.
+ *
+ * \returns true if recording is started.
+ */
+static inline bool vcdb_record_recording(vcdb_record_engine_t* record)
+{
+    return atomic_load_explicit(&record->recording, memory_order_relaxed);
+}
+
+/**
+ * \brief Acquire a record engine's spinlock.
+ *
+ * \param record        The record engine to lock.
+ */
+static inline void vcdb_record_lock(vcdb_record_engine_t* record)
+{
+    while (atomic_flag_test_and_set_explicit(
+                &record->lock, memory_order_acquire))
+    {
+    }
+}
+
+/**
+ * \brief Release a record engine's spinlock.
+ *
+ * \param record        The record engine to unlock.
+ */
+static inline void vcdb_record_unlock(vcdb_record_engine_t* record)
+{
+    atomic_flag_clear_explicit(&record->lock, memory_order_release);
+}
+
+/**
+ * \brief Find a registered record engine by name.
+ *
+ * \param engine        The name of the record engine.
+ * \param record        Pointer to receive the record engine on success.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a record engine.
+ */
+int vcdb_record_engine_find(
+    const char* engine, vcdb_record_engine_t** record);
+
+/**
+ * \brief Append a record to the record file, if recording is started.
+ *
+ * \param record        The record engine.
+ * \param op            The operation.
+ * \param transaction   The transaction of the call, or NULL.
+ * \param status        The status code returned by the inner engine.
+ * \param name          The datastore or index name, or NULL.
+ * \param key           The key, or NULL.
+ * \param key_size      The size of the key.
+ * \param value         The value, or NULL.
+ * \param value_size    The size of the value.
+ * \param extra         The extra data, or NULL.
+ * \param extra_size    The size of the extra data.
+ */
+void vcdb_record_write(
+    vcdb_record_engine_t* record, vcdb_record_op_t op,
+    vcdb_transaction_t* transaction, int status, const char* name,
+    const void* key, size_t key_size, const void* value, size_t value_size,
+    const void* extra, size_t extra_size);
+
+/**
+ * \brief Build the list of secondary keys of a serialized value.
+ *
+ * \param builder       The builder of the database.
+ * \param datastore     The datastore of the value.
+ * \param value         The serialized value.
+ * \param value_size    The size of the serialized value.
+ * \param extra         Pointer to receive the list, which the caller must
+ *                      release with vcdb_builder_memory_release(), or
+ *                      NULL if the datastore has no indexes.
+ * \param extra_size    Pointer to receive the size of the list.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_BAD_MEMORY_ALLOCATION if allocation failed.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_index_keys(
+    vcdb_builder_t* builder, vcdb_datastore_t* datastore, const void* value,
+    size_t value_size, void** extra, size_t* extra_size);
+
+/**
+ * \brief Record a datastore get.
+ *
+ * \param database      The database instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value buffer.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_get(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size);
+
+/**
+ * \brief Record an index get.
+ *
+ * \param database      The database instance.
+ * \param index         The index to use.
+ * \param key           The secondary key.
+ * \param key_size      The size of the secondary key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value buffer.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_index_get(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size);
+
+/**
+ * \brief Record the beginning of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ * \param database      The database instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_transaction_begin(
+    vcdb_transaction_t* transaction,
+    vcdb_database_t* database);
+
+/**
+ * \brief Record the commit of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_transaction_commit(
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Record the rollback of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_transaction_rollback(
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Record a datastore put.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The serialized value.
+ * \param value_size    The size of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_put(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size);
+
+/**
+ * \brief Record a datastore merge.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_merge(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size);
+
+/**
+ * \brief Record a datastore delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_delete(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size);
+
+/**
+ * \brief Record a datastore range delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_delete_range(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size);
+
+/**
+ * \brief Record an index delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param index         The index to use.
+ * \param key           The secondary key.
+ * \param key_size      The size of the secondary key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_index_delete(
+    vcdb_transaction_t* transaction,
+    vcdb_index_t* index,
+    void* key,
+    size_t* key_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_RECORD_PRIVATE_HEADER_GUARD*/
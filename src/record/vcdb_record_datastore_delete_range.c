@@ -0,0 +1,46 @@
+/**
+ * \file vcdb_record_datastore_delete_range.c
+ *
+ * \brief Implementation of the vcdb_record_datastore_delete_range() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "record_private.h"
+
+/**
+ * \brief Record a datastore range delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_delete_range(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size)
+{
+    vcdb_record_engine_t* record =
+        vcdb_record_engine_get(transaction->database->builder);
+
+    int retval = record->inner->datastore_delete_range(
+        transaction, datastore, start, start_size, end, end_size);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_DATASTORE_DELETE_RANGE, transaction,
+            retval, datastore->name, start, *start_size, end, *end_size,
+            NULL, 0);
+    }
+
+    return retval;
+}
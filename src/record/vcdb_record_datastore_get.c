@@ -0,0 +1,44 @@
+/**
+ * \file vcdb_record_datastore_get.c
+ *
+ * \brief Implementation of the vcdb_record_datastore_get() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "record_private.h"
+
+/**
+ * \brief Record a datastore get.
+ *
+ * \param database      The database instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value buffer.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_get(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size)
+{
+    vcdb_record_engine_t* record = vcdb_record_engine_get(database->builder);
+
+    int retval = record->inner->datastore_get(
+        database, datastore, key, key_size, value, value_size);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_DATASTORE_GET, NULL, retval,
+            datastore->name, key, key_size, NULL, 0, NULL, 0);
+    }
+
+    return retval;
+}
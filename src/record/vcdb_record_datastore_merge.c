@@ -0,0 +1,45 @@
+/**
+ * \file vcdb_record_datastore_merge.c
+ *
+ * \brief Implementation of the vcdb_record_datastore_merge() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "record_private.h"
+
+/**
+ * \brief Record a datastore merge.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_merge(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size)
+{
+    vcdb_record_engine_t* record =
+        vcdb_record_engine_get(transaction->database->builder);
+
+    int retval = record->inner->datastore_merge(
+        transaction, datastore, key, key_size, operand, operand_size);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_DATASTORE_MERGE, transaction, retval,
+            datastore->name, key, *key_size, operand, *operand_size, NULL, 0);
+    }
+
+    return retval;
+}
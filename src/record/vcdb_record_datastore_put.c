@@ -0,0 +1,57 @@
+/**
+ * \file vcdb_record_datastore_put.c
+ *
+ * \brief Implementation of the vcdb_record_datastore_put() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "record_private.h"
+
+/**
+ * \brief Record a datastore put.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The serialized value.
+ * \param value_size    The size of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_datastore_put(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size)
+{
+    vcdb_record_engine_t* record =
+        vcdb_record_engine_get(transaction->database->builder);
+
+    int retval = record->inner->datastore_put(
+        transaction, datastore, key, key_size, value, value_size);
+
+    if (vcdb_record_recording(record))
+    {
+        /* the secondary keys let a replay rebuild the same index entries.  A
+         * value whose keys cannot be read is recorded without them. */
+        void* extra = NULL;
+        size_t extra_size = 0;
+        vcdb_record_index_keys(
+            transaction->database->builder, datastore, value, *value_size,
+            &extra, &extra_size);
+
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_DATASTORE_PUT, transaction, retval,
+            datastore->name, key, *key_size, value, *value_size, extra,
+            extra_size);
+
+        vcdb_builder_memory_release(
+            transaction->database->builder, extra);
+    }
+
+    return retval;
+}
@@ -0,0 +1,45 @@
+/**
+ * \file vcdb_record_engine_find.c
+ *
+ * \brief Implementation of the vcdb_record_engine_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "record_private.h"
+
+/**
+ * \brief Find a registered record engine by name.
+ *
+ * \param engine        The name of the record engine.
+ * \param record        Pointer to receive the record engine on success.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a record engine.
+ */
+int vcdb_record_engine_find(
+    const char* engine, vcdb_record_engine_t** record)
+{
+    MODEL_ASSERT(NULL != engine);
+    MODEL_ASSERT(NULL != record);
+
+    vcdb_database_engine_t* eng = vcdb_database_engine_lookup(engine);
+    if (NULL == eng)
+    {
+        return VCDB_ERROR_MISSING_DATABASE_ENGINE;
+    }
+
+    /* only record engines use the record begin method. */
+    if (&vcdb_record_transaction_begin != eng->transaction_begin)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    *record = (vcdb_record_engine_t*)eng;
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/**
+ * \file vcdb_record_engine_register.c
+ *
+ * \brief Implementation of the vcdb_record_engine_register() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/engine.h>
+
+#include "record_private.h"
+
+/**
+ * \brief Register the record engine for a registered database engine.
+ *
+ * The record engine is registered under VCDB_RECORD_ENGINE_PREFIX followed by
+ * the name of the inner engine, as in "record:LMDB".  Record engines are never
+ * registered implicitly, so applications which do not call this method don't
+ * link the record engine.  Registering the same record engine again does
+ * nothing.
+ *
+ * \param engine        The name of the inner engine, such as "LMDB".  It may
+ *                      itself be a registered decorator.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the inner engine is not
+ *            found.
+ *          - VCDB_ERROR_BAD_MEMORY_ALLOCATION if the record engine could not be
+ *            allocated or registered.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_engine_register(
+    const char* engine)
+{
+    MODEL_ASSERT(NULL != engine);
+
+    /* parameter sanity check. */
+    if (NULL == engine)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_database_engine_t* inner = vcdb_database_engine_lookup(engine);
+    if (NULL == inner)
+    {
+        return VCDB_ERROR_MISSING_DATABASE_ENGINE;
+    }
+
+    /* build the name of the record engine. */
+    size_t prefix_size = strlen(VCDB_RECORD_ENGINE_PREFIX);
+    size_t engine_size = strlen(engine) + 1;
+    char* name = (char*)malloc(prefix_size + engine_size);
+    if (NULL == name)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memcpy(name, VCDB_RECORD_ENGINE_PREFIX, prefix_size);
+    memcpy(name + prefix_size, engine, engine_size);
+
+    vcdb_record_engine_t* record =
+        (vcdb_record_engine_t*)calloc(1, sizeof(vcdb_record_engine_t));
+    if (NULL == record)
+    {
+        free(name);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    record->inner = inner;
+    atomic_flag_clear(&record->lock);
+
+    /* methods which are not recorded go straight to the inner engine. */
+    record->engine = *inner;
+    record->engine.datastore_get = &vcdb_record_datastore_get;
+    record->engine.index_get = &vcdb_record_index_get;
+    record->engine.transaction_begin = &vcdb_record_transaction_begin;
+    record->engine.transaction_commit = &vcdb_record_transaction_commit;
+    record->engine.transaction_rollback = &vcdb_record_transaction_rollback;
+    record->engine.datastore_put = &vcdb_record_datastore_put;
+    record->engine.datastore_delete = &vcdb_record_datastore_delete;
+    record->engine.index_delete = &vcdb_record_index_delete;
+
+    /* optional methods stay unsupported if the inner engine lacks them. */
+    if (NULL != inner->datastore_merge)
+    {
+        record->engine.datastore_merge = &vcdb_record_datastore_merge;
+    }
+
+    if (NULL != inner->datastore_delete_range)
+    {
+        record->engine.datastore_delete_range =
+            &vcdb_record_datastore_delete_range;
+    }
+
+    vcdb_database_engine_register(&record->engine, name);
+
+    /* the first registration of this name wins. */
+    vcdb_database_engine_t* registered = vcdb_database_engine_lookup(name);
+    free(name);
+    if (registered != &record->engine)
+    {
+        free(record);
+
+        return NULL == registered
+            ? VCDB_ERROR_BAD_MEMORY_ALLOCATION
+            : VCDB_STATUS_SUCCESS;
+    }
+
+    return VCDB_STATUS_SUCCESS;
+}
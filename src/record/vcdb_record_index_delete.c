@@ -0,0 +1,44 @@
+/**
+ * \file vcdb_record_index_delete.c
+ *
+ * \brief Implementation of the vcdb_record_index_delete() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "record_private.h"
+
+/**
+ * \brief Record an index delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param index         The index to use.
+ * \param key           The secondary key.
+ * \param key_size      The size of the secondary key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_index_delete(
+    vcdb_transaction_t* transaction,
+    vcdb_index_t* index,
+    void* key,
+    size_t* key_size)
+{
+    vcdb_record_engine_t* record =
+        vcdb_record_engine_get(transaction->database->builder);
+
+    int retval = record->inner->index_delete(
+        transaction, index, key, key_size);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_INDEX_DELETE, transaction, retval,
+            index->name, key, *key_size, NULL, 0, index->datastore->name,
+            strlen(index->datastore->name));
+    }
+
+    return retval;
+}
@@ -0,0 +1,47 @@
+/**
+ * \file vcdb_record_index_get.c
+ *
+ * \brief Implementation of the vcdb_record_index_get() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "record_private.h"
+
+/**
+ * \brief Record an index get.
+ *
+ * \param database      The database instance.
+ * \param index         The index to use.
+ * \param key           The secondary key.
+ * \param key_size      The size of the secondary key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value buffer.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_index_get(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size)
+{
+    vcdb_record_engine_t* record = vcdb_record_engine_get(database->builder);
+
+    int retval = record->inner->index_get(
+        database, index, key, key_size, value, value_size);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_INDEX_GET, NULL, retval, index->name, key,
+            key_size, NULL, 0, index->datastore->name,
+            strlen(index->datastore->name));
+    }
+
+    return retval;
+}
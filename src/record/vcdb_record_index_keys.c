@@ -0,0 +1,118 @@
+/**
+ * \file vcdb_record_index_keys.c
+ *
+ * \brief Implementation of the vcdb_record_index_keys() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/index.h>
+
+#include "record_private.h"
+
+/**
+ * \brief Build the list of secondary keys of a serialized value.
+ *
+ * \param builder       The builder of the database.
+ * \param datastore     The datastore of the value.
+ * \param value         The serialized value.
+ * \param value_size    The size of the serialized value.
+ * \param extra         Pointer to receive the list, which the caller must
+ *                      release with vcdb_builder_memory_release(), or
+ *                      NULL if the datastore has no indexes.
+ * \param extra_size    Pointer to receive the size of the list.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_BAD_MEMORY_ALLOCATION if allocation failed.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_index_keys(
+    vcdb_builder_t* builder, vcdb_datastore_t* datastore, const void* value,
+    size_t value_size, void** extra, size_t* extra_size)
+{
+    MODEL_ASSERT(NULL != builder);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != extra);
+    MODEL_ASSERT(NULL != extra_size);
+
+    *extra = NULL;
+    *extra_size = 0;
+
+    vcdb_index_t* const* indexes;
+    size_t count;
+    int retval =
+        vcdb_builder_datastore_indexes_get(
+            builder, datastore, &indexes, &count);
+    if (VCDB_STATUS_SUCCESS != retval || 0 == count)
+    {
+        return retval;
+    }
+
+    /* each entry is at most a header, a name, and a maximum size key. */
+    size_t max = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        max +=
+            sizeof(vcdb_record_index_key_t) + strlen(indexes[i]->name)
+          + VCDB_MAX_KEY_SIZE;
+    }
+
+    uint8_t* list = (uint8_t*)vcdb_builder_memory_allocate(builder, max);
+    void* raw = vcdb_builder_memory_allocate(builder, datastore->data_size);
+    if (NULL == list || NULL == raw)
+    {
+        retval = VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+        goto cleanup;
+    }
+
+    /* secondary keys are read from the deserialized value, which is the
+     * serialized value itself for identity serialization. */
+    if (datastore->identity_serialization && datastore->data_size == value_size)
+    {
+        memcpy(raw, value, value_size);
+        retval = VCDB_STATUS_SUCCESS;
+    }
+    else
+    {
+        retval = datastore->value_reader(value, value_size, raw);
+    }
+
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup;
+    }
+
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!vcdb_index_value_included(indexes[i], raw))
+        {
+            continue;
+        }
+
+        vcdb_record_index_key_t entry;
+        size_t key_size = VCDB_MAX_KEY_SIZE;
+        uint8_t* name = list + size + sizeof(entry);
+        entry.name_size = strlen(indexes[i]->name);
+        memcpy(name, indexes[i]->name, entry.name_size);
+        indexes[i]->secondary_key_getter(
+            raw, name + entry.name_size, &key_size);
+        entry.key_size = key_size;
+        memcpy(list + size, &entry, sizeof(entry));
+        size += sizeof(entry) + entry.name_size + entry.key_size;
+    }
+
+    *extra = list;
+    *extra_size = size;
+    list = NULL;
+
+cleanup:
+    vcdb_builder_memory_release(builder, raw);
+    vcdb_builder_memory_release(builder, list);
+
+    return retval;
+}
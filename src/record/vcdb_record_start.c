@@ -0,0 +1,80 @@
+/**
+ * \file vcdb_record_start.c
+ *
+ * \brief Implementation of the vcdb_record_start() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "../latency/latency_private.h"
+#include "record_private.h"
+
+/**
+ * \brief Start recording the operations made through a record engine.
+ *
+ * Any earlier record file of the engine is closed first.
+ *
+ * \param engine        The name of the record engine, such as "record:LMDB".
+ * \param path          The record file to create.  It is replaced if it
+ *                      exists.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a record engine.
+ *          - VCDB_ERROR_RECORD_FILE if the file could not be created.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_start(
+    const char* engine,
+    const char* path)
+{
+    MODEL_ASSERT(NULL != engine);
+    MODEL_ASSERT(NULL != path);
+
+    /* parameter sanity check. */
+    if (NULL == engine || NULL == path)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_record_engine_t* record;
+    int retval = vcdb_record_engine_find(engine, &record);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (NULL == file)
+    {
+        return VCDB_ERROR_RECORD_FILE;
+    }
+
+    if (1 != fwrite(VCDB_RECORD_MAGIC, VCDB_RECORD_MAGIC_SIZE, 1, file))
+    {
+        fclose(file);
+
+        return VCDB_ERROR_RECORD_FILE;
+    }
+
+    /* swap in the new file. */
+    vcdb_record_lock(record);
+    FILE* old = record->file;
+    record->file = file;
+    record->failed = false;
+    record->start = vcdb_latency_clock_monotonic();
+    vcdb_record_unlock(record);
+
+    atomic_store_explicit(&record->recording, true, memory_order_relaxed);
+
+    if (NULL != old)
+    {
+        fclose(old);
+    }
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,59 @@
+/**
+ * \file vcdb_record_stop.c
+ *
+ * \brief Implementation of the vcdb_record_stop() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "record_private.h"
+
+/**
+ * \brief Stop recording, and close the record file.
+ *
+ * \param engine        The name of the record engine, such as "record:LMDB".
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a record engine.
+ *          - VCDB_ERROR_RECORD_FILE if a record could not be written.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_record_stop(
+    const char* engine)
+{
+    MODEL_ASSERT(NULL != engine);
+
+    /* parameter sanity check. */
+    if (NULL == engine)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_record_engine_t* record;
+    int retval = vcdb_record_engine_find(engine, &record);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    atomic_store_explicit(&record->recording, false, memory_order_relaxed);
+
+    /* calls already past the recording check see no file. */
+    vcdb_record_lock(record);
+    FILE* file = record->file;
+    bool failed = record->failed;
+    record->file = NULL;
+    vcdb_record_unlock(record);
+
+    if (NULL != file && 0 != fclose(file))
+    {
+        failed = true;
+    }
+
+    return failed ? VCDB_ERROR_RECORD_FILE : VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,35 @@
+/**
+ * \file vcdb_record_transaction_begin.c
+ *
+ * \brief Implementation of the vcdb_record_transaction_begin() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "record_private.h"
+
+/**
+ * \brief Record the beginning of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ * \param database      The database instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_transaction_begin(
+    vcdb_transaction_t* transaction,
+    vcdb_database_t* database)
+{
+    vcdb_record_engine_t* record = vcdb_record_engine_get(database->builder);
+
+    int retval = record->inner->transaction_begin(transaction, database);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_TRANSACTION_BEGIN, transaction, retval,
+            NULL, NULL, 0, NULL, 0, NULL, 0);
+    }
+
+    return retval;
+}
@@ -0,0 +1,34 @@
+/**
+ * \file vcdb_record_transaction_commit.c
+ *
+ * \brief Implementation of the vcdb_record_transaction_commit() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "record_private.h"
+
+/**
+ * \brief Record the commit of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_record_transaction_commit(
+    vcdb_transaction_t* transaction)
+{
+    vcdb_record_engine_t* record =
+        vcdb_record_engine_get(transaction->database->builder);
+
+    int retval = record->inner->transaction_commit(transaction);
+
+    if (vcdb_record_recording(record))
+    {
+        vcdb_record_write(
+            record, VCDB_RECORD_OP_TRANSACTION_COMMIT, transaction, retval,
+            NULL, NULL, 0, NULL, 0, NULL, 0);
+    }
+
+    return retval;
+}
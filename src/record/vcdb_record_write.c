@@ -0,0 +1,145 @@
+/**
+ * \file vcdb_record_write.c
+ *
+ * \brief Implementation of the vcdb_record_write() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../latency/latency_private.h"
+#include "record_private.h"
+
+/* records up to this size are built on the stack. */
+#ifndef VCDB_RECORD_WRITE_STACK_BUFFER_SIZE
+#define VCDB_RECORD_WRITE_STACK_BUFFER_SIZE 512
+#endif
+
+/* the number of the calling thread, assigned on its first record. */
+static _Thread_local uint32_t vcdb_record_thread;
+static _Atomic uint32_t vcdb_record_thread_next = 1;
+
+/* forward decls */
+static uint8_t* vcdb_record_write_append(
+    uint8_t* out, const void* data, size_t size);
+
+/**
+ * \brief Append a record to the record file, if recording is started.
+ *
+ * The record is built in a local buffer first, so the lock is only held for a
+ * single buffered write.
+ *
+ * \param record        The record engine.
+ * \param op            The operation.
+ * \param transaction   The transaction of the call, or NULL.
+ * \param status        The status code returned by the inner engine.
+ * \param name          The datastore or index name, or NULL.
+ * \param key           The key, or NULL.
+ * \param key_size      The size of the key.
+ * \param value         The value, or NULL.
+ * \param value_size    The size of the value.
+ * \param extra         The extra data, or NULL.
+ * \param extra_size    The size of the extra data.
+ */
+void vcdb_record_write(
+    vcdb_record_engine_t* record, vcdb_record_op_t op,
+    vcdb_transaction_t* transaction, int status, const char* name,
+    const void* key, size_t key_size, const void* value, size_t value_size,
+    const void* extra, size_t extra_size)
+{
+    MODEL_ASSERT(NULL != record);
+
+    if (0 == vcdb_record_thread)
+    {
+        vcdb_record_thread =
+            atomic_fetch_add_explicit(
+                &vcdb_record_thread_next, 1, memory_order_relaxed);
+    }
+
+    size_t name_size = NULL == name ? 0 : strlen(name);
+    uint64_t now = vcdb_latency_clock_monotonic();
+
+    vcdb_record_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.size =
+        sizeof(header) + name_size + key_size + value_size + extra_size;
+    header.op = op;
+    header.thread = vcdb_record_thread;
+    header.status = status;
+    header.transaction = (uint64_t)(uintptr_t)transaction;
+    header.name_size = name_size;
+    header.key_size = key_size;
+    header.value_size = value_size;
+    header.extra_size = extra_size;
+
+    /* build the record outside of the lock. */
+    uint8_t stack_buffer[VCDB_RECORD_WRITE_STACK_BUFFER_SIZE];
+    uint8_t* buffer = stack_buffer;
+    if (header.size > sizeof(stack_buffer))
+    {
+        buffer = (uint8_t*)malloc(header.size);
+    }
+
+    if (NULL != buffer)
+    {
+        uint8_t* out = buffer + sizeof(header);
+        out = vcdb_record_write_append(out, name, name_size);
+        out = vcdb_record_write_append(out, key, key_size);
+        out = vcdb_record_write_append(out, value, value_size);
+        vcdb_record_write_append(out, extra, extra_size);
+    }
+
+    vcdb_record_lock(record);
+
+    /* recording stopped since the caller checked. */
+    if (NULL == record->file)
+    {
+        goto unlock;
+    }
+
+    if (NULL == buffer)
+    {
+        record->failed = true;
+        goto unlock;
+    }
+
+    /* the start time is guarded by the lock. */
+    header.time = now > record->start ? now - record->start : 0;
+    memcpy(buffer, &header, sizeof(header));
+
+    if (1 != fwrite(buffer, header.size, 1, record->file))
+    {
+        record->failed = true;
+    }
+
+unlock:
+    vcdb_record_unlock(record);
+
+    if (buffer != stack_buffer)
+    {
+        free(buffer);
+    }
+}
+
+/**
+ * \brief Append data to a record being built.
+ *
+ * \param out           The end of the record so far.
+ * \param data          The data to append, or NULL if size is 0.
+ * \param size          The size of the data.
+ *
+ * \returns the new end of the record.
+ */
+static uint8_t* vcdb_record_write_append(
+    uint8_t* out, const void* data, size_t size)
+{
+    if (size > 0)
+    {
+        memcpy(out, data, size);
+    }
+
+    return out + size;
+}
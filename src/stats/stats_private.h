@@ -0,0 +1,197 @@
+/**
+ * \file stats_private.h
+ *
+ * \brief Private details for the database operation counters.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_STATS_PRIVATE_HEADER_GUARD
+#define VCDB_STATS_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vcdb/builder.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief Set to 1 when the target has lock free 64-bit atomics.
+ *
+ * Operation counters are only built for such targets, so that targets such as
+ * Cortex-M4 never need libatomic.
+ */
+#if 2 == ATOMIC_LLONG_LOCK_FREE
+#define VCDB_STATS_SUPPORTED 1
+#else
+#define VCDB_STATS_SUPPORTED 0
+#endif
+
+/**
+ * \brief The number of counter stripes.  This must be a power of two.
+ *
+ * Each thread updates the stripe it was assigned on first use, so threads only
+ * share a cache line when there are more threads than stripes.
+ */
+#define VCDB_STATS_STRIPES 16
+
+/**
+ * \brief The size of a cache line, used to keep stripes apart.
+ */
+#define VCDB_STATS_CACHE_LINE_SIZE 64
+
+/**
+ * \brief The counters kept for each datastore and index.
+ */
+typedef enum vcdb_stats_counter
+{
+    VCDB_STATS_GETS,
+    VCDB_STATS_HITS,
+    VCDB_STATS_MISSES,
+    VCDB_STATS_CACHE_HITS,
+    VCDB_STATS_FILTER_REJECTS,
+    VCDB_STATS_PUTS,
+    VCDB_STATS_DELETES,
+    VCDB_STATS_TRUNCATE_RETRIES,
+    VCDB_STATS_BYTES_SERIALIZED,
+    VCDB_STATS_BYTES_DESERIALIZED,
+
+    /**
+     * \brief Database-wide counters are kept in an extra instance slot.
+     */
+    VCDB_STATS_COMMITS = 0,
+    VCDB_STATS_ROLLBACKS,
+
+    VCDB_STATS_COUNTER_COUNT = VCDB_STATS_BYTES_DESERIALIZED + 1
+
+} vcdb_stats_counter_t;
+
+/**
+ * \brief Striped operation counters for a database.
+ *
+ * Counters are laid out as [stripe][instance][counter].  The instance is a
+ * correlation ID, and the instance at instance_count holds database-wide
+ * counters.  Each stripe is padded to whole cache lines.
+ */
+typedef struct vcdb_stats
+{
+    vcdb_builder_t* builder;
+    size_t instance_count;
+    size_t stripe_size;
+    _Atomic uint64_t* counters;
+    void* counters_memory;
+} vcdb_stats_t;
+
+/**
+ * \brief The stripe of the calling thread, offset by one so that zero means
+ * unassigned.
+ */
+extern _Thread_local unsigned vcdb_stats_thread_stripe;
+
+/**
+ * \brief Assign a stripe to the calling thread.
+ *
+ * \returns the stripe index, offset by one.
+ */
+unsigned vcdb_stats_stripe_assign(void);
+
+/**
+ * \brief Get the stripe assigned to the calling thread.
+ *
+ * \returns the stripe index.
+ */
+static inline unsigned vcdb_stats_stripe(void)
+{
+    unsigned stripe = vcdb_stats_thread_stripe;
+    if (0 == stripe)
+    {
+        stripe = vcdb_stats_stripe_assign();
+    }
+
+    return stripe - 1;
+}
+
+/**
+ * \brief Add to a counter.
+ *
+ * \param stats         The counters, or NULL if they are disabled.
+ * \param instance      The correlation ID, or -1 for a database-wide counter.
+ * \param counter       The counter to update.
+ * \param amount        The amount to add.
+ */
+static inline void vcdb_stats_add(
+    vcdb_stats_t* stats, int instance, vcdb_stats_counter_t counter,
+    uint64_t amount)
+{
+    /* without counters, this is the only added branch. */
+    if (NULL == stats)
+    {
+        return;
+    }
+
+#if VCDB_STATS_SUPPORTED
+
+    size_t slot = instance < 0 ? stats->instance_count : (size_t)instance;
+    if (slot > stats->instance_count)
+    {
+        return;
+    }
+
+    atomic_fetch_add_explicit(
+        &stats->counters[
+            vcdb_stats_stripe() * stats->stripe_size
+                + slot * VCDB_STATS_COUNTER_COUNT + counter],
+        amount, memory_order_relaxed);
+#else
+    (void)instance;
+    (void)counter;
+    (void)amount;
+#endif
+}
+
+/**
+ * \brief Create the counters for a database.
+ *
+ * \param stats             Pointer to receive the counters on success.  It
+ *                          is set to NULL if the builder does not enable
+ *                          operation counters.
+ * \param builder           The builder describing the database.
+ * \param instance_count    The number of datastores and indexes.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_stats_create(
+    vcdb_stats_t** stats, vcdb_builder_t* builder, size_t instance_count);
+
+/**
+ * \brief Release the counters for a database.
+ *
+ * \param stats         The counters to release, or NULL.
+ */
+void vcdb_stats_release(
+    vcdb_stats_t* stats);
+
+/**
+ * \brief Sum a counter over all stripes.
+ *
+ * \param stats         The counters.
+ * \param instance      The correlation ID, or -1 for a database-wide counter.
+ * \param counter       The counter to sum.
+ *
+ * \returns the total.
+ */
+uint64_t vcdb_stats_sum(
+    vcdb_stats_t* stats, int instance, vcdb_stats_counter_t counter);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_STATS_PRIVATE_HEADER_GUARD*/
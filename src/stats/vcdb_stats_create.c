@@ -0,0 +1,83 @@
+/**
+ * \file vcdb_stats_create.c
+ *
+ * \brief Implementation of the vcdb_stats_create() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/error_codes.h>
+
+#include "stats_private.h"
+
+/**
+ * \brief Create the counters for a database.
+ *
+ * \param stats             Pointer to receive the counters on success.  It
+ *                          is set to NULL if the builder does not enable
+ *                          operation counters.
+ * \param builder           The builder describing the database.
+ * \param instance_count    The number of datastores and indexes.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_stats_create(
+    vcdb_stats_t** stats, vcdb_builder_t* builder, size_t instance_count)
+{
+    MODEL_ASSERT(NULL != stats);
+    MODEL_ASSERT(NULL != builder);
+
+    /* parameter sanity check. */
+    if (NULL == stats || NULL == builder)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* operation counters are only kept when enabled. */
+    *stats = NULL;
+    if (!builder->stats_enabled)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    vcdb_stats_t* s = (vcdb_stats_t*)
+        vcdb_builder_memory_allocate(builder, sizeof(vcdb_stats_t));
+    if (NULL == s)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    s->builder = builder;
+
+    /* one extra slot holds the database-wide counters. */
+    size_t words_per_line = VCDB_STATS_CACHE_LINE_SIZE / sizeof(uint64_t);
+    size_t words = (instance_count + 1) * VCDB_STATS_COUNTER_COUNT;
+    s->instance_count = instance_count;
+    s->stripe_size =
+        (words + words_per_line - 1) / words_per_line * words_per_line;
+
+    /* align the stripes to cache lines by over-allocating by one line. */
+    size_t size = VCDB_STATS_STRIPES * s->stripe_size * sizeof(uint64_t);
+    s->counters_memory = vcdb_builder_memory_allocate(
+        builder, size + VCDB_STATS_CACHE_LINE_SIZE);
+    if (NULL == s->counters_memory)
+    {
+        vcdb_builder_memory_release(builder, s);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    s->counters = (_Atomic uint64_t*)
+        (((uintptr_t)s->counters_memory + VCDB_STATS_CACHE_LINE_SIZE - 1)
+            & ~(uintptr_t)(VCDB_STATS_CACHE_LINE_SIZE - 1));
+
+    memset((void*)s->counters, 0, size);
+
+    *stats = s;
+
+    return VCDB_STATUS_SUCCESS;
+}
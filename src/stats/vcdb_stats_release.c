@@ -0,0 +1,31 @@
+/**
+ * \file vcdb_stats_release.c
+ *
+ * \brief Implementation of the vcdb_stats_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "stats_private.h"
+
+/**
+ * \brief Release the counters for a database.
+ *
+ * \param stats         The counters to release, or NULL.
+ */
+void vcdb_stats_release(
+    vcdb_stats_t* stats)
+{
+    /* operation counters are optional. */
+    if (NULL == stats)
+    {
+        return;
+    }
+
+    vcdb_builder_t* builder = stats->builder;
+
+    vcdb_builder_memory_release(builder, stats->counters_memory);
+    vcdb_builder_memory_release(builder, stats);
+}
@@ -0,0 +1,32 @@
+/**
+ * \file vcdb_stats_stripe_assign.c
+ *
+ * \brief Implementation of the vcdb_stats_stripe_assign() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "stats_private.h"
+
+/* the next stripe to hand out. */
+static atomic_uint vcdb_stats_next_stripe;
+
+/* the stripe of this thread, offset by one so that zero means unassigned. */
+_Thread_local unsigned vcdb_stats_thread_stripe;
+
+/**
+ * \brief Assign a stripe to the calling thread.
+ *
+ * \returns the stripe index, offset by one.
+ */
+unsigned vcdb_stats_stripe_assign(void)
+{
+    /* hand out stripes round robin. */
+    unsigned next =
+        atomic_fetch_add_explicit(
+            &vcdb_stats_next_stripe, 1, memory_order_relaxed);
+
+    vcdb_stats_thread_stripe = (next & (VCDB_STATS_STRIPES - 1)) + 1;
+
+    return vcdb_stats_thread_stripe;
+}
@@ -0,0 +1,48 @@
+/**
+ * \file vcdb_stats_sum.c
+ *
+ * \brief Implementation of the vcdb_stats_sum() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "stats_private.h"
+
+/**
+ * \brief Sum a counter over all stripes.
+ *
+ * \param stats         The counters.
+ * \param instance      The correlation ID, or -1 for a database-wide counter.
+ * \param counter       The counter to sum.
+ *
+ * \returns the total.
+ */
+uint64_t vcdb_stats_sum(
+    vcdb_stats_t* stats, int instance, vcdb_stats_counter_t counter)
+{
+    MODEL_ASSERT(NULL != stats);
+
+#if VCDB_STATS_SUPPORTED
+    size_t slot = instance < 0 ? stats->instance_count : (size_t)instance;
+    size_t offset = slot * VCDB_STATS_COUNTER_COUNT + counter;
+    uint64_t total = 0;
+
+    for (size_t i = 0; i < VCDB_STATS_STRIPES; ++i)
+    {
+        total +=
+            atomic_load_explicit(
+                &stats->counters[i * stats->stripe_size + offset],
+                memory_order_relaxed);
+    }
+
+    return total;
+#else
+    (void)stats;
+    (void)instance;
+    (void)counter;
+
+    return 0;
+#endif
+}
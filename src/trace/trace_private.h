@@ -0,0 +1,537 @@
+/**
+ * \file trace_private.h
+ *
+ * \brief Private details for the trace engine.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_TRACE_PRIVATE_HEADER_GUARD
+#define VCDB_TRACE_PRIVATE_HEADER_GUARD
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/engine.h>
+#include <vcdb/trace.h>
+#include <vcdb/transaction.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief Set to 1 when the target has lock free 64-bit atomics.
+ *
+ * Trace engines are only built for such targets, so that targets such as
+ * Cortex-M4 never need libatomic.
+ */
+#if 2 == ATOMIC_LLONG_LOCK_FREE
+#define VCDB_TRACE_SUPPORTED 1
+#else
+#define VCDB_TRACE_SUPPORTED 0
+#endif
+
+/**
+ * \brief The totals recorded for a single engine method.
+ */
+typedef struct vcdb_trace_counters
+{
+    _Atomic uint64_t calls;
+    _Atomic uint64_t errors;
+    _Atomic uint64_t not_found;
+    _Atomic uint64_t would_truncate;
+    _Atomic int last_error;
+    _Atomic uint64_t total_time;
+    _Atomic uint64_t max_time;
+    _Atomic uint64_t bytes;
+} vcdb_trace_counters_t;
+
+/**
+ * \brief A slot in the ring of slow call samples.
+ */
+typedef struct vcdb_trace_sample_slot
+{
+    _Atomic int method;
+    _Atomic int correlation_id;
+    _Atomic int status;
+    _Atomic uint64_t elapsed;
+    _Atomic uint64_t bytes;
+} vcdb_trace_sample_slot_t;
+
+/**
+ * \brief A trace engine.
+ *
+ * The engine table is the first member, so an engine method can recover its
+ * trace engine from the engine pointer in its builder.  Trace engines are
+ * registered for the life of the process.
+ */
+typedef struct vcdb_trace_engine
+{
+    vcdb_database_engine_t engine;
+    vcdb_database_engine_t* inner;
+    _Atomic uint64_t slow_threshold;
+    vcdb_trace_counters_t counters[VCDB_TRACE_METHOD_COUNT];
+    _Atomic uint64_t sample_next;
+    vcdb_trace_sample_slot_t samples[VCDB_TRACE_SAMPLES];
+} vcdb_trace_engine_t;
+
+/**
+ * \brief Get the trace engine of a builder.
+ *
+ * \param builder       The builder, whose engine is a trace engine.
+ *
+ * \returns the trace engine.
+ */
+static inline vcdb_trace_engine_t* vcdb_trace_engine_get(
+    vcdb_builder_t* builder)
+{
+    return (vcdb_trace_engine_t*)builder->engine;
+}
+
+/**
+ * \brief Find a registered trace engine by name.
+ *
+ * \param engine        The name of the trace engine.
+ * \param trace         Pointer to receive the trace engine on success.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a trace engine.
+ */
+int vcdb_trace_engine_find(
+    const char* engine, vcdb_trace_engine_t** trace);
+
+/**
+ * \brief Record a call forwarded to the inner engine.
+ *
+ * \param trace         The trace engine.
+ * \param method        The engine method.
+ * \param correlation_id The correlation ID of the datastore or index, or -1.
+ * \param status        The status code returned by the inner engine.
+ * \param bytes         The number of key and value bytes in the call.
+ * \param start         The time at which the call was forwarded.
+ */
+void vcdb_trace_record(
+    vcdb_trace_engine_t* trace, vcdb_trace_method_t method,
+    int correlation_id, int status, uint64_t bytes, uint64_t start);
+
+/**
+ * \brief Trace the creation of a database.
+ *
+ * \param database      The database instance.
+ * \param builder       The builder describing the database.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_database_create(
+    vcdb_database_t* database,
+    vcdb_builder_t* builder);
+
+/**
+ * \brief Trace the opening of a database.
+ *
+ * \param database      The database instance.
+ * \param builder       The builder describing the database.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_database_open(
+    vcdb_database_t* database,
+    vcdb_builder_t* builder);
+
+/**
+ * \brief Trace the closing of a database.
+ *
+ * \param database      The database instance.
+ */
+void vcdb_trace_database_close(
+    vcdb_database_t* database);
+
+/**
+ * \brief Trace the deletion of a database.
+ *
+ * \param builder       The builder describing the database.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_database_delete(
+    vcdb_builder_t* builder);
+
+/**
+ * \brief Trace a datastore get.
+ *
+ * \param database      The database instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_get(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size);
+
+/**
+ * \brief Trace a secondary index get.
+ *
+ * \param database      The database instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_get(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size);
+
+/**
+ * \brief Trace the beginning of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ * \param database      The database instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_begin(
+    vcdb_transaction_t* transaction,
+    vcdb_database_t* database);
+
+/**
+ * \brief Trace the commit of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_commit(
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Trace the rollback of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_rollback(
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Trace a datastore put.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_put(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size);
+
+/**
+ * \brief Trace a datastore delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_delete(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size);
+
+/**
+ * \brief Trace a secondary index delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_delete(
+    vcdb_transaction_t* transaction,
+    vcdb_index_t* index,
+    void* key,
+    size_t* key_size);
+
+/**
+ * \brief Trace the marking of a savepoint.
+ *
+ * \param transaction   The transaction instance.
+ * \param savepoint     The savepoint.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_savepoint_set(
+    vcdb_transaction_t* transaction,
+    vcdb_transaction_savepoint_t* savepoint);
+
+/**
+ * \brief Trace the rollback of a savepoint.
+ *
+ * \param transaction   The transaction instance.
+ * \param savepoint     The savepoint.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_savepoint_rollback(
+    vcdb_transaction_t* transaction,
+    vcdb_transaction_savepoint_t* savepoint);
+
+/**
+ * \brief Trace the release of a savepoint.
+ *
+ * \param transaction   The transaction instance.
+ * \param savepoint     The savepoint.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_savepoint_release(
+    vcdb_transaction_t* transaction,
+    vcdb_transaction_savepoint_t* savepoint);
+
+/**
+ * \brief Trace a datastore merge.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param operand       The merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_merge(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size);
+
+/**
+ * \brief Trace a versioned datastore get.
+ *
+ * \param database      The database instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value.
+ * \param version       The version token of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_get_versioned(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t* version);
+
+/**
+ * \brief Trace a versioned datastore put.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value.
+ * \param version       The expected version token.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_put_if_version(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t version);
+
+/**
+ * \brief Trace a datastore range delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param start         The first key in the range.
+ * \param start_size    The size of the first key.
+ * \param end           The key after the range.
+ * \param end_size      The size of the end key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_delete_range(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size);
+
+/**
+ * \brief Trace the loading of a negative-lookup filter.
+ *
+ * \param database      The database instance.
+ * \param correlation_id The correlation ID of the filter.
+ * \param data          The filter buffer.
+ * \param size          The size of the filter.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_filter_load(
+    vcdb_database_t* database,
+    int correlation_id,
+    void* data,
+    size_t* size);
+
+/**
+ * \brief Trace the saving of a negative-lookup filter.
+ *
+ * \param database      The database instance.
+ * \param correlation_id The correlation ID of the filter.
+ * \param data          The filter, or NULL.
+ * \param size          The size of the filter.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_filter_save(
+    vcdb_database_t* database,
+    int correlation_id,
+    const void* data,
+    size_t size);
+
+/**
+ * \brief Trace a datastore membership check.
+ *
+ * \param database      The database instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_contains(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Trace a secondary index membership check.
+ *
+ * \param database      The database instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_contains(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Trace a secondary index primary key lookup.
+ *
+ * \param database      The database instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param primary_key   The primary key buffer.
+ * \param primary_key_size The size of the primary key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_get_primary_key(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size);
+
+/**
+ * \brief Trace a secondary index projection put.
+ *
+ * \param transaction   The transaction instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param projection    The projection.
+ * \param projection_size The size of the projection.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_projection_put(
+    vcdb_transaction_t* transaction,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t projection_size);
+
+/**
+ * \brief Trace a secondary index projection get.
+ *
+ * \param database      The database instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param projection    The projection buffer.
+ * \param projection_size The size of the projection.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_get_projection(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t* projection_size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_TRACE_PRIVATE_HEADER_GUARD*/
@@ -0,0 +1,28 @@
+/**
+ * \file vcdb_trace_database_close.c
+ *
+ * \brief Implementation of the vcdb_trace_database_close() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace the closing of a database.
+ *
+ * \param database      The database instance.
+ */
+void vcdb_trace_database_close(
+    vcdb_database_t* database)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    trace->inner->database_close(database);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_DATABASE_CLOSE, -1, VCDB_STATUS_SUCCESS, 0,
+        timer);
+}
@@ -0,0 +1,31 @@
+/**
+ * \file vcdb_trace_database_delete.c
+ *
+ * \brief Implementation of the vcdb_trace_database_delete() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace the deletion of a database.
+ *
+ * \param builder       The builder describing the database.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_database_delete(
+    vcdb_builder_t* builder)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->database_delete(builder);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_DATABASE_DELETE, -1, retval, 0, timer);
+
+    return retval;
+}
@@ -0,0 +1,45 @@
+/**
+ * \file vcdb_trace_datastore_delete_range.c
+ *
+ * \brief Implementation of the vcdb_trace_datastore_delete_range() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace a datastore range delete.
+ *
+ * \param transaction   The transaction instance.
+ * \param datastore     The datastore to use.
+ * \param start         The first key in the range.
+ * \param start_size    The size of the first key.
+ * \param end           The key after the range.
+ * \param end_size      The size of the end key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_delete_range(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size)
+{
+    vcdb_trace_engine_t* trace =
+        vcdb_trace_engine_get(transaction->database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->datastore_delete_range(
+        transaction, datastore, start, start_size, end, end_size);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_DATASTORE_DELETE_RANGE,
+        datastore->correlation_id, retval,
+        VCDB_STATUS_SUCCESS == retval ? *start_size + *end_size : 0, timer);
+
+    return retval;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file vcdb_trace_datastore_get.c
+ *
+ * \brief Implementation of the vcdb_trace_datastore_get() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace a datastore get.
+ *
+ * \param database      The database instance.
+ * \param datastore     The datastore to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param value         The value buffer.
+ * \param value_size    The size of the value.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_datastore_get(
+    vcdb_database_t* database,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->datastore_get(
+        database, datastore, key, key_size, value, value_size);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_DATASTORE_GET,
+        datastore->correlation_id, retval,
+        VCDB_STATUS_SUCCESS == retval ? key_size + *value_size : 0, timer);
+
+    return retval;
+}
@@ -0,0 +1,45 @@
+/**
+ * \file vcdb_trace_engine_find.c
+ *
+ * \brief Implementation of the vcdb_trace_engine_find() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "trace_private.h"
+
+/**
+ * \brief Find a registered trace engine by name.
+ *
+ * \param engine        The name of the trace engine.
+ * \param trace         Pointer to receive the trace engine on success.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a trace engine.
+ */
+int vcdb_trace_engine_find(
+    const char* engine, vcdb_trace_engine_t** trace)
+{
+    MODEL_ASSERT(NULL != engine);
+    MODEL_ASSERT(NULL != trace);
+
+    vcdb_database_engine_t* eng = vcdb_database_engine_lookup(engine);
+    if (NULL == eng)
+    {
+        return VCDB_ERROR_MISSING_DATABASE_ENGINE;
+    }
+
+    /* only trace engines use the trace create method. */
+    if (&vcdb_trace_database_create != eng->database_create)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    *trace = (vcdb_trace_engine_t*)eng;
+
+    return VCDB_STATUS_SUCCESS;
+}
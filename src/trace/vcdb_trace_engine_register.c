@@ -0,0 +1,137 @@
+/**
+ * \file vcdb_trace_engine_register.c
+ *
+ * \brief Implementation of the vcdb_trace_engine_register() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcdb/engine.h>
+
+#include "trace_private.h"
+
+/**
+ * \brief Forward an optional engine method only if the inner engine has it,
+ * so the library falls back exactly as it would without tracing.
+ */
+#define VCDB_TRACE_FORWARD(method) \
+    if (NULL != inner->method) \
+    { \
+        trace->engine.method = &vcdb_trace_##method; \
+    }
+
+/**
+ * \brief Register the trace engine for a registered database engine.
+ *
+ * The trace engine is registered under VCDB_TRACE_ENGINE_PREFIX followed by
+ * the name of the inner engine, as in "trace:LMDB".  Trace engines are never
+ * registered implicitly, so applications which do not call this method don't
+ * link the trace engine.  Registering the same trace engine again does
+ * nothing.
+ *
+ * \param engine        The name of the inner engine, such as "LMDB".  It may
+ *                      itself be a registered trace engine.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the inner engine is not
+ *            found.
+ *          - VCDB_ERROR_BAD_MEMORY_ALLOCATION if the trace engine could not be
+ *            allocated or registered.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the target does not have lock free
+ *            64-bit atomics.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_trace_engine_register(
+    const char* engine)
+{
+    MODEL_ASSERT(NULL != engine);
+
+    /* parameter sanity check. */
+    if (NULL == engine)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+#if VCDB_TRACE_SUPPORTED
+    vcdb_database_engine_t* inner = vcdb_database_engine_lookup(engine);
+    if (NULL == inner)
+    {
+        return VCDB_ERROR_MISSING_DATABASE_ENGINE;
+    }
+
+    /* build the name of the trace engine. */
+    size_t prefix_size = strlen(VCDB_TRACE_ENGINE_PREFIX);
+    size_t engine_size = strlen(engine) + 1;
+    char* name = (char*)malloc(prefix_size + engine_size);
+    if (NULL == name)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    memcpy(name, VCDB_TRACE_ENGINE_PREFIX, prefix_size);
+    memcpy(name + prefix_size, engine, engine_size);
+
+    vcdb_trace_engine_t* trace =
+        (vcdb_trace_engine_t*)calloc(1, sizeof(vcdb_trace_engine_t));
+    if (NULL == trace)
+    {
+        free(name);
+
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    trace->inner = inner;
+    trace->slow_threshold = VCDB_TRACE_DEFAULT_SLOW_THRESHOLD;
+
+    /* every engine has these methods. */
+    trace->engine.database_create = &vcdb_trace_database_create;
+    trace->engine.database_open = &vcdb_trace_database_open;
+    trace->engine.database_close = &vcdb_trace_database_close;
+    trace->engine.database_delete = &vcdb_trace_database_delete;
+    trace->engine.datastore_get = &vcdb_trace_datastore_get;
+    trace->engine.index_get = &vcdb_trace_index_get;
+    trace->engine.transaction_begin = &vcdb_trace_transaction_begin;
+    trace->engine.transaction_commit = &vcdb_trace_transaction_commit;
+    trace->engine.transaction_rollback = &vcdb_trace_transaction_rollback;
+    trace->engine.datastore_put = &vcdb_trace_datastore_put;
+    trace->engine.datastore_delete = &vcdb_trace_datastore_delete;
+    trace->engine.index_delete = &vcdb_trace_index_delete;
+
+    /* the rest are optional. */
+    VCDB_TRACE_FORWARD(transaction_savepoint_set);
+    VCDB_TRACE_FORWARD(transaction_savepoint_rollback);
+    VCDB_TRACE_FORWARD(transaction_savepoint_release);
+    VCDB_TRACE_FORWARD(datastore_merge);
+    VCDB_TRACE_FORWARD(datastore_get_versioned);
+    VCDB_TRACE_FORWARD(datastore_put_if_version);
+    VCDB_TRACE_FORWARD(datastore_delete_range);
+    VCDB_TRACE_FORWARD(filter_load);
+    VCDB_TRACE_FORWARD(filter_save);
+    VCDB_TRACE_FORWARD(datastore_contains);
+    VCDB_TRACE_FORWARD(index_contains);
+    VCDB_TRACE_FORWARD(index_get_primary_key);
+    VCDB_TRACE_FORWARD(index_projection_put);
+    VCDB_TRACE_FORWARD(index_get_projection);
+
+    vcdb_database_engine_register(&trace->engine, name);
+
+    /* the first registration of this name wins. */
+    vcdb_database_engine_t* registered = vcdb_database_engine_lookup(name);
+    free(name);
+    if (registered != &trace->engine)
+    {
+        free(trace);
+
+        return NULL == registered
+            ? VCDB_ERROR_BAD_MEMORY_ALLOCATION
+            : VCDB_STATUS_SUCCESS;
+    }
+
+    return VCDB_STATUS_SUCCESS;
+#else
+    return VCDB_ERROR_NOT_SUPPORTED;
+#endif
+}
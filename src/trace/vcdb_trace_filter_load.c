@@ -0,0 +1,39 @@
+/**
+ * \file vcdb_trace_filter_load.c
+ *
+ * \brief Implementation of the vcdb_trace_filter_load() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace the loading of a negative-lookup filter.
+ *
+ * \param database      The database instance.
+ * \param correlation_id The correlation ID of the filter.
+ * \param data          The filter buffer.
+ * \param size          The size of the filter.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_filter_load(
+    vcdb_database_t* database,
+    int correlation_id,
+    void* data,
+    size_t* size)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->filter_load(
+        database, correlation_id, data, size);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_FILTER_LOAD, correlation_id, retval,
+        VCDB_STATUS_SUCCESS == retval ? *size : 0, timer);
+
+    return retval;
+}
@@ -0,0 +1,38 @@
+/**
+ * \file vcdb_trace_index_contains.c
+ *
+ * \brief Implementation of the vcdb_trace_index_contains() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace a secondary index membership check.
+ *
+ * \param database      The database instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_contains(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->index_contains(database, index, key, key_size);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_INDEX_CONTAINS, index->correlation_id, retval,
+        VCDB_STATUS_SUCCESS == retval ? key_size : 0, timer);
+
+    return retval;
+}
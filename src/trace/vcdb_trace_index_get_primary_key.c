@@ -0,0 +1,45 @@
+/**
+ * \file vcdb_trace_index_get_primary_key.c
+ *
+ * \brief Implementation of the vcdb_trace_index_get_primary_key() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace a secondary index primary key lookup.
+ *
+ * \param database      The database instance.
+ * \param index         The secondary index to use.
+ * \param key           The key.
+ * \param key_size      The size of the key.
+ * \param primary_key   The primary key buffer.
+ * \param primary_key_size The size of the primary key.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_index_get_primary_key(
+    vcdb_database_t* database,
+    vcdb_index_t* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->index_get_primary_key(
+        database, index, key, key_size, primary_key, primary_key_size);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_INDEX_GET_PRIMARY_KEY,
+        index->correlation_id, retval,
+        VCDB_STATUS_SUCCESS == retval ? key_size + *primary_key_size : 0,
+        timer);
+
+    return retval;
+}
@@ -0,0 +1,88 @@
+/**
+ * \file vcdb_trace_record.c
+ *
+ * \brief Implementation of the vcdb_trace_record() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Record a call forwarded to the inner engine.
+ *
+ * \param trace         The trace engine.
+ * \param method        The engine method.
+ * \param correlation_id The correlation ID of the datastore or index, or -1.
+ * \param status        The status code returned by the inner engine.
+ * \param bytes         The number of key and value bytes in the call.
+ * \param start         The time at which the call was forwarded.
+ */
+void vcdb_trace_record(
+    vcdb_trace_engine_t* trace, vcdb_trace_method_t method,
+    int correlation_id, int status, uint64_t bytes, uint64_t start)
+{
+    MODEL_ASSERT(NULL != trace);
+    MODEL_ASSERT(method < VCDB_TRACE_METHOD_COUNT);
+
+#if VCDB_TRACE_SUPPORTED
+    uint64_t now = vcdb_latency_clock_monotonic();
+    uint64_t elapsed = now > start ? now - start : 0;
+    vcdb_trace_counters_t* c = &trace->counters[method];
+
+    atomic_fetch_add_explicit(&c->calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->total_time, elapsed, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->bytes, bytes, memory_order_relaxed);
+
+    /* not found and truncation are normal results, not errors. */
+    if (VCDB_ERROR_VALUE_NOT_FOUND == status)
+    {
+        atomic_fetch_add_explicit(&c->not_found, 1, memory_order_relaxed);
+    }
+    else if (VCDB_ERROR_WOULD_TRUNCATE == status)
+    {
+        atomic_fetch_add_explicit(
+            &c->would_truncate, 1, memory_order_relaxed);
+    }
+    else if (VCDB_STATUS_SUCCESS != status)
+    {
+        atomic_fetch_add_explicit(&c->errors, 1, memory_order_relaxed);
+        atomic_store_explicit(&c->last_error, status, memory_order_relaxed);
+    }
+
+    uint64_t max = atomic_load_explicit(&c->max_time, memory_order_relaxed);
+    while (elapsed > max
+        && !atomic_compare_exchange_weak_explicit(
+                &c->max_time, &max, elapsed,
+                memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+
+    /* sample slow calls into the ring. */
+    if (elapsed > atomic_load_explicit(
+                    &trace->slow_threshold, memory_order_relaxed))
+    {
+        uint64_t next = atomic_fetch_add_explicit(
+            &trace->sample_next, 1, memory_order_relaxed);
+        vcdb_trace_sample_slot_t* slot =
+            &trace->samples[next % VCDB_TRACE_SAMPLES];
+
+        atomic_store_explicit(&slot->method, method, memory_order_relaxed);
+        atomic_store_explicit(
+            &slot->correlation_id, correlation_id, memory_order_relaxed);
+        atomic_store_explicit(&slot->status, status, memory_order_relaxed);
+        atomic_store_explicit(&slot->elapsed, elapsed, memory_order_relaxed);
+        atomic_store_explicit(&slot->bytes, bytes, memory_order_relaxed);
+    }
+#else
+    (void)trace;
+    (void)method;
+    (void)correlation_id;
+    (void)status;
+    (void)bytes;
+    (void)start;
+#endif
+}
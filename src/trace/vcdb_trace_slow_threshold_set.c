@@ -0,0 +1,58 @@
+/**
+ * \file vcdb_trace_slow_threshold_set.c
+ *
+ * \brief Implementation of the vcdb_trace_slow_threshold_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "trace_private.h"
+
+/**
+ * \brief Set the threshold above which a trace engine samples a call.
+ *
+ * \param engine        The name of the trace engine, such as "trace:LMDB".
+ * \param threshold     The threshold in nanoseconds.  Calls which take longer
+ *                      are sampled.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a trace engine.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_trace_slow_threshold_set(
+    const char* engine,
+    uint64_t threshold)
+{
+    MODEL_ASSERT(NULL != engine);
+
+    /* parameter sanity check. */
+    if (NULL == engine)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_trace_engine_t* trace;
+    int retval = vcdb_trace_engine_find(engine, &trace);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+#if VCDB_TRACE_SUPPORTED
+    atomic_store_explicit(
+        &trace->slow_threshold, threshold, memory_order_relaxed);
+
+    return VCDB_STATUS_SUCCESS;
+#else
+    /* no trace engine can be registered on such targets. */
+    (void)trace;
+    (void)threshold;
+
+    return VCDB_ERROR_NOT_SUPPORTED;
+#endif
+}
@@ -0,0 +1,102 @@
+/**
+ * \file vcdb_trace_snapshot.c
+ *
+ * \brief Implementation of the vcdb_trace_snapshot() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vpr/parameters.h>
+
+#include "trace_private.h"
+
+/**
+ * \brief Take a snapshot of what a trace engine has recorded.
+ *
+ * Totals are kept for the life of the process, across every database using
+ * the trace engine.
+ *
+ * \param engine        The name of the trace engine, such as "trace:LMDB".
+ * \param snapshot      The snapshot to fill in.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_MISSING_DATABASE_ENGINE if the engine is not found.
+ *          - VCDB_ERROR_INVALID_PARAMETER if the engine is not a trace engine.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_trace_snapshot(
+    const char* engine,
+    vcdb_trace_snapshot_t* snapshot)
+{
+    MODEL_ASSERT(NULL != engine);
+    MODEL_ASSERT(NULL != snapshot);
+
+    /* parameter sanity check. */
+    if (NULL == engine || NULL == snapshot)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    vcdb_trace_engine_t* trace;
+    int retval = vcdb_trace_engine_find(engine, &trace);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+#if VCDB_TRACE_SUPPORTED
+    memset(snapshot, 0, sizeof(vcdb_trace_snapshot_t));
+
+    for (size_t i = 0; i < VCDB_TRACE_METHOD_COUNT; ++i)
+    {
+        vcdb_trace_counters_t* c = &trace->counters[i];
+        vcdb_trace_method_stats_t* m = &snapshot->methods[i];
+
+        m->calls = atomic_load_explicit(&c->calls, memory_order_relaxed);
+        m->errors = atomic_load_explicit(&c->errors, memory_order_relaxed);
+        m->not_found =
+            atomic_load_explicit(&c->not_found, memory_order_relaxed);
+        m->would_truncate =
+            atomic_load_explicit(&c->would_truncate, memory_order_relaxed);
+        m->last_error =
+            atomic_load_explicit(&c->last_error, memory_order_relaxed);
+        m->total_time =
+            atomic_load_explicit(&c->total_time, memory_order_relaxed);
+        m->max_time =
+            atomic_load_explicit(&c->max_time, memory_order_relaxed);
+        m->bytes = atomic_load_explicit(&c->bytes, memory_order_relaxed);
+    }
+
+    /* copy the most recent samples, oldest first. */
+    uint64_t next =
+        atomic_load_explicit(&trace->sample_next, memory_order_relaxed);
+    uint64_t count = next < VCDB_TRACE_SAMPLES ? next : VCDB_TRACE_SAMPLES;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        vcdb_trace_sample_slot_t* slot =
+            &trace->samples[(next - count + i) % VCDB_TRACE_SAMPLES];
+        vcdb_trace_sample_t* s = &snapshot->samples[i];
+
+        s->method = (vcdb_trace_method_t)
+            atomic_load_explicit(&slot->method, memory_order_relaxed);
+        s->correlation_id =
+            atomic_load_explicit(&slot->correlation_id, memory_order_relaxed);
+        s->status = atomic_load_explicit(&slot->status, memory_order_relaxed);
+        s->elapsed =
+            atomic_load_explicit(&slot->elapsed, memory_order_relaxed);
+        s->bytes = atomic_load_explicit(&slot->bytes, memory_order_relaxed);
+    }
+
+    snapshot->sample_count = (size_t)count;
+
+    return VCDB_STATUS_SUCCESS;
+#else
+    /* no trace engine can be registered on such targets. */
+    (void)trace;
+
+    return VCDB_ERROR_NOT_SUPPORTED;
+#endif
+}
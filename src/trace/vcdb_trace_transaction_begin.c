@@ -0,0 +1,33 @@
+/**
+ * \file vcdb_trace_transaction_begin.c
+ *
+ * \brief Implementation of the vcdb_trace_transaction_begin() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace the beginning of a transaction.
+ *
+ * \param transaction   The transaction instance.
+ * \param database      The database instance.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_begin(
+    vcdb_transaction_t* transaction,
+    vcdb_database_t* database)
+{
+    vcdb_trace_engine_t* trace = vcdb_trace_engine_get(database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->transaction_begin(transaction, database);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_TRANSACTION_BEGIN, -1, retval, 0, timer);
+
+    return retval;
+}
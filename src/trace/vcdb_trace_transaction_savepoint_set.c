@@ -0,0 +1,36 @@
+/**
+ * \file vcdb_trace_transaction_savepoint_set.c
+ *
+ * \brief Implementation of the vcdb_trace_transaction_savepoint_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "../latency/latency_private.h"
+#include "trace_private.h"
+
+/**
+ * \brief Trace the marking of a savepoint.
+ *
+ * \param transaction   The transaction instance.
+ * \param savepoint     The savepoint.
+ *
+ * \returns the status code returned by the inner engine.
+ */
+int vcdb_trace_transaction_savepoint_set(
+    vcdb_transaction_t* transaction,
+    vcdb_transaction_savepoint_t* savepoint)
+{
+    vcdb_trace_engine_t* trace =
+        vcdb_trace_engine_get(transaction->database->builder);
+    uint64_t timer = vcdb_latency_clock_monotonic();
+
+    int retval = trace->inner->transaction_savepoint_set(
+        transaction, savepoint);
+
+    vcdb_trace_record(
+        trace, VCDB_TRACE_METHOD_TRANSACTION_SAVEPOINT_SET, -1, retval,
+        0, timer);
+
+    return retval;
+}
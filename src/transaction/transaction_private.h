@@ -0,0 +1,137 @@
+/**
+ * \file transaction_private.h
+ *
+ * \brief Private details for the transaction interface.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef VCDB_TRANSACTION_PRIVATE_HEADER_GUARD
+#define VCDB_TRANSACTION_PRIVATE_HEADER_GUARD
+
+#include <vcdb/hooks.h>
+#include <vcdb/transaction.h>
+
+#include "../cache/cache_private.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  //__cplusplus
+
+/**
+ * \brief The number of cache keys to allocate by default.
+ */
+#define VCDB_TRANSACTION_CACHE_KEYS_DEFAULT_SIZE 16
+
+/**
+ * \brief A key written to a cached datastore during a transaction.
+ */
+typedef struct vcdb_transaction_cache_key
+{
+    /**
+     * \brief The cache holding this key.
+     */
+    vcdb_cache_t* cache;
+
+    /**
+     * \brief The size of the key, or 0 if the whole cache is invalidated.
+     */
+    size_t key_size;
+
+    /**
+     * \brief The key.
+     */
+    uint8_t key[VCDB_CACHE_MAX_KEY_SIZE];
+
+} vcdb_transaction_cache_key_t;
+
+/**
+ * \brief Record that a key in a datastore is written by a transaction.
+ *
+ * If the datastore is cached, the key is invalidated in the cache when the
+ * transaction commits.  This must be called before the engine performs the
+ * write, so that a failure to record the key fails the write.
+ *
+ * \param transaction   The transaction performing the write.
+ * \param datastore     The datastore being written.
+ * \param key           The key being written, or NULL if any key in the
+ *                      datastore may be written.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_transaction_cache_touch(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    const void* key, size_t key_size);
+
+/**
+ * \brief Invalidate every key written by a committed transaction, and release
+ * the list of written keys.
+ *
+ * \param transaction   The committed transaction.
+ */
+void vcdb_transaction_cache_invalidate(
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Release the list of keys written by a transaction.
+ *
+ * \param transaction   The transaction whose key list is released.
+ */
+void vcdb_transaction_cache_release(
+    vcdb_transaction_t* transaction);
+
+/**
+ * \brief Put a value into a datastore, optionally only if the version of the
+ * stored value matches.
+ *
+ * This is the shared body of vcdb_database_datastore_put() and
+ * vcdb_database_datastore_put_if_version().  The caller has already checked
+ * its parameters, the transaction, and engine support.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      NULL to put the value unconditionally.
+ * \param hooks         The hooks to run around the put once its key is
+ *                      known, or NULL.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_transaction_datastore_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    void* value, size_t value_size, const vcdb_version_t* version,
+    vcdb_hooks_t* hooks);
+
+/**
+ * \brief Store the projections of a value in the covering indexes of its
+ * datastore.
+ *
+ * This is called after the engine has put the value.  It does nothing if the
+ * engine does not store projections.
+ *
+ * \param transaction   The transaction performing the write.
+ * \param datastore     The datastore being written.
+ * \param value         The value being written.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_transaction_projections_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    const void* value);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  //__cplusplus
+
+#endif /*VCDB_TRANSACTION_PRIVATE_HEADER_GUARD*/
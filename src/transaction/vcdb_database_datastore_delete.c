@@ -10,6 +10,18 @@
 #include <vcdb/transaction.h>
 #include <vpr/parameters.h>
 
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/* forward decls */
+static int vcdb_database_datastore_delete_unhooked(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size);
+
 /**
  * \brief Delete values matching the given key in the given datastore.
  *
@@ -27,6 +39,48 @@ int vcdb_database_datastore_delete(
     vcdb_datastore_t* datastore,
     void* key,
     size_t* key_size)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_database_datastore_delete_unhooked(
+            transaction, datastore, key, key_size);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(
+        hooks, &event, VCDB_HOOK_DATASTORE_DELETE,
+        NULL == datastore ? NULL : datastore->name,
+        NULL == key_size ? 0 : *key_size, 0);
+
+    int retval = vcdb_database_datastore_delete_unhooked(
+        transaction, datastore, key, key_size);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_database_datastore_delete(), run with or
+ * without hooks.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to use when deleting.
+ * \param key           The key to delete.
+ * \param key_size      The size of the key to delete.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+static int vcdb_database_datastore_delete_unhooked(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size)
 {
     MODEL_ASSERT(NULL != transaction);
     MODEL_ASSERT(NULL != datastore);
@@ -46,7 +100,27 @@ int vcdb_database_datastore_delete(
         return VCDB_ERROR_BAD_TRANSACTION;
     }
 
+    /* the cached value for this key is stale once the transaction commits. */
+    int retval = vcdb_transaction_cache_touch(
+        transaction, datastore, key, *key_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
     /* delete the key using the engine method. */
-    return transaction->database->builder->engine->datastore_delete(
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
+    retval = transaction->database->builder->engine->datastore_delete(
         transaction, datastore, key, key_size);
+    vcdb_latency_record(
+        transaction->database->latency, datastore->correlation_id,
+        VCDB_DATABASE_METHOD_DELETE, timer);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        vcdb_stats_add(
+            transaction->database->stats, datastore->correlation_id,
+            VCDB_STATS_DELETES, 1);
+    }
+
+    return retval;
 }
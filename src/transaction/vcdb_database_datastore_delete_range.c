@@ -0,0 +1,117 @@
+/**
+ * \file vcdb_database_datastore_delete_range.c
+ *
+ * \brief Implementation of the vcdb_database_datastore_delete_range() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/**
+ * \brief Delete all values whose keys fall in the half-open range [start, end)
+ * in the given datastore.
+ *
+ * Keys are compared using the engine's key ordering.  The engine performs the
+ * delete as a single range operation, so pruning a large contiguous range of
+ * keys does not require a delete per key.  Range deletes are not available
+ * for datastores with indexes, because the secondary keys of the deleted
+ * values are not known.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to use when deleting.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support range
+ *            deletes, or if the datastore has an index.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_delete_range(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size)
+{
+    MODEL_ASSERT(NULL != transaction);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != start);
+    MODEL_ASSERT(NULL != start_size);
+    MODEL_ASSERT(0 != *start_size);
+    MODEL_ASSERT(NULL != end);
+    MODEL_ASSERT(NULL != end_size);
+    MODEL_ASSERT(0 != *end_size);
+
+    /* parameter sanity check. */
+    if (NULL == transaction || NULL == datastore
+     || NULL == start || NULL == start_size || 0 == *start_size
+     || NULL == end || NULL == end_size || 0 == *end_size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* make sure we are in a transaction. */
+    if (!transaction->in_transaction)
+    {
+        return VCDB_ERROR_BAD_TRANSACTION;
+    }
+
+    /* range delete is optional for engines. */
+    vcdb_database_engine_t* engine = transaction->database->builder->engine;
+    if (NULL == engine->datastore_delete_range)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    /* index entries can't be dropped without the deleted values. */
+    vcdb_index_t* const* indexes;
+    size_t count;
+    int retval =
+        vcdb_builder_datastore_indexes_get(
+            transaction->database->builder, datastore, &indexes, &count);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (count > 0)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    /* any cached value in this datastore may be stale once the transaction
+     * commits. */
+    retval = vcdb_transaction_cache_touch(transaction, datastore, NULL, 0);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* drop the range using the engine method. */
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
+    retval = engine->datastore_delete_range(
+        transaction, datastore, start, start_size, end, end_size);
+    vcdb_latency_record(
+        transaction->database->latency, datastore->correlation_id,
+        VCDB_DATABASE_METHOD_DELETE_RANGE, timer);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        vcdb_stats_add(
+            transaction->database->stats, datastore->correlation_id,
+            VCDB_STATS_DELETES, 1);
+    }
+
+    return retval;
+}
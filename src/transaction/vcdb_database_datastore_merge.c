@@ -0,0 +1,131 @@
+/**
+ * \file vcdb_database_datastore_merge.c
+ *
+ * \brief Implementation of the vcdb_database_datastore_merge() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+#include "../database/database_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/**
+ * \brief Record a merge operand for a value in the datastore using the given
+ * transaction.
+ *
+ * The current value is not read.  The operand is folded into the stored value
+ * by the datastore's value_merger method when the engine next reads or
+ * compacts the value, so read-modify-write updates such as counters become
+ * blind writes.
+ *
+ * Merge is not available for datastores with indexes, because secondary keys
+ * and the projections of covering indexes are only written when a whole value
+ * is put.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to merge the operand into.  It must have
+ *                      a value_merger method.
+ * \param key           The key of the value to update.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support merge,
+ *            or if the datastore has an index.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_merge(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size)
+{
+    MODEL_ASSERT(NULL != transaction);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != datastore->value_merger);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != key_size);
+    MODEL_ASSERT(0 != *key_size);
+    MODEL_ASSERT(NULL != operand);
+    MODEL_ASSERT(NULL != operand_size);
+    MODEL_ASSERT(0 != *operand_size);
+
+    /* parameter sanity check. */
+    if (NULL == transaction || NULL == datastore
+     || NULL == datastore->value_merger
+     || NULL == key || NULL == key_size || 0 == *key_size
+     || NULL == operand || NULL == operand_size || 0 == *operand_size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* make sure we are in a transaction. */
+    if (!transaction->in_transaction)
+    {
+        return VCDB_ERROR_BAD_TRANSACTION;
+    }
+
+    /* merge is optional for engines. */
+    vcdb_database_engine_t* engine = transaction->database->builder->engine;
+    if (NULL == engine->datastore_merge)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    /* index entries can't be refreshed without the merged value. */
+    vcdb_index_t* const* indexes;
+    size_t count;
+    int retval =
+        vcdb_builder_datastore_indexes_get(
+            transaction->database->builder, datastore, &indexes, &count);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (count > 0)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    /* the cached value for this key is stale once the transaction commits. */
+    retval = vcdb_transaction_cache_touch(
+        transaction, datastore, key, *key_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* readers must not filter out this key once it is visible. */
+    vcdb_database_filter_add_value(
+        transaction->database, datastore, key, *key_size, NULL);
+
+    /* record the operand using the engine method. */
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
+    retval = engine->datastore_merge(
+        transaction, datastore, key, key_size, operand, operand_size);
+    vcdb_latency_record(
+        transaction->database->latency, datastore->correlation_id,
+        VCDB_DATABASE_METHOD_MERGE, timer);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        vcdb_stats_add(
+            transaction->database->stats, datastore->correlation_id,
+            VCDB_STATS_PUTS, 1);
+        vcdb_stats_add(
+            transaction->database->stats, datastore->correlation_id,
+            VCDB_STATS_BYTES_SERIALIZED, *operand_size);
+    }
+
+    return retval;
+}
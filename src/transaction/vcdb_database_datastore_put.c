@@ -10,10 +10,15 @@
 #include <vcdb/transaction.h>
 #include <vpr/parameters.h>
 
-/* set a sane default for allocation. */
-#ifndef VCDB_DATABASE_DATASTORE_PUT_DEFAULT_SERIALIZATION_BUFFER_SIZE
-#define VCDB_DATABASE_DATASTORE_PUT_DEFAULT_SERIALIZATION_BUFFER_SIZE 1024
-#endif
+#include "../hooks/hooks_private.h"
+#include "transaction_private.h"
+
+/* forward decls */
+static int vcdb_database_datastore_put_rejected(
+    vcdb_hooks_t* hooks,
+    vcdb_datastore_t* datastore,
+    size_t* value_size,
+    int retval);
 
 /**
  * \brief Put a value into the datastore using the given transaction.
@@ -35,7 +40,7 @@ int vcdb_database_datastore_put(
     void* value,
     size_t* value_size)
 {
-    int retval;
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
 
     MODEL_ASSERT(NULL != transaction);
     MODEL_ASSERT(NULL != datastore);
@@ -46,68 +51,51 @@ int vcdb_database_datastore_put(
     /* parameter sanity check. */
     if (NULL == transaction || NULL == datastore || NULL == value || NULL == value_size || 0 == *value_size)
     {
-        return VCDB_ERROR_INVALID_PARAMETER;
+        return vcdb_database_datastore_put_rejected(
+            hooks, datastore, value_size, VCDB_ERROR_INVALID_PARAMETER);
     }
 
     /* make sure we are in a transaction. */
     if (!transaction->in_transaction)
     {
-        return VCDB_ERROR_BAD_TRANSACTION;
-    }
-
-    /* get the key from the value. */
-    char key[VCDB_MAX_KEY_SIZE];
-    size_t key_size = sizeof(key);
-    datastore->key_getter(value, key, &key_size);
-
-    /* allocate a sane default serialization buffer. */
-    size_t allocation_size =
-        VCDB_DATABASE_DATASTORE_PUT_DEFAULT_SERIALIZATION_BUFFER_SIZE;
-    void* serialized_value = malloc(allocation_size);
-    if (NULL == serialized_value)
-    {
-        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+        return vcdb_database_datastore_put_rejected(
+            hooks, datastore, value_size, VCDB_ERROR_BAD_TRANSACTION);
     }
 
-    /* serialize the value data. */
-    retval =
-        datastore->value_writer(value, serialized_value, &allocation_size);
-    if (VCDB_ERROR_WOULD_TRUNCATE == retval)
-    {
-        /* reallocate a larger buffer. */
-        void* newval = realloc(serialized_value, allocation_size);
-        if (NULL == newval)
-        {
-            retval = VCDB_ERROR_BAD_MEMORY_ALLOCATION;
-            goto cleanup_serial_buffer;
-        }
-
-        /* update the serial buffer. */
-        serialized_value = newval;
-
-        /* attempt serialization with the larger buffer. */
-        retval =
-            datastore->value_writer(value, serialized_value, &allocation_size);
-        if (VCDB_STATUS_SUCCESS != retval)
-        {
-            goto cleanup_serial_buffer;
-        }
-    }
+    /* the hooks run once the key is known, so they see its size. */
+    return vcdb_transaction_datastore_put(
+        transaction, datastore, value, *value_size, NULL, hooks);
+}
 
-    /* if serialization fails, then clean up. */
-    if (VCDB_STATUS_SUCCESS != retval)
+/**
+ * \brief Report a put rejected before its key was extracted to the hooks.
+ *
+ * The key is not known, so the hooks see a key size of 0.
+ *
+ * \param hooks         The registered hooks, or NULL.
+ * \param datastore     The datastore passed to the put, or NULL.
+ * \param value_size    The value size passed to the put, or NULL.
+ * \param retval        The status code the put fails with.
+ *
+ * \returns retval.
+ */
+static int vcdb_database_datastore_put_rejected(
+    vcdb_hooks_t* hooks,
+    vcdb_datastore_t* datastore,
+    size_t* value_size,
+    int retval)
+{
+    if (NULL == hooks)
     {
-        goto cleanup_serial_buffer;
+        return retval;
     }
 
-    /* Put key and serialized value. */
-    retval =
-        transaction->database->builder->engine->datastore_put(
-            transaction, datastore, key, &key_size,
-            serialized_value, &allocation_size);
-
-cleanup_serial_buffer:
-    free(serialized_value);
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(
+        hooks, &event, VCDB_HOOK_DATASTORE_PUT,
+        NULL == datastore ? NULL : datastore->name, 0,
+        NULL == value_size ? 0 : *value_size);
+    vcdb_hooks_end(hooks, &event, retval);
 
     return retval;
 }
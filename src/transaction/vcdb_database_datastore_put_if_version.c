@@ -0,0 +1,72 @@
+/**
+ * \file vcdb_database_datastore_put_if_version.c
+ *
+ * \brief Implementation of the vcdb_database_datastore_put_if_version() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+#include "transaction_private.h"
+
+/**
+ * \brief Put a value into the datastore only if the stored value has not
+ * changed since it was read.
+ *
+ * The engine atomically compares the version token of the stored value with
+ * the expected version and only writes the value if they match.  This allows
+ * a value to be read with vcdb_database_datastore_get_versioned() outside of a
+ * transaction, updated, and written back with a short-lived transaction.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      VCDB_VERSION_NONE if the key must not have a value.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VERSION_MISMATCH if the stored version differs.
+ *          - VCDB_ERROR_NOT_SUPPORTED if the engine does not support
+ *            versioned writes.
+ *          - a non-zero failure code on failure.
+ */
+int vcdb_database_datastore_put_if_version(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t version)
+{
+    MODEL_ASSERT(NULL != transaction);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != value);
+    MODEL_ASSERT(NULL != value_size);
+    MODEL_ASSERT(0 != *value_size);
+
+    /* parameter sanity check. */
+    if (NULL == transaction || NULL == datastore || NULL == value || NULL == value_size || 0 == *value_size)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* make sure we are in a transaction. */
+    if (!transaction->in_transaction)
+    {
+        return VCDB_ERROR_BAD_TRANSACTION;
+    }
+
+    /* versioned writes are optional for engines. */
+    vcdb_database_engine_t* engine = transaction->database->builder->engine;
+    if (NULL == engine->datastore_put_if_version)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    return vcdb_transaction_datastore_put(
+        transaction, datastore, value, *value_size, &version, NULL);
+}
@@ -10,6 +10,18 @@
 #include <vcdb/transaction.h>
 #include <vpr/parameters.h>
 
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/* forward decls */
+static int vcdb_database_index_delete_unhooked(
+    vcdb_transaction_t* transaction,
+    vcdb_index_t* index,
+    void* key,
+    size_t* key_size);
+
 /**
  * \brief Delete values matching the given key in the given secondary index.
  *
@@ -27,6 +39,47 @@ int vcdb_database_index_delete(
     vcdb_index_t* index,
     void* key,
     size_t* key_size)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_database_index_delete_unhooked(
+            transaction, index, key, key_size);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(
+        hooks, &event, VCDB_HOOK_INDEX_DELETE,
+        NULL == index ? NULL : index->name,
+        NULL == key_size ? 0 : *key_size, 0);
+
+    int retval = vcdb_database_index_delete_unhooked(
+        transaction, index, key, key_size);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_database_index_delete(), run with or without hooks.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param index         The secondary index to use when deleting.
+ * \param key           The key to delete.
+ * \param key_size      The size of the key to delete.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+static int vcdb_database_index_delete_unhooked(
+    vcdb_transaction_t* transaction,
+    vcdb_index_t* index,
+    void* key,
+    size_t* key_size)
 {
     MODEL_ASSERT(NULL != transaction);
     MODEL_ASSERT(NULL != index);
@@ -46,7 +99,29 @@ int vcdb_database_index_delete(
         return VCDB_ERROR_BAD_TRANSACTION;
     }
 
+    /* the primary keys of the deleted values are not known, so any cached
+     * value in the index's datastore may be stale once the transaction
+     * commits. */
+    int retval = vcdb_transaction_cache_touch(
+        transaction, index->datastore, NULL, 0);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
     /* delete the key using the engine method. */
-    return transaction->database->builder->engine->index_delete(
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
+    retval = transaction->database->builder->engine->index_delete(
         transaction, index, key, key_size);
+    vcdb_latency_record(
+        transaction->database->latency, index->correlation_id,
+        VCDB_DATABASE_METHOD_INDEX_DELETE, timer);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        vcdb_stats_add(
+            transaction->database->stats, index->correlation_id,
+            VCDB_STATS_DELETES, 1);
+    }
+
+    return retval;
 }
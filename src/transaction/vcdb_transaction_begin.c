@@ -10,7 +10,15 @@
 #include <vcdb/transaction.h>
 #include <vpr/parameters.h>
 
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "transaction_private.h"
+
+/* forward decls */
 static void vcdb_transaction_dispose(void* disposable);
+static int vcdb_transaction_begin_unhooked(
+    vcdb_transaction_t* transaction,
+    vcdb_database_t* database);
 
 /**
  * \brief Begin a transaction using the given database.
@@ -27,6 +35,40 @@ static void vcdb_transaction_dispose(void* disposable);
 int vcdb_transaction_begin(
     vcdb_transaction_t* transaction,
     vcdb_database_t* database)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_transaction_begin_unhooked(transaction, database);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(hooks, &event, VCDB_HOOK_TRANSACTION_BEGIN, NULL, 0, 0);
+
+    int retval = vcdb_transaction_begin_unhooked(transaction, database);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_transaction_begin(), run with or without hooks.
+ *
+ * The database must stay in scope as long as the transaction is in scope.
+ *
+ * \param transaction   The transaction instance to create.
+ * \param database      The database backing this transaction.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+static int vcdb_transaction_begin_unhooked(
+    vcdb_transaction_t* transaction,
+    vcdb_database_t* database)
 {
     MODEL_ASSERT(NULL != transaction);
     MODEL_ASSERT(NULL != database);
@@ -40,10 +82,16 @@ int vcdb_transaction_begin(
     /* transaction is disposable. */
     transaction->hdr.dispose = &vcdb_transaction_dispose;
     transaction->database = database;
+    transaction->cache_keys = NULL;
+    transaction->cache_keys_size = 0;
+    transaction->cache_keys_max = 0;
 
     /* engine-specific setup */
+    uint64_t timer = vcdb_latency_start(database->latency);
     int retval =
         database->builder->engine->transaction_begin(transaction, database);
+    vcdb_latency_record(
+        database->latency, -1, VCDB_DATABASE_METHOD_BEGIN, timer);
     if (retval == VCDB_STATUS_SUCCESS)
     {
         transaction->in_transaction = true;
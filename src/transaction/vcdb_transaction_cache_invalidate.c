@@ -0,0 +1,38 @@
+/**
+ * \file vcdb_transaction_cache_invalidate.c
+ *
+ * \brief Implementation of the vcdb_transaction_cache_invalidate() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "transaction_private.h"
+
+/**
+ * \brief Invalidate every key written by a committed transaction, and release
+ * the list of written keys.
+ *
+ * \param transaction   The committed transaction.
+ */
+void vcdb_transaction_cache_invalidate(
+    vcdb_transaction_t* transaction)
+{
+    MODEL_ASSERT(NULL != transaction);
+
+    for (size_t i = 0; i < transaction->cache_keys_size; ++i)
+    {
+        vcdb_transaction_cache_key_t* entry = &transaction->cache_keys[i];
+        if (0 == entry->key_size)
+        {
+            vcdb_cache_clear(entry->cache);
+        }
+        else
+        {
+            vcdb_cache_invalidate(entry->cache, entry->key, entry->key_size);
+        }
+    }
+
+    vcdb_transaction_cache_release(transaction);
+}
@@ -0,0 +1,28 @@
+/**
+ * \file vcdb_transaction_cache_release.c
+ *
+ * \brief Implementation of the vcdb_transaction_cache_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "transaction_private.h"
+
+/**
+ * \brief Release the list of keys written by a transaction.
+ *
+ * \param transaction   The transaction whose key list is released.
+ */
+void vcdb_transaction_cache_release(
+    vcdb_transaction_t* transaction)
+{
+    MODEL_ASSERT(NULL != transaction);
+
+    vcdb_builder_memory_release(
+        transaction->database->builder, transaction->cache_keys);
+    transaction->cache_keys = NULL;
+    transaction->cache_keys_size = 0;
+    transaction->cache_keys_max = 0;
+}
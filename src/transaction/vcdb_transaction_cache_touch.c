@@ -0,0 +1,78 @@
+/**
+ * \file vcdb_transaction_cache_touch.c
+ *
+ * \brief Implementation of the vcdb_transaction_cache_touch() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "../database/database_private.h"
+#include "transaction_private.h"
+
+/**
+ * \brief Record that a key in a datastore is written by a transaction.
+ *
+ * If the datastore is cached, the key is invalidated in the cache when the
+ * transaction commits.  This must be called before the engine performs the
+ * write, so that a failure to record the key fails the write.
+ *
+ * \param transaction   The transaction performing the write.
+ * \param datastore     The datastore being written.
+ * \param key           The key being written, or NULL if any key in the
+ *                      datastore may be written.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_transaction_cache_touch(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    const void* key, size_t key_size)
+{
+    MODEL_ASSERT(NULL != transaction);
+    MODEL_ASSERT(NULL != datastore);
+
+    /* nothing to do for uncached datastores or keys too long to cache. */
+    vcdb_cache_t* cache =
+        vcdb_database_cache_find(transaction->database, datastore);
+    if (NULL == cache || (NULL != key && key_size > VCDB_CACHE_MAX_KEY_SIZE))
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    /* grow the key list if needed. */
+    if (transaction->cache_keys_size == transaction->cache_keys_max)
+    {
+        size_t newmax =
+            (0 == transaction->cache_keys_max)
+                ? VCDB_TRANSACTION_CACHE_KEYS_DEFAULT_SIZE
+                : 2 * transaction->cache_keys_max;
+        void* newdata = vcdb_builder_memory_reallocate(
+            transaction->database->builder, transaction->cache_keys,
+            transaction->cache_keys_max * sizeof(vcdb_transaction_cache_key_t),
+            newmax * sizeof(vcdb_transaction_cache_key_t));
+        if (NULL == newdata)
+        {
+            return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+        }
+
+        transaction->cache_keys = (vcdb_transaction_cache_key_t*)newdata;
+        transaction->cache_keys_max = newmax;
+    }
+
+    /* record the key. */
+    vcdb_transaction_cache_key_t* entry =
+        &transaction->cache_keys[transaction->cache_keys_size++];
+    entry->cache = cache;
+    entry->key_size = (NULL == key) ? 0 : key_size;
+    if (NULL != key)
+    {
+        memcpy(entry->key, key, key_size);
+    }
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -10,6 +10,15 @@
 #include <vcdb/transaction.h>
 #include <vpr/parameters.h>
 
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/* forward decls */
+static int vcdb_transaction_commit_unhooked(
+    vcdb_transaction_t* transaction);
+
 /**
  * \brief Commit a transaction.
  *
@@ -25,6 +34,40 @@
  */
 int vcdb_transaction_commit(
     vcdb_transaction_t* transaction)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_transaction_commit_unhooked(transaction);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(hooks, &event, VCDB_HOOK_TRANSACTION_COMMIT, NULL, 0, 0);
+
+    int retval = vcdb_transaction_commit_unhooked(transaction);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_transaction_commit(), run with or without hooks.
+ *
+ * After this action is perform, the transaction handle is disposed and is no
+ * longer valid.  All changes made to the database using this interface will be
+ * flushed to the database.
+ *
+ * \param transaction   The transaction instance to commit.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+static int vcdb_transaction_commit_unhooked(
+    vcdb_transaction_t* transaction)
 {
     MODEL_ASSERT(NULL != transaction);
 
@@ -35,11 +78,19 @@ int vcdb_transaction_commit(
     }
 
     /* call the engine-specific transaction rollback procedure. */
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
     int retval = transaction->database->builder->engine->transaction_commit(
         transaction);
+    vcdb_latency_record(
+        transaction->database->latency, -1, VCDB_DATABASE_METHOD_COMMIT, timer);
     if (VCDB_STATUS_SUCCESS == retval)
     {
         transaction->in_transaction = false;
+        vcdb_stats_add(
+            transaction->database->stats, -1, VCDB_STATS_COMMITS, 1);
+
+        /* drop cached values which this transaction overwrote. */
+        vcdb_transaction_cache_invalidate(transaction);
     }
 
     return retval;
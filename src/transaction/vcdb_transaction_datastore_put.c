@@ -0,0 +1,315 @@
+/**
+ * \file vcdb_transaction_datastore_put.c
+ *
+ * \brief Implementation of the vcdb_transaction_datastore_put() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+#include "../database/database_private.h"
+#include "../datastore/datastore_private.h"
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/* set a sane default for allocation. */
+#ifndef VCDB_DATABASE_DATASTORE_PUT_DEFAULT_SERIALIZATION_BUFFER_SIZE
+#define VCDB_DATABASE_DATASTORE_PUT_DEFAULT_SERIALIZATION_BUFFER_SIZE 1024
+#endif
+
+/* forward decls */
+static VCDB_DATASTORE_KEY_COPY_NOINLINE int
+vcdb_transaction_datastore_put_key_copy(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    size_t value_size,
+    const vcdb_version_t* version,
+    vcdb_hooks_t* hooks);
+static int vcdb_transaction_datastore_put_keyed(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    size_t value_size,
+    const vcdb_version_t* version,
+    vcdb_hooks_t* hooks,
+    const void* key,
+    size_t key_size);
+static int vcdb_transaction_datastore_put_write(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    const vcdb_version_t* version,
+    const void* key,
+    size_t key_size);
+
+/**
+ * \brief Put a value into a datastore, optionally only if the version of the
+ * stored value matches.
+ *
+ * This is the shared body of vcdb_database_datastore_put() and
+ * vcdb_database_datastore_put_if_version().  The caller has already checked
+ * its parameters, the transaction, and engine support.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      NULL to put the value unconditionally.
+ * \param hooks         The hooks to run around the put once its key is
+ *                      known, or NULL.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_transaction_datastore_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    void* value, size_t value_size, const vcdb_version_t* version,
+    vcdb_hooks_t* hooks)
+{
+    MODEL_ASSERT(NULL != transaction);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != value);
+
+    /* a key reference needs no key buffer. */
+    if (NULL != datastore->key_reference_getter)
+    {
+        size_t key_size;
+        const void* key = datastore->key_reference_getter(value, &key_size);
+
+        return vcdb_transaction_datastore_put_keyed(
+            transaction, datastore, value, value_size, version, hooks, key,
+            key_size);
+    }
+
+    return vcdb_transaction_datastore_put_key_copy(
+        transaction, datastore, value, value_size, version, hooks);
+}
+
+/**
+ * \brief Get a copy of the key from the value, then put the value.
+ *
+ * The key buffer lives in this frame only, so datastores with a key reference
+ * getter do not pay for it.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      NULL.
+ * \param hooks         The hooks to run around the put, or NULL.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+static VCDB_DATASTORE_KEY_COPY_NOINLINE int
+vcdb_transaction_datastore_put_key_copy(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    size_t value_size,
+    const vcdb_version_t* version,
+    vcdb_hooks_t* hooks)
+{
+    /* get the key from the value. */
+    char key[VCDB_MAX_KEY_SIZE];
+    size_t key_size = sizeof(key);
+    datastore->key_getter(value, key, &key_size);
+
+    return vcdb_transaction_datastore_put_keyed(
+        transaction, datastore, value, value_size, version, hooks, key,
+        key_size);
+}
+
+/**
+ * \brief Put the value under the given key, running the hooks around it.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      NULL.
+ * \param hooks         The hooks to run around the put, or NULL.
+ * \param key           The key of the value.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+static int vcdb_transaction_datastore_put_keyed(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    size_t value_size,
+    const vcdb_version_t* version,
+    vcdb_hooks_t* hooks,
+    const void* key,
+    size_t key_size)
+{
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_transaction_datastore_put_write(
+            transaction, datastore, value, version, key, key_size);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(
+        hooks, &event, VCDB_HOOK_DATASTORE_PUT, datastore->name, key_size,
+        value_size);
+
+    int retval = vcdb_transaction_datastore_put_write(
+        transaction, datastore, value, version, key, key_size);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief Put the value under the given key.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param value         The value to put.
+ * \param version       The expected version token of the stored value, or
+ *                      NULL.
+ * \param key           The key of the value.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+static int vcdb_transaction_datastore_put_write(
+    vcdb_transaction_t* transaction,
+    vcdb_datastore_t* datastore,
+    void* value,
+    const vcdb_version_t* version,
+    const void* key,
+    size_t key_size)
+{
+    int retval;
+    vcdb_database_engine_t* engine = transaction->database->builder->engine;
+
+    /* the cached value for this key is stale once the transaction commits. */
+    retval = vcdb_transaction_cache_touch(
+        transaction, datastore, key, key_size);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* readers must not filter out this key once it is visible. */
+    vcdb_database_filter_add_value(
+        transaction->database, datastore, key, key_size, value);
+
+    /* use the stack when the datastore's serial data size allows it. */
+    uint8_t stack_buffer[VCDB_DATASTORE_SERIAL_STACK_BUFFER_SIZE];
+    size_t allocation_size =
+        VCDB_DATABASE_DATASTORE_PUT_DEFAULT_SERIALIZATION_BUFFER_SIZE;
+    void* serialized_value = vcdb_datastore_serial_buffer_get(
+        transaction->database->builder, datastore, value, stack_buffer,
+        &allocation_size);
+    size_t buffer_max = allocation_size;
+    if (NULL == serialized_value)
+    {
+        return VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+    }
+
+    /* serialize the value data.  An identity serialized value is its own
+     * serialized data. */
+    retval = VCDB_STATUS_SUCCESS;
+    if (serialized_value != value)
+    {
+        retval =
+            datastore->value_writer(
+                value, serialized_value, &allocation_size);
+    }
+
+    if (VCDB_ERROR_WOULD_TRUNCATE == retval)
+    {
+        vcdb_stats_add(
+            transaction->database->stats, datastore->correlation_id,
+            VCDB_STATS_TRUNCATE_RETRIES, 1);
+
+        /* reallocate a larger buffer. */
+        void* newval = vcdb_datastore_serial_buffer_grow(
+            transaction->database->builder, serialized_value, value,
+            stack_buffer, buffer_max, allocation_size);
+        if (NULL == newval)
+        {
+            retval = VCDB_ERROR_BAD_MEMORY_ALLOCATION;
+            goto cleanup_serial_buffer;
+        }
+
+        /* update the serial buffer. */
+        serialized_value = newval;
+
+        /* attempt serialization with the larger buffer. */
+        retval =
+            datastore->value_writer(value, serialized_value, &allocation_size);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_serial_buffer;
+        }
+    }
+
+    /* if serialization fails, then clean up. */
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_serial_buffer;
+    }
+
+    /* Put key and serialized value, if the version matches. */
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
+    if (NULL == version)
+    {
+        retval =
+            engine->datastore_put(
+                transaction, datastore, (void*)key, &key_size,
+                serialized_value, &allocation_size);
+    }
+    else
+    {
+        retval =
+            engine->datastore_put_if_version(
+                transaction, datastore, (void*)key, &key_size,
+                serialized_value, &allocation_size, *version);
+    }
+    vcdb_latency_record(
+        transaction->database->latency, datastore->correlation_id,
+        VCDB_DATABASE_METHOD_PUT, timer);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_serial_buffer;
+    }
+
+    vcdb_stats_add(
+        transaction->database->stats, datastore->correlation_id,
+        VCDB_STATS_PUTS, 1);
+    vcdb_stats_add(
+        transaction->database->stats, datastore->correlation_id,
+        VCDB_STATS_BYTES_SERIALIZED, allocation_size);
+
+    /* store the projections kept by covering indexes. */
+    retval = vcdb_transaction_projections_put(transaction, datastore, value);
+
+cleanup_serial_buffer:
+    vcdb_datastore_serial_buffer_release(
+        transaction->database->builder, serialized_value, value,
+        stack_buffer);
+
+    return retval;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file vcdb_transaction_projections_put.c
+ *
+ * \brief Implementation of the vcdb_transaction_projections_put() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+#include "../index/index_private.h"
+#include "transaction_private.h"
+
+/**
+ * \brief Store the projections of a value in the covering indexes of its
+ * datastore.
+ *
+ * This is called after the engine has put the value.  It does nothing if the
+ * engine does not store projections.
+ *
+ * \param transaction   The transaction performing the write.
+ * \param datastore     The datastore being written.
+ * \param value         The value being written.
+ *
+ * \returns A status code indicating success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - A non-zero failure code on failure.
+ */
+int vcdb_transaction_projections_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    const void* value)
+{
+    MODEL_ASSERT(NULL != transaction);
+    MODEL_ASSERT(NULL != datastore);
+    MODEL_ASSERT(NULL != value);
+
+    vcdb_builder_t* builder = transaction->database->builder;
+    if (NULL == builder->engine->index_projection_put)
+    {
+        return VCDB_STATUS_SUCCESS;
+    }
+
+    vcdb_index_t* const* indexes;
+    size_t count;
+    int retval =
+        vcdb_builder_datastore_indexes_get(
+            builder, datastore, &indexes, &count);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        vcdb_index_t* index = indexes[i];
+        if (NULL == index->projection_writer
+         || !vcdb_index_value_included(index, value))
+        {
+            continue;
+        }
+
+        /* the projection is stored under the value's secondary key. */
+        char key[VCDB_MAX_KEY_SIZE];
+        size_t key_size = sizeof(key);
+        index->secondary_key_getter(value, key, &key_size);
+
+        void* projection;
+        size_t projection_size;
+        retval =
+            vcdb_index_projection_write(
+                builder, index, value, &projection, &projection_size);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            builder->engine->index_projection_put(
+                transaction, index, key, key_size, projection,
+                projection_size);
+        vcdb_builder_memory_release(builder, projection);
+        if (VCDB_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -10,6 +10,15 @@
 #include <vcdb/transaction.h>
 #include <vpr/parameters.h>
 
+#include "../hooks/hooks_private.h"
+#include "../latency/latency_private.h"
+#include "../stats/stats_private.h"
+#include "transaction_private.h"
+
+/* forward decls */
+static int vcdb_transaction_rollback_unhooked(
+    vcdb_transaction_t* transaction);
+
 /**
  * \brief Roll back a transaction.
  *
@@ -25,6 +34,40 @@
  */
 int vcdb_transaction_rollback(
     vcdb_transaction_t* transaction)
+{
+    vcdb_hooks_t* hooks = vcdb_hooks_get();
+
+    /* without hooks, this is the only added branch. */
+    if (NULL == hooks)
+    {
+        return vcdb_transaction_rollback_unhooked(transaction);
+    }
+
+    vcdb_hook_event_t event;
+    vcdb_hooks_begin(hooks, &event, VCDB_HOOK_TRANSACTION_ROLLBACK, NULL, 0, 0);
+
+    int retval = vcdb_transaction_rollback_unhooked(transaction);
+
+    vcdb_hooks_end(hooks, &event, retval);
+
+    return retval;
+}
+
+/**
+ * \brief The body of vcdb_transaction_rollback(), run with or without hooks.
+ *
+ * After this action is perform, the transaction handle is disposed and is no
+ * longer valid.  All changes made to the database using this interface will be
+ * lost.
+ *
+ * \param transaction   The transaction instance to commit.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * a non-zero failure code on failure.
+ */
+static int vcdb_transaction_rollback_unhooked(
+    vcdb_transaction_t* transaction)
 {
     MODEL_ASSERT(NULL != transaction);
 
@@ -35,11 +78,20 @@ int vcdb_transaction_rollback(
     }
 
     /* call the engine-specific transaction rollback procedure. */
+    uint64_t timer = vcdb_latency_start(transaction->database->latency);
     int retval = transaction->database->builder->engine->transaction_rollback(
         transaction);
+    vcdb_latency_record(
+        transaction->database->latency, -1,
+        VCDB_DATABASE_METHOD_ROLLBACK, timer);
     if (VCDB_STATUS_SUCCESS == retval)
     {
         transaction->in_transaction = false;
+        vcdb_stats_add(
+            transaction->database->stats, -1, VCDB_STATS_ROLLBACKS, 1);
+
+        /* nothing was written, so the cache is still valid. */
+        vcdb_transaction_cache_release(transaction);
     }
 
     return retval;
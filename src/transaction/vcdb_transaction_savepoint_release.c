@@ -0,0 +1,54 @@
+/**
+ * \file vcdb_transaction_savepoint_release.c
+ *
+ * \brief Implementation of the vcdb_transaction_savepoint_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Release a savepoint.
+ *
+ * All changes made since the savepoint was marked become part of the enclosing
+ * transaction.  After this action is performed, the savepoint is no longer
+ * active.
+ *
+ * \param savepoint     The savepoint to release.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_BAD_TRANSACTION if the savepoint or its transaction is
+ *            not active.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_transaction_savepoint_release(
+    vcdb_transaction_savepoint_t* savepoint)
+{
+    MODEL_ASSERT(NULL != savepoint);
+
+    /* parameter sanity check. */
+    if (NULL == savepoint || NULL == savepoint->transaction)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* make sure both the savepoint and its transaction are active. */
+    if (!savepoint->active || !savepoint->transaction->in_transaction)
+    {
+        return VCDB_ERROR_BAD_TRANSACTION;
+    }
+
+    /* call the engine-specific savepoint release procedure. */
+    int retval = savepoint->transaction->database->builder->engine
+        ->transaction_savepoint_release(savepoint->transaction, savepoint);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        savepoint->active = false;
+    }
+
+    return retval;
+}
@@ -0,0 +1,47 @@
+/**
+ * \file vcdb_transaction_savepoint_rollback.c
+ *
+ * \brief Implementation of the vcdb_transaction_savepoint_rollback() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Roll back all changes made since the given savepoint was marked.
+ *
+ * The transaction remains active, and the savepoint remains valid, so the
+ * failed portion of work can be retried and rolled back again if needed.
+ *
+ * \param savepoint     The savepoint to roll back to.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_BAD_TRANSACTION if the savepoint or its transaction is
+ *            not active.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_transaction_savepoint_rollback(
+    vcdb_transaction_savepoint_t* savepoint)
+{
+    MODEL_ASSERT(NULL != savepoint);
+
+    /* parameter sanity check. */
+    if (NULL == savepoint || NULL == savepoint->transaction)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* make sure both the savepoint and its transaction are active. */
+    if (!savepoint->active || !savepoint->transaction->in_transaction)
+    {
+        return VCDB_ERROR_BAD_TRANSACTION;
+    }
+
+    /* call the engine-specific savepoint rollback procedure. */
+    return savepoint->transaction->database->builder->engine
+        ->transaction_savepoint_rollback(savepoint->transaction, savepoint);
+}
@@ -0,0 +1,92 @@
+/**
+ * \file vcdb_transaction_savepoint_set.c
+ *
+ * \brief Implementation of the vcdb_transaction_savepoint_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcdb/transaction.h>
+#include <vpr/parameters.h>
+
+static void vcdb_transaction_savepoint_dispose(void* disposable);
+
+/**
+ * \brief Mark a savepoint in the given transaction.
+ *
+ * The transaction must stay in scope as long as the savepoint is in scope.  The
+ * savepoint is owned by the caller and must be disposed of by calling dispose()
+ * on it.  Disposing an active savepoint releases it.
+ *
+ * \param savepoint     The savepoint instance to mark.
+ * \param transaction   The transaction in which the savepoint is marked.
+ *
+ * \returns A status code signifying success or failure.
+ *          * VCDB_STATUS_SUCCESS on success.
+ *          * VCDB_ERROR_BAD_TRANSACTION if the transaction is not active.
+ *          * VCDB_ERROR_NOT_SUPPORTED if the engine does not implement
+ *            all three savepoint methods.
+ *          * a non-zero failure code on failure.
+ */
+int vcdb_transaction_savepoint_set(
+    vcdb_transaction_savepoint_t* savepoint,
+    vcdb_transaction_t* transaction)
+{
+    MODEL_ASSERT(NULL != savepoint);
+    MODEL_ASSERT(NULL != transaction);
+
+    /* parameter sanity check. */
+    if (NULL == savepoint || NULL == transaction)
+    {
+        return VCDB_ERROR_INVALID_PARAMETER;
+    }
+
+    /* savepoint is disposable. */
+    savepoint->hdr.dispose = &vcdb_transaction_savepoint_dispose;
+    savepoint->active = false;
+    savepoint->transaction = transaction;
+    savepoint->savepoint_engine_context = NULL;
+
+    /* make sure we are in a transaction. */
+    if (!transaction->in_transaction)
+    {
+        return VCDB_ERROR_BAD_TRANSACTION;
+    }
+
+    /* savepoints are optional for engines, but all or nothing. */
+    vcdb_database_engine_t* engine = transaction->database->builder->engine;
+    if (NULL == engine->transaction_savepoint_set
+     || NULL == engine->transaction_savepoint_rollback
+     || NULL == engine->transaction_savepoint_release)
+    {
+        return VCDB_ERROR_NOT_SUPPORTED;
+    }
+
+    /* engine-specific setup */
+    int retval = engine->transaction_savepoint_set(transaction, savepoint);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        savepoint->active = true;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Dispose of a savepoint.
+ *
+ * \param disposable        The savepoint to dispose.
+ */
+static void vcdb_transaction_savepoint_dispose(void* disposable)
+{
+    vcdb_transaction_savepoint_t* savepoint =
+        (vcdb_transaction_savepoint_t*)disposable;
+
+    /* if the savepoint is still active, release it. */
+    if (savepoint->active)
+    {
+        vcdb_transaction_savepoint_release(savepoint);
+        savepoint->active = false;
+    }
+}
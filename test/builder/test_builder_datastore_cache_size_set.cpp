@@ -0,0 +1,238 @@
+/**
+ * \file test_builder_datastore_cache_size_set.cpp
+ *
+ * \brief Test the vcdb_builder_datastore_cache_size_set() method and the
+ * database read cache which it enables.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief Test fixture with a cached datastore.
+ */
+class builder_datastore_cache_size_set : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_datastore_cache_size_set(
+                &builder, &datastore, CACHE_SIZE));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Get the value for a key, returning true if the engine was called.
+     */
+    bool get(const char* key, test_value_t* value)
+    {
+        size_t value_size = sizeof(*value);
+
+        test_datastore_reset();
+        test_datastore_get_called = false;
+        EXPECT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_datastore_get(
+                &database, &datastore, (void*)key, strlen(key), value,
+                &value_size));
+
+        return test_datastore_get_called;
+    }
+
+    static const size_t CACHE_SIZE = 1600;
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+};
+
+/**
+ * Test that a second read of a key is served from the cache.
+ */
+TEST_F(builder_datastore_cache_size_set, hit)
+{
+    test_value_t value;
+
+    /* the mock reader leaves the value alone, so seed it. */
+    memset(&value, 0, sizeof(value));
+    strcpy(value.test_value, "cached");
+    EXPECT_TRUE(get("hot", &value));
+    EXPECT_TRUE(test_value_reader_called);
+
+    /* the cached copy is returned without the engine or the reader. */
+    memset(&value, 0, sizeof(value));
+    EXPECT_FALSE(get("hot", &value));
+    EXPECT_FALSE(test_value_reader_called);
+    EXPECT_STREQ("cached", value.test_value);
+
+    /* other keys still go to the engine. */
+    EXPECT_TRUE(get("cold", &value));
+}
+
+/**
+ * Test that a failed read is not cached.
+ */
+TEST_F(builder_datastore_cache_size_set, miss_not_cached)
+{
+    test_value_t value;
+    size_t value_size = sizeof(value);
+
+    test_datastore_reset();
+    test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_datastore_get(
+            &database, &datastore, (void*)"gone", 4, &value, &value_size));
+    test_datastore_get_retval = VCDB_STATUS_SUCCESS;
+
+    EXPECT_TRUE(get("gone", &value));
+}
+
+/**
+ * Test that committing a delete invalidates the key, and rolling one back
+ * does not.
+ */
+TEST_F(builder_datastore_cache_size_set, commit_invalidates)
+{
+    test_value_t value;
+    vcdb_transaction_t transaction;
+    char key[] = "hot";
+    size_t key_size = strlen(key);
+
+    EXPECT_TRUE(get(key, &value));
+    EXPECT_FALSE(get(key, &value));
+
+    /* a rolled back delete leaves the cache alone. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_delete(
+            &transaction, &datastore, key, &key_size));
+    EXPECT_FALSE(get(key, &value));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    EXPECT_FALSE(get(key, &value));
+
+    /* a committed delete invalidates the key. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_delete(
+            &transaction, &datastore, key, &key_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    EXPECT_TRUE(get(key, &value));
+
+    dispose((disposable_t*)&transaction);
+}
+
+/**
+ * Test that committing a range delete invalidates the whole datastore.
+ */
+TEST_F(builder_datastore_cache_size_set, range_delete_clears)
+{
+    test_value_t value;
+    vcdb_transaction_t transaction;
+    char start[] = "a";
+    size_t start_size = 1;
+    char end[] = "b";
+    size_t end_size = 1;
+
+    EXPECT_TRUE(get("x", &value));
+    EXPECT_TRUE(get("y", &value));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &end_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+
+    EXPECT_TRUE(get("x", &value));
+    EXPECT_TRUE(get("y", &value));
+
+    dispose((disposable_t*)&transaction);
+}
+
+/**
+ * Test that a value read more than once survives a scan of as many one-time
+ * reads as the cache holds.
+ */
+TEST_F(builder_datastore_cache_size_set, scan_resistant)
+{
+    test_value_t value;
+    char key[32];
+
+    /* a second read promotes the value to the protected segment. */
+    EXPECT_TRUE(get("hot", &value));
+    EXPECT_FALSE(get("hot", &value));
+
+    /* scan a cache-full of keys, each read once. */
+    for (size_t i = 0; i < CACHE_SIZE; ++i)
+    {
+        snprintf(key, sizeof(key), "scan_%zu", i);
+        get(key, &value);
+    }
+
+    EXPECT_FALSE(get("hot", &value));
+}
+
+/**
+ * Test that parameter checks work.
+ */
+TEST(builder_datastore_cache_size_set_params, bad_parameter)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore, other;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&other));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_cache_size_set(NULL, &datastore, 10));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_cache_size_set(&builder, NULL, 10));
+
+    /* a datastore that was never added to the builder. */
+    other.correlation_id = 0;
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_cache_size_set(&builder, &other, 10));
+
+    /* the cache can't be resized once the database is open. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_cache_size_set(&builder, &datastore, 10));
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+    dispose((disposable_t*)&other);
+}
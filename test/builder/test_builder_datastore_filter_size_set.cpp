@@ -0,0 +1,340 @@
+/**
+ * \file test_builder_datastore_filter_size_set.cpp
+ *
+ * \brief Test the vcdb_builder_datastore_filter_size_set() and
+ * vcdb_builder_index_filter_size_set() methods and the negative-lookup filters
+ * which they enable.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * \brief Dummy merge method used to enable merge on the test datastore.
+ */
+static int test_value_merger(
+    const void*, size_t, const void*, size_t, void*, size_t*)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Test fixture with a filtered datastore and index.
+ */
+class builder_datastore_filter_size_set : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_index(&builder, &index));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_datastore_filter_size_set(
+                &builder, &datastore, FILTER_SIZE));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_index_filter_size_set(&builder, &index, FILTER_SIZE));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Build a test value with the given primary and secondary keys.
+     */
+    static void make_value(
+        test_value_t* value, const char* key, const char* secondary)
+    {
+        memset(value, 0, sizeof(*value));
+        strcpy(value->test_key, key);
+        strcpy(value->test_value, secondary);
+    }
+
+    /**
+     * \brief Put a value in its own transaction.
+     */
+    void put(const char* key, const char* secondary)
+    {
+        test_value_t value;
+        size_t value_size = sizeof(value);
+        vcdb_transaction_t transaction;
+
+        make_value(&value, key, secondary);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_transaction_begin(&transaction, &database));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_datastore_put(
+                &transaction, &datastore, &value, &value_size));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+        dispose((disposable_t*)&transaction);
+    }
+
+    /**
+     * \brief Get a value by key, returning true if the engine was called.
+     */
+    bool get(const char* key, int expected = VCDB_STATUS_SUCCESS)
+    {
+        test_value_t value;
+        size_t value_size = sizeof(value);
+
+        make_value(&value, key, "");
+        test_datastore_get_called = false;
+        EXPECT_EQ(expected,
+            vcdb_database_datastore_get(
+                &database, &datastore, value.test_key, sizeof(value.test_key),
+                &value, &value_size));
+
+        return test_datastore_get_called;
+    }
+
+    /**
+     * \brief Get a value by secondary key, returning true if the engine was
+     * called.
+     */
+    bool index_get(const char* secondary, int expected = VCDB_STATUS_SUCCESS)
+    {
+        test_value_t value;
+        size_t value_size = sizeof(value);
+
+        make_value(&value, "", secondary);
+        test_index_get_called = false;
+        EXPECT_EQ(expected,
+            vcdb_database_index_get(
+                &database, &index, value.test_value, sizeof(value.test_value),
+                &value, &value_size));
+
+        return test_index_get_called;
+    }
+
+    /**
+     * \brief Close the database and open it again.
+     */
+    void reopen()
+    {
+        dispose((disposable_t*)&database);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_open_from_builder(&database, &builder));
+    }
+
+    static const size_t FILTER_SIZE = 1000;
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+};
+
+/**
+ * Test that keys which were never put are rejected without the engine, and
+ * keys which were are read from it.
+ */
+TEST_F(builder_datastore_filter_size_set, negative_lookup)
+{
+    EXPECT_FALSE(get("absent", VCDB_ERROR_VALUE_NOT_FOUND));
+
+    put("present", "secondary");
+    EXPECT_TRUE(get("present"));
+    EXPECT_FALSE(get("absent", VCDB_ERROR_VALUE_NOT_FOUND));
+
+    /* the index filter holds secondary keys. */
+    EXPECT_TRUE(index_get("secondary"));
+    EXPECT_FALSE(index_get("present", VCDB_ERROR_VALUE_NOT_FOUND));
+
+    /* membership checks use the filter too. */
+    char key[sizeof(((test_value_t*)0)->test_key)] = "absent";
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_datastore_contains(
+            &database, &datastore, key, sizeof(key)));
+    EXPECT_FALSE(test_datastore_contains_called);
+}
+
+/**
+ * Test that the false positive rate stays near one percent at the sized
+ * capacity.
+ */
+TEST_F(builder_datastore_filter_size_set, false_positive_rate)
+{
+    char key[32];
+    size_t hits = 0;
+
+    for (size_t i = 0; i < FILTER_SIZE; ++i)
+    {
+        snprintf(key, sizeof(key), "key_%zu", i);
+        put(key, "");
+    }
+
+    for (size_t i = 0; i < FILTER_SIZE; ++i)
+    {
+        snprintf(key, sizeof(key), "key_%zu", i);
+        EXPECT_TRUE(get(key));
+    }
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        snprintf(key, sizeof(key), "other_%zu", i);
+        test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+        if (get(key, VCDB_ERROR_VALUE_NOT_FOUND))
+        {
+            ++hits;
+        }
+    }
+
+    EXPECT_GT(300U, hits);
+}
+
+/**
+ * Test that a merge refused for an indexed datastore leaves the filters
+ * untouched.
+ */
+TEST_F(builder_datastore_filter_size_set, merge_refused)
+{
+    test_value_t value;
+    size_t key_size = sizeof(value.test_key);
+    char operand[] = "operand";
+    size_t operand_size = sizeof(operand);
+    vcdb_transaction_t transaction;
+
+    make_value(&value, "merged", "");
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, value.test_key, &key_size, operand,
+            &operand_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    EXPECT_FALSE(get("merged", VCDB_ERROR_VALUE_NOT_FOUND));
+    EXPECT_FALSE(index_get("anything", VCDB_ERROR_VALUE_NOT_FOUND));
+}
+
+/**
+ * Test that filters are saved on close and loaded on open.
+ */
+TEST_F(builder_datastore_filter_size_set, persisted)
+{
+    put("present", "secondary");
+    reopen();
+
+    /* the saved copies are removed once loaded. */
+    EXPECT_TRUE(test_filter_load_called);
+    EXPECT_TRUE(test_filter_saved.empty());
+
+    EXPECT_TRUE(get("present"));
+    EXPECT_FALSE(get("absent", VCDB_ERROR_VALUE_NOT_FOUND));
+    EXPECT_TRUE(index_get("secondary"));
+    EXPECT_FALSE(index_get("absent", VCDB_ERROR_VALUE_NOT_FOUND));
+}
+
+/**
+ * Test that a filter is disabled when it can't be loaded.
+ */
+TEST_F(builder_datastore_filter_size_set, not_loaded)
+{
+    put("present", "secondary");
+
+    /* simulate a crash, which leaves no saved filter. */
+    test_filter_save_retval = VCDB_ERROR_NOT_SUPPORTED;
+    reopen();
+    test_filter_save_retval = VCDB_STATUS_SUCCESS;
+
+    EXPECT_TRUE(get("absent"));
+    EXPECT_TRUE(index_get("absent"));
+}
+
+/**
+ * Test that a filter saved with a different size is not loaded.
+ */
+TEST_F(builder_datastore_filter_size_set, size_changed)
+{
+    put("present", "secondary");
+    dispose((disposable_t*)&database);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_datastore_filter_size_set(
+            &builder, &datastore, 4 * FILTER_SIZE));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_open_from_builder(&database, &builder));
+
+    /* the datastore filter is disabled, but the index filter is not. */
+    EXPECT_TRUE(get("absent"));
+    EXPECT_FALSE(index_get("absent", VCDB_ERROR_VALUE_NOT_FOUND));
+}
+
+/**
+ * Test that parameter checks work.
+ */
+TEST(builder_datastore_filter_size_set_params, bad_parameter)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore, other;
+    vcdb_index_t index, other_index;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&other));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&other_index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_filter_size_set(NULL, &datastore, 10));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_filter_size_set(&builder, NULL, 10));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_filter_size_set(NULL, &index, 10));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_filter_size_set(&builder, NULL, 10));
+
+    /* instances that were never added to the builder. */
+    other.correlation_id = 1;
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_filter_size_set(&builder, &other, 10));
+    other_index.correlation_id = 0;
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_filter_size_set(&builder, &other_index, 10));
+
+    /* filters can't be resized once the database is open. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_filter_size_set(&builder, &datastore, 10));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_filter_size_set(&builder, &index, 10));
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+    dispose((disposable_t*)&other);
+    dispose((disposable_t*)&other_index);
+}
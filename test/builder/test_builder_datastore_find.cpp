@@ -0,0 +1,165 @@
+/**
+ * \file test_builder_datastore_find.cpp
+ *
+ * \brief Test the vcdb_builder_datastore_find() and vcdb_builder_index_find()
+ * methods.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vector>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * Test that datastores and indexes can be found by name once the database is
+ * created, even when there are many of them.
+ */
+TEST(builder_datastore_find, many_datastores)
+{
+    const size_t COUNT = 200;
+    std::vector<std::string> names(COUNT);
+    std::vector<vcdb_datastore_t> datastores(COUNT);
+    std::vector<vcdb_index_t> indexes(COUNT);
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+
+    /* add more datastores and indexes than fit in the initial array. */
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        names[i] = "store_" + std::to_string(i);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastores[i]));
+        datastores[i].name = names[i].c_str();
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastores[i]));
+
+        /* indexes may share names with datastores. */
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            test_index_init(&indexes[i], &datastores[i]));
+        indexes[i].name = names[i].c_str();
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_index(&builder, &indexes[i]));
+    }
+
+    ASSERT_EQ(2 * COUNT, builder.instance_array_size);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+        vcdb_datastore_t* datastore = nullptr;
+        vcdb_index_t* index = nullptr;
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_datastore_find(
+                &builder, &datastore, names[i].c_str()));
+        EXPECT_EQ(&datastores[i], datastore);
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_index_find(&builder, &index, names[i].c_str()));
+        EXPECT_EQ(&indexes[i], index);
+    }
+
+    /* dispose the database before the builder. */
+    dispose((disposable_t*)&database);
+
+    /* the builder would dispose these, but they live in the vectors. */
+    builder.instance_array_size = 0;
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a missing name is reported.
+ */
+TEST(builder_datastore_find, not_found)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    vcdb_datastore_t* found_datastore = nullptr;
+    vcdb_index_t* found_index = nullptr;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_builder_datastore_find(&builder, &found_datastore, "missing"));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_builder_index_find(&builder, &found_index, "missing"));
+
+    /* datastore and index names are separate namespaces. */
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_builder_index_find(&builder, &found_index, datastore.name));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_builder_datastore_find(&builder, &found_datastore, index.name));
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that parameter checks work, and that lookups fail until the database
+ * has been created or opened.
+ */
+TEST(builder_datastore_find, bad_parameter)
+{
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_datastore_t* found_datastore = nullptr;
+    vcdb_index_t* found_index = nullptr;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+
+    /* the schema has not been built yet. */
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_find(
+            &builder, &found_datastore, datastore.name));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_find(NULL, &found_datastore, "x"));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_find(&builder, NULL, "x"));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_find(&builder, &found_datastore, NULL));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_find(NULL, &found_index, "x"));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_find(&builder, NULL, "x"));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_index_find(&builder, &found_index, NULL));
+
+    dispose((disposable_t*)&builder);
+}
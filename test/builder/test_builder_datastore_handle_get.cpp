@@ -0,0 +1,102 @@
+/**
+ * \file test_builder_datastore_handle_get.cpp
+ *
+ * \brief Test the engine handle accessors in the builder interface.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * Test that handles are stored and retrieved by correlation ID.
+ */
+TEST(builder_datastore_handle_get, set_get)
+{
+    vcdb_builder_t builder;
+    vcdb_datastore_t ds1, ds2;
+    vcdb_index_t idx;
+    int h1, h2, h3;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&idx, &ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &idx));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds2));
+
+    /* handles start out empty. */
+    EXPECT_EQ(nullptr, vcdb_builder_datastore_handle_get(&builder, &ds1));
+    EXPECT_EQ(nullptr, vcdb_builder_index_handle_get(&builder, &idx));
+
+    vcdb_builder_datastore_handle_set(&builder, &ds1, &h1);
+    vcdb_builder_index_handle_set(&builder, &idx, &h2);
+    vcdb_builder_datastore_handle_set(&builder, &ds2, &h3);
+
+    /* each instance resolves to its own handle. */
+    EXPECT_EQ(&h1, vcdb_builder_datastore_handle_get(&builder, &ds1));
+    EXPECT_EQ(&h2, vcdb_builder_index_handle_get(&builder, &idx));
+    EXPECT_EQ(&h3, vcdb_builder_datastore_handle_get(&builder, &ds2));
+
+    /* the handle lives in the instance array slot for the correlation ID. */
+    EXPECT_EQ(&h2, builder.instance_array[idx.correlation_id].handle);
+
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that the engine can resolve its per-datastore object on a get.
+ */
+TEST(builder_datastore_handle_get, engine_dispatch)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t ds1, ds2;
+    vcdb_index_t idx;
+    char key[] = "key";
+    char value[1024];
+    size_t value_size = sizeof(value);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&idx, &ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &idx));
+
+    /* the mock engine sets up each handle when the database is created. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    test_datastore_reset();
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &ds2, key, sizeof(key), value, &value_size));
+    EXPECT_EQ(&ds2, test_datastore_get_handle);
+
+    value_size = sizeof(value);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get(
+            &database, &idx, key, sizeof(key), value, &value_size));
+    EXPECT_EQ(&idx, test_index_get_handle);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,124 @@
+/**
+ * \file test_builder_datastore_indexes_get.cpp
+ *
+ * \brief Test the vcdb_builder_datastore_indexes_get() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * Test that each datastore lists exactly its own indexes, in the order they
+ * were added.
+ */
+TEST(builder_datastore_indexes_get, adjacency)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t ds1, ds2, ds3;
+    vcdb_index_t idx1a, idx2a, idx1b;
+    vcdb_index_t* const* indexes = nullptr;
+    size_t count = 99;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&ds3));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&idx1a, &ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&idx2a, &ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&idx1b, &ds1));
+
+    /* interleave datastores and indexes. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &idx1a));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_datastore(&builder, &ds3));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &idx2a));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &idx1b));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_datastore_indexes_get(&builder, &ds1, &indexes, &count));
+    ASSERT_EQ(2U, count);
+    EXPECT_EQ(&idx1a, indexes[0]);
+    EXPECT_EQ(&idx1b, indexes[1]);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_datastore_indexes_get(&builder, &ds2, &indexes, &count));
+    ASSERT_EQ(1U, count);
+    EXPECT_EQ(&idx2a, indexes[0]);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_datastore_indexes_get(&builder, &ds3, &indexes, &count));
+    EXPECT_EQ(0U, count);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that parameter checks work.
+ */
+TEST(builder_datastore_indexes_get, bad_parameter)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore, other;
+    vcdb_index_t* const* indexes = nullptr;
+    size_t count = 0;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&other));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+
+    /* the schema has not been built yet. */
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_indexes_get(
+            &builder, &datastore, &indexes, &count));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_indexes_get(
+            NULL, &datastore, &indexes, &count));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_indexes_get(
+            &builder, NULL, &indexes, &count));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_indexes_get(
+            &builder, &datastore, NULL, &count));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_indexes_get(
+            &builder, &datastore, &indexes, NULL));
+
+    /* a datastore that was never added to the builder. */
+    other.correlation_id = 0;
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_datastore_indexes_get(
+            &builder, &other, &indexes, &count));
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+    dispose((disposable_t*)&other);
+}
@@ -0,0 +1,311 @@
+/**
+ * \file test_builder_init_with_allocator.cpp
+ *
+ * \brief Test the vcdb_builder_init_with_allocator() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <map>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+
+#include "../memory_database.h"
+#include "../test_database.h"
+
+/**
+ * \brief An allocator which tracks outstanding memory and enforces a cap.
+ */
+typedef struct counting_allocator
+{
+    std::map<void*, size_t> blocks;
+    size_t outstanding;
+    size_t allocations;
+    size_t cap;
+} counting_allocator_t;
+
+/**
+ * \brief Allocate memory, unless this would exceed the cap.
+ */
+static void* counting_allocate(void* context, size_t size)
+{
+    counting_allocator_t* ctx = (counting_allocator_t*)context;
+
+    if (ctx->outstanding + size > ctx->cap)
+    {
+        return nullptr;
+    }
+
+    void* mem = malloc(size);
+    if (nullptr != mem)
+    {
+        ctx->blocks[mem] = size;
+        ctx->outstanding += size;
+        ++ctx->allocations;
+    }
+
+    return mem;
+}
+
+/**
+ * \brief Release memory.
+ */
+static void counting_release(void* context, void* mem)
+{
+    counting_allocator_t* ctx = (counting_allocator_t*)context;
+
+    ctx->outstanding -= ctx->blocks[mem];
+    ctx->blocks.erase(mem);
+    free(mem);
+}
+
+/**
+ * \brief Resize memory, unless this would exceed the cap.
+ */
+static void* counting_reallocate(
+    void* context, void* mem, size_t old_size, size_t new_size)
+{
+    counting_allocator_t* ctx = (counting_allocator_t*)context;
+
+    /* the library must report the size it actually allocated. */
+    EXPECT_EQ(ctx->blocks[mem], old_size);
+
+    if (ctx->outstanding - old_size + new_size > ctx->cap)
+    {
+        return nullptr;
+    }
+
+    void* newmem = realloc(mem, new_size);
+    if (nullptr != newmem)
+    {
+        ctx->blocks.erase(mem);
+        ctx->blocks[newmem] = new_size;
+        ctx->outstanding = ctx->outstanding - old_size + new_size;
+        ++ctx->allocations;
+    }
+
+    return newmem;
+}
+
+/**
+ * \brief Dispose of the allocator options.
+ */
+static void counting_dispose(void*)
+{
+}
+
+/**
+ * \brief Set up allocator options which use a counting allocator.
+ */
+static void counting_allocator_options_init(
+    allocator_options_t* options, counting_allocator_t* ctx, size_t cap)
+{
+    ctx->outstanding = 0;
+    ctx->allocations = 0;
+    ctx->cap = cap;
+
+    memset(options, 0, sizeof(allocator_options_t));
+    options->hdr.dispose = &counting_dispose;
+    options->allocator_allocate = &counting_allocate;
+    options->allocator_release = &counting_release;
+    options->allocator_reallocate = &counting_reallocate;
+    options->context = ctx;
+}
+
+/**
+ * \brief A value which serializes to more than the default buffer size.
+ */
+typedef struct allocator_value
+{
+    char key[16];
+    uint8_t payload[1024];
+} allocator_value_t;
+
+static void allocator_key_getter(
+    const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const allocator_value_t*)value)->key, 16);
+    *key_size = 16;
+}
+
+static int allocator_value_reader(const void* input, size_t size, void* value)
+{
+    if (sizeof(allocator_value_t) != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+static int allocator_value_writer(
+    const void* value, void* output, size_t* size)
+{
+    if (*size < sizeof(allocator_value_t))
+    {
+        *size = sizeof(allocator_value_t);
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, sizeof(allocator_value_t));
+    *size = sizeof(allocator_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * Test that the init method fails on bad parameters.
+ */
+TEST(builder_init_with_allocator, bad_parameters)
+{
+    vcdb_builder_t builder;
+    allocator_options_t alloc_opts;
+    counting_allocator_t ctx;
+
+    register_test_database();
+    counting_allocator_options_init(&alloc_opts, &ctx, SIZE_MAX);
+
+    ASSERT_NE(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init_with_allocator(
+            NULL, &alloc_opts, "TESTDB", "test-dir"));
+    ASSERT_NE(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init_with_allocator(
+            &builder, &alloc_opts, NULL, "test-dir"));
+    ASSERT_NE(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init_with_allocator(
+            &builder, &alloc_opts, "TESTDB", NULL));
+
+    /* nothing was allocated. */
+    EXPECT_EQ(0U, ctx.allocations);
+}
+
+/**
+ * Test that the builder's own memory comes from the allocator.
+ */
+TEST(builder_init_with_allocator, builder_memory)
+{
+    vcdb_builder_t builder;
+    allocator_options_t alloc_opts;
+    counting_allocator_t ctx;
+
+    register_test_database();
+    counting_allocator_options_init(&alloc_opts, &ctx, SIZE_MAX);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init_with_allocator(
+            &builder, &alloc_opts, "TESTDB", "test-dir"));
+
+    EXPECT_EQ(&alloc_opts, builder.alloc_opts);
+    EXPECT_STREQ("test-dir", builder.connection_string);
+    EXPECT_EQ(2U, ctx.allocations);
+    EXPECT_LT(0U, ctx.outstanding);
+
+    /* everything is returned to the allocator on dispose. */
+    dispose((disposable_t*)&builder);
+    EXPECT_EQ(0U, ctx.outstanding);
+}
+
+/**
+ * Test that vcdb_builder_init() uses the C library allocator.
+ */
+TEST(builder_init_with_allocator, default_allocator)
+{
+    vcdb_builder_t builder;
+
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+
+    EXPECT_EQ(nullptr, builder.alloc_opts);
+
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that the buffers of a database and its transactions come from the
+ * builder's allocator, and are all returned.
+ */
+TEST(builder_init_with_allocator, database_memory)
+{
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_database_t database;
+    vcdb_transaction_t txn;
+    allocator_options_t alloc_opts;
+    counting_allocator_t ctx;
+    allocator_value_t value, read;
+
+    register_memory_database();
+    counting_allocator_options_init(&alloc_opts, &ctx, SIZE_MAX);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_init(
+            &datastore, "values", sizeof(allocator_value_t),
+            &allocator_key_getter, &allocator_value_reader,
+            &allocator_value_writer));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init_with_allocator(
+            &builder, &alloc_opts, MEMORY_DATABASE_ENGINE,
+            "builder_init_with_allocator"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_datastore_cache_size_set(&builder, &datastore, 16));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    size_t created = ctx.allocations;
+
+    /* the value is larger than the default buffers, so they are resized. */
+    memset(&value, 0, sizeof(value));
+    memcpy(value.key, "allocator-key-01", 16);
+    value.payload[1000] = 0x5a;
+    size_t value_size = sizeof(value);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_begin(&txn, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(&txn, &datastore, &value, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&txn));
+
+    size_t read_size = sizeof(read);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &datastore, value.key, 16, &read, &read_size));
+    EXPECT_EQ(0x5a, read.payload[1000]);
+
+    /* the put and the get allocated their scratch buffers here. */
+    EXPECT_LT(created, ctx.allocations);
+
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+
+    EXPECT_EQ(0U, ctx.outstanding);
+}
+
+/**
+ * Test that a capped allocator makes the library fail cleanly.
+ */
+TEST(builder_init_with_allocator, cap)
+{
+    vcdb_builder_t builder;
+    allocator_options_t alloc_opts;
+    counting_allocator_t ctx;
+
+    register_test_database();
+    counting_allocator_options_init(&alloc_opts, &ctx, 4);
+
+    /* the instance array does not fit. */
+    ASSERT_EQ(VCDB_ERROR_BAD_MEMORY_ALLOCATION,
+        vcdb_builder_init_with_allocator(
+            &builder, &alloc_opts, "TESTDB", "dir"));
+
+    /* the connection string was returned. */
+    EXPECT_EQ(0U, ctx.outstanding);
+}
@@ -0,0 +1,222 @@
+/**
+ * \file test_builder_latency_histograms_enable.cpp
+ *
+ * \brief Test the vcdb_builder_latency_histograms_enable() method and the
+ * vcdb_database_latency_get() summaries which it enables.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief The fake clock, and the amount it advances on each read.
+ */
+static uint64_t test_clock_now;
+static uint64_t test_clock_step;
+
+/**
+ * \brief Fake clock method, so every timed engine call takes one step.
+ */
+static uint64_t test_clock()
+{
+    test_clock_now += test_clock_step;
+
+    return test_clock_now;
+}
+
+/**
+ * \brief Test fixture with latency histograms enabled.
+ */
+class builder_latency_histograms_enable : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+        test_clock_now = 0;
+        test_clock_step = 1;
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Get a value with the fake clock taking the given step.
+     */
+    void get(uint64_t step)
+    {
+        test_value_t value;
+        size_t value_size = sizeof(value);
+
+        memset(&value, 0, sizeof(value));
+        test_clock_step = step;
+        EXPECT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_datastore_get(
+                &database, &datastore, value.test_key, sizeof(value.test_key),
+                &value, &value_size));
+    }
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+};
+
+/**
+ * Test that summaries are not supported unless histograms are enabled.
+ */
+TEST_F(builder_latency_histograms_enable, disabled)
+{
+    vcdb_database_latency_t latency;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    EXPECT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_latency_get(
+            &database, datastore.correlation_id, VCDB_DATABASE_METHOD_GET,
+            &latency));
+
+    /* histograms can't be enabled while the database is open. */
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_latency_histograms_enable(&builder, &test_clock));
+
+    dispose((disposable_t*)&database);
+}
+
+/**
+ * Test that engine gets are recorded and summarized.
+ */
+TEST_F(builder_latency_histograms_enable, percentiles)
+{
+    vcdb_database_latency_t latency;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_latency_histograms_enable(&builder, &test_clock));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* 990 fast gets, 9 slower gets, and one slow get. */
+    for (int i = 0; i < 990; ++i)
+    {
+        get(2);
+    }
+    for (int i = 0; i < 9; ++i)
+    {
+        get(100);
+    }
+    get(10000);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, datastore.correlation_id, VCDB_DATABASE_METHOD_GET,
+            &latency));
+    EXPECT_EQ(1000U, latency.count);
+    EXPECT_EQ((990U * 2U + 9U * 100U + 10000U) / 1000U, latency.mean);
+    EXPECT_EQ(2U, latency.p50);
+    EXPECT_EQ(2U, latency.p99);
+    EXPECT_LE(100U, latency.p999);
+    EXPECT_GE(125U, latency.p999);
+    EXPECT_EQ(10000U, latency.max);
+
+    /* no puts were made. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, datastore.correlation_id, VCDB_DATABASE_METHOD_PUT,
+            &latency));
+    EXPECT_EQ(0U, latency.count);
+
+    /* out of range correlation IDs are rejected. */
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_latency_get(
+            &database, 100, VCDB_DATABASE_METHOD_GET, &latency));
+
+    dispose((disposable_t*)&database);
+}
+
+/**
+ * Test that range deletes are recorded apart from single key deletes.
+ */
+TEST_F(builder_latency_histograms_enable, delete_range)
+{
+    vcdb_database_latency_t latency;
+    vcdb_transaction_t transaction;
+    char start[] = "key_0000";
+    size_t start_size = sizeof(start);
+    char end[] = "key_1000";
+    size_t end_size = sizeof(end);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_latency_histograms_enable(&builder, NULL));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &end_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, datastore.correlation_id,
+            VCDB_DATABASE_METHOD_DELETE_RANGE, &latency));
+    EXPECT_EQ(1U, latency.count);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, datastore.correlation_id, VCDB_DATABASE_METHOD_DELETE,
+            &latency));
+    EXPECT_EQ(0U, latency.count);
+
+    dispose((disposable_t*)&database);
+}
+
+/**
+ * Test that transaction methods are recorded database-wide.
+ */
+TEST_F(builder_latency_histograms_enable, transactions)
+{
+    vcdb_database_latency_t latency;
+    vcdb_transaction_t transaction;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_latency_histograms_enable(&builder, NULL));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, -1, VCDB_DATABASE_METHOD_BEGIN, &latency));
+    EXPECT_EQ(1U, latency.count);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, -1, VCDB_DATABASE_METHOD_COMMIT, &latency));
+    EXPECT_EQ(1U, latency.count);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_latency_get(
+            &database, -1, VCDB_DATABASE_METHOD_ROLLBACK, &latency));
+    EXPECT_EQ(0U, latency.count);
+
+    dispose((disposable_t*)&database);
+}
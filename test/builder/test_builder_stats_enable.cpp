@@ -0,0 +1,76 @@
+/**
+ * \file test_builder_stats_enable.cpp
+ *
+ * \brief Test the vcdb_builder_stats_enable() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that operation counters are off by default, and can be enabled.
+ */
+TEST(builder_stats_enable, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+
+    /* preconditions */
+    EXPECT_FALSE(builder.stats_enabled);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_stats_enable(&builder));
+
+    /* postconditions */
+    EXPECT_TRUE(builder.stats_enabled);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    EXPECT_NE(nullptr, database.stats);
+
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that operation counters can't be enabled on bad parameters, or once
+ * the database is open.
+ */
+TEST(builder_stats_enable, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+
+    register_test_database();
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER, vcdb_builder_stats_enable(NULL));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_builder_stats_enable(&builder));
+    EXPECT_FALSE(builder.stats_enabled);
+
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,130 @@
+/**
+ * \file engine_conformance.h
+ *
+ * \brief Conformance and performance test kit for database engines.
+ *
+ * Any engine registered with vcdb_database_engine_register() can run the kit
+ * by linking test_engine_conformance.cpp and instantiating it:
+ *
+ *      ENGINE_CONFORMANCE_INSTANTIATE(mydb, "MYDB", &register_mydb);
+ *
+ * The conformance tests check the semantics the library relies on: committed
+ * writes are visible, rolled back writes are not, secondary indexes follow
+ * updates and deletes, values larger than the library's default read buffer
+ * round trip, and data survives closing and reopening the database.  The
+ * performance profile times a fixed mix of calls and records nanoseconds per
+ * call as test properties, so engines report comparable numbers.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef ENGINE_CONFORMANCE_PRIVATE_HEADER_GUARD
+#define ENGINE_CONFORMANCE_PRIVATE_HEADER_GUARD
+
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/index.h>
+#include <vcdb/transaction.h>
+
+/**
+ * \brief The engine under test.
+ */
+typedef struct engine_conformance_param
+{
+    /**
+     * \brief The name under which the engine is registered.
+     */
+    const char* engine;
+
+    /**
+     * \brief Register the engine.  Called before each test.
+     */
+    void (*register_engine)();
+
+} engine_conformance_param_t;
+
+/**
+ * \brief The value stored by the kit.
+ *
+ * The payload makes the serialized value larger than the library's default
+ * read buffer, so engines must honor VCDB_ERROR_WOULD_TRUNCATE.
+ */
+typedef struct engine_conformance_value
+{
+    char key[16];
+    char group[16];
+    uint32_t version;
+    char payload[1500];
+
+} engine_conformance_value_t;
+
+/**
+ * \brief Test fixture with a fresh database for the engine under test.
+ */
+class engine_conformance
+    : public ::testing::TestWithParam<engine_conformance_param_t> {
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    /**
+     * \brief Close and reopen the database.
+     */
+    void reopen();
+
+    /**
+     * \brief Put a value in the given transaction.
+     */
+    int put(
+        vcdb_transaction_t* transaction, const char* key, const char* group,
+        uint32_t version);
+
+    /**
+     * \brief Put a value in its own committed transaction.
+     */
+    int put(const char* key, const char* group, uint32_t version);
+
+    /**
+     * \brief Delete a value by primary key in its own committed transaction.
+     */
+    int remove(const char* key);
+
+    /**
+     * \brief Get a value by primary key.
+     */
+    int get(const char* key, engine_conformance_value_t* value);
+
+    /**
+     * \brief Get a value by secondary key.
+     */
+    int index_get(const char* group, engine_conformance_value_t* value);
+
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    vcdb_database_t database;
+    bool open;
+};
+
+/* use the test suite API when the gtest in use has it. */
+#ifdef INSTANTIATE_TEST_SUITE_P
+#define ENGINE_CONFORMANCE_INSTANTIATE_P INSTANTIATE_TEST_SUITE_P
+#else
+#define ENGINE_CONFORMANCE_INSTANTIATE_P INSTANTIATE_TEST_CASE_P
+#endif
+
+/**
+ * \brief Run the conformance kit against an engine.
+ *
+ * \param name              A unique name for this instantiation.
+ * \param engine_name       The name under which the engine is registered.
+ * \param register_method   A function registering the engine.
+ */
+#define ENGINE_CONFORMANCE_INSTANTIATE(name, engine_name, register_method) \
+    ENGINE_CONFORMANCE_INSTANTIATE_P( \
+        name, engine_conformance, \
+        ::testing::Values( \
+            engine_conformance_param_t{ (engine_name), (register_method) }))
+
+#endif /*ENGINE_CONFORMANCE_PRIVATE_HEADER_GUARD*/
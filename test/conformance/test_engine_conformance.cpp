@@ -0,0 +1,490 @@
+/**
+ * \file test_engine_conformance.cpp
+ *
+ * \brief Conformance and performance tests run against each engine
+ * instantiated with ENGINE_CONFORMANCE_INSTANTIATE().
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "engine_conformance.h"
+
+using namespace std;
+
+/**
+ * \brief Get the primary key of a value.
+ */
+static void conformance_key_getter(
+    const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const engine_conformance_value_t*)value)->key, 16);
+    *key_size = 16;
+}
+
+/**
+ * \brief Get the secondary key of a value.
+ */
+static void conformance_group_getter(
+    const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const engine_conformance_value_t*)value)->group, 16);
+    *key_size = 16;
+}
+
+/**
+ * \brief Read a value by copying it.
+ */
+static int conformance_value_reader(
+    const void* input, size_t size, void* value)
+{
+    if (sizeof(engine_conformance_value_t) != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write a value by copying it.
+ */
+static int conformance_value_writer(
+    const void* value, void* output, size_t* size)
+{
+    if (*size < sizeof(engine_conformance_value_t))
+    {
+        *size = sizeof(engine_conformance_value_t);
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, sizeof(engine_conformance_value_t));
+    *size = sizeof(engine_conformance_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Copy a string into a zero padded 16 byte key.
+ */
+static void conformance_key(char* out, const char* key)
+{
+    memset(out, 0, 16);
+    memcpy(out, key, strnlen(key, 16));
+}
+
+void engine_conformance::SetUp()
+{
+    GetParam().register_engine();
+
+    string connection = string("conformance-") + GetParam().engine;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_init(
+            &datastore, "conformance_values",
+            sizeof(engine_conformance_value_t), &conformance_key_getter,
+            &conformance_value_reader, &conformance_value_writer));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_index_init(
+            &index, &datastore, "conformance_groups",
+            &conformance_group_getter));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, GetParam().engine, connection.c_str()));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_index(&builder, &index));
+
+    /* start from an empty database. */
+    vcdb_database_delete_using_builder(&builder);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    open = true;
+}
+
+void engine_conformance::TearDown()
+{
+    if (open)
+    {
+        dispose((disposable_t*)&database);
+    }
+
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+}
+
+void engine_conformance::reopen()
+{
+    dispose((disposable_t*)&database);
+    open = false;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_open_from_builder(&database, &builder));
+    open = true;
+}
+
+int engine_conformance::put(
+    vcdb_transaction_t* transaction, const char* key, const char* group,
+    uint32_t version)
+{
+    engine_conformance_value_t value;
+    size_t value_size = sizeof(value);
+
+    memset(&value, 0, sizeof(value));
+    conformance_key(value.key, key);
+    conformance_key(value.group, group);
+    value.version = version;
+    memset(value.payload, 'a' + version % 26, sizeof(value.payload));
+
+    return
+        vcdb_database_datastore_put(
+            transaction, &datastore, &value, &value_size);
+}
+
+int engine_conformance::put(
+    const char* key, const char* group, uint32_t version)
+{
+    vcdb_transaction_t transaction;
+
+    int retval = vcdb_transaction_begin(&transaction, &database);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval = put(&transaction, key, group, version);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_transaction_commit(&transaction);
+    }
+    else
+    {
+        vcdb_transaction_rollback(&transaction);
+    }
+
+    dispose((disposable_t*)&transaction);
+
+    return retval;
+}
+
+int engine_conformance::remove(const char* key)
+{
+    vcdb_transaction_t transaction;
+    char k[16];
+    size_t key_size = sizeof(k);
+
+    conformance_key(k, key);
+
+    int retval = vcdb_transaction_begin(&transaction, &database);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        vcdb_database_datastore_delete(
+            &transaction, &datastore, k, &key_size);
+    if (VCDB_STATUS_SUCCESS == retval)
+    {
+        retval = vcdb_transaction_commit(&transaction);
+    }
+    else
+    {
+        vcdb_transaction_rollback(&transaction);
+    }
+
+    dispose((disposable_t*)&transaction);
+
+    return retval;
+}
+
+int engine_conformance::get(
+    const char* key, engine_conformance_value_t* value)
+{
+    char k[16];
+    size_t value_size = sizeof(*value);
+
+    conformance_key(k, key);
+
+    return
+        vcdb_database_datastore_get(
+            &database, &datastore, k, sizeof(k), value, &value_size);
+}
+
+int engine_conformance::index_get(
+    const char* group, engine_conformance_value_t* value)
+{
+    char k[16];
+    size_t value_size = sizeof(*value);
+
+    conformance_key(k, group);
+
+    return
+        vcdb_database_index_get(
+            &database, &index, k, sizeof(k), value, &value_size);
+}
+
+/**
+ * Test that a committed value can be read back in full.
+ */
+TEST_P(engine_conformance, put_get)
+{
+    engine_conformance_value_t value;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_STREQ("alpha", value.key);
+    EXPECT_STREQ("red", value.group);
+    EXPECT_EQ(1U, value.version);
+    EXPECT_EQ('b', value.payload[0]);
+    EXPECT_EQ('b', value.payload[sizeof(value.payload) - 1]);
+}
+
+/**
+ * Test that a missing key is not found.
+ */
+TEST_P(engine_conformance, get_missing)
+{
+    engine_conformance_value_t value;
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("alpha", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("red", &value));
+}
+
+/**
+ * Test that a put replaces the existing value.
+ */
+TEST_P(engine_conformance, update)
+{
+    engine_conformance_value_t value;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 2));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_EQ(2U, value.version);
+}
+
+/**
+ * Test that a deleted value is gone, along with its index entry.
+ */
+TEST_P(engine_conformance, remove)
+{
+    engine_conformance_value_t value;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("beta", "blue", 1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, remove("alpha"));
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("alpha", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("red", &value));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, get("beta", &value));
+}
+
+/**
+ * Test that a value can be read by secondary key, and that the index follows
+ * updates.
+ */
+TEST_P(engine_conformance, index)
+{
+    engine_conformance_value_t value;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, index_get("red", &value));
+    EXPECT_STREQ("alpha", value.key);
+    EXPECT_EQ(1U, value.version);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "blue", 2));
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("red", &value));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, index_get("blue", &value));
+    EXPECT_EQ(2U, value.version);
+}
+
+/**
+ * Test that deleting by secondary key deletes the primary value.
+ */
+TEST_P(engine_conformance, index_delete)
+{
+    engine_conformance_value_t value;
+    vcdb_transaction_t transaction;
+    char group[16];
+    size_t group_size = sizeof(group);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("beta", "blue", 1));
+
+    conformance_key(group, "red");
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_delete(&transaction, &index, group, &group_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("alpha", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("red", &value));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, get("beta", &value));
+}
+
+/**
+ * Test that writes are not visible to database reads until committed, and
+ * never visible if rolled back.
+ */
+TEST_P(engine_conformance, rollback)
+{
+    engine_conformance_value_t value;
+    vcdb_transaction_t transaction;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put(&transaction, "alpha", "red", 2));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put(&transaction, "beta", "blue", 1));
+
+    /* uncommitted writes are not visible. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_EQ(1U, value.version);
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("beta", &value));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    /* rolled back writes never become visible. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_EQ(1U, value.version);
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("beta", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("blue", &value));
+}
+
+/**
+ * Test that all writes of a transaction become visible on commit.
+ */
+TEST_P(engine_conformance, commit_many)
+{
+    engine_conformance_value_t value;
+    vcdb_transaction_t transaction;
+    char key[16];
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    for (int i = 0; i < 100; ++i)
+    {
+        snprintf(key, sizeof(key), "key%03d", i);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, put(&transaction, key, key, i));
+    }
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        snprintf(key, sizeof(key), "key%03d", i);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, get(key, &value));
+        EXPECT_EQ((uint32_t)i, value.version);
+    }
+}
+
+/**
+ * Test that committed data survives closing and reopening the database.
+ */
+TEST_P(engine_conformance, reopen)
+{
+    engine_conformance_value_t value;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("alpha", "red", 1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, put("beta", "blue", 1));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, remove("beta"));
+
+    reopen();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_EQ(1U, value.version);
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, index_get("red", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("beta", &value));
+}
+
+/**
+ * Run the standard performance profile, recording nanoseconds per call.
+ */
+TEST_P(engine_conformance, performance_profile)
+{
+    const int COUNT = 2000;
+    engine_conformance_value_t value;
+    vcdb_transaction_t transaction;
+    char key[16];
+
+    auto record = [&](const char* name, chrono::steady_clock::time_point s) {
+        double ns =
+            chrono::duration<double, nano>(
+                chrono::steady_clock::now() - s).count() / COUNT;
+        char text[32];
+        snprintf(text, sizeof(text), "%.1f", ns);
+        RecordProperty(string(name) + "_ns", text);
+        printf("[   PERF   ] %s %s: %s ns\n",
+            GetParam().engine, name, text);
+    };
+
+    /* bulk load in one transaction. */
+    auto start = chrono::steady_clock::now();
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    for (int i = 0; i < COUNT; ++i)
+    {
+        snprintf(key, sizeof(key), "key%06d", i);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, put(&transaction, key, key, i));
+    }
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+    record("bulk_put", start);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i)
+    {
+        snprintf(key, sizeof(key), "key%06d", (i * 7919) % COUNT);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, get(key, &value));
+    }
+    record("get", start);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i)
+    {
+        snprintf(key, sizeof(key), "miss%06d", i);
+        ASSERT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get(key, &value));
+    }
+    record("get_missing", start);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i)
+    {
+        snprintf(key, sizeof(key), "key%06d", (i * 7919) % COUNT);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, index_get(key, &value));
+    }
+    record("index_get", start);
+
+    /* a transaction per write. */
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i)
+    {
+        snprintf(key, sizeof(key), "key%06d", (i * 7919) % COUNT);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, put(key, key, i + 1));
+    }
+    record("put_commit", start);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i)
+    {
+        snprintf(key, sizeof(key), "key%06d", i);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, remove(key));
+    }
+    record("delete_commit", start);
+}
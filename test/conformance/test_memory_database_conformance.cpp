@@ -0,0 +1,29 @@
+/**
+ * \file test_memory_database_conformance.cpp
+ *
+ * \brief Run the engine conformance kit against the in-memory engine.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vcdb/trace.h>
+
+#include "../memory_database.h"
+#include "engine_conformance.h"
+
+/**
+ * \brief Register the trace engine for the in-memory engine.
+ */
+static void register_trace_memory_database()
+{
+    register_memory_database();
+    vcdb_trace_engine_register(MEMORY_DATABASE_ENGINE);
+}
+
+ENGINE_CONFORMANCE_INSTANTIATE(
+    memory, MEMORY_DATABASE_ENGINE, &register_memory_database);
+
+/* decorators must not change the semantics of the engine they wrap. */
+ENGINE_CONFORMANCE_INSTANTIATE(
+    trace_memory, "trace:" MEMORY_DATABASE_ENGINE,
+    &register_trace_memory_database);
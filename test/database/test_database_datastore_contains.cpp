@@ -0,0 +1,161 @@
+/**
+ * \file test_database_datastore_contains.cpp
+ *
+ * \brief Test the vcdb_database_datastore_contains() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that the engine's membership check is used when it has one.
+ */
+TEST(database_datastore_contains, e2e)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* preconditions */
+    test_datastore_reset();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_contains(
+            &database, &datastore, (void*)key, key_size));
+
+    /* the membership method should have been called instead of the get. */
+    EXPECT_TRUE(test_datastore_contains_called);
+    EXPECT_FALSE(test_datastore_get_called);
+    EXPECT_EQ(&database, test_datastore_contains_param_database);
+    EXPECT_EQ(&datastore, test_datastore_contains_param_datastore);
+    EXPECT_EQ(key, test_datastore_contains_param_key);
+    EXPECT_EQ(key_size, test_datastore_contains_param_key_size);
+
+    /* the value is never deserialized. */
+    EXPECT_FALSE(test_value_reader_called);
+
+    /* a missing key is reported by the engine. */
+    test_datastore_contains_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    ASSERT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_datastore_contains(
+            &database, &datastore, (void*)key, key_size));
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that engines without a membership check fall back to a get.
+ */
+TEST(database_datastore_contains, fallback)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    test_datastore_reset();
+
+    /* a value too large for the scratch buffer still exists. */
+    test_datastore_get_retval = VCDB_ERROR_WOULD_TRUNCATE;
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_contains(
+            &database, &datastore, (void*)key, key_size));
+    EXPECT_TRUE(test_datastore_get_called);
+    EXPECT_EQ(key, test_datastore_get_param_key);
+    EXPECT_EQ(key_size, test_datastore_get_param_key_size);
+    EXPECT_FALSE(test_datastore_contains_called);
+    EXPECT_FALSE(test_value_reader_called);
+
+    /* the value size isn't needed to find a small value. */
+    test_datastore_get_retval = VCDB_STATUS_SUCCESS;
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_contains(
+            &database, &datastore, (void*)key, key_size));
+
+    test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    ASSERT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_datastore_contains(
+            &database, &datastore, (void*)key, key_size));
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that the membership check fails on invalid parameters.
+ */
+TEST(database_datastore_contains, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_contains(
+            NULL, &datastore, (void*)key, key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_contains(
+            &database, NULL, (void*)key, key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_contains(
+            &database, &datastore, NULL, key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_contains(
+            &database, &datastore, (void*)key, 0U));
+
+    /* the engine method should NOT have been called */
+    EXPECT_FALSE(test_datastore_contains_called);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
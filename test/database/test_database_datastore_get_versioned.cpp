@@ -0,0 +1,173 @@
+/**
+ * \file test_database_datastore_get_versioned.cpp
+ *
+ * \brief Test the vcdb_database_datastore_get_versioned() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that the versioned get calls the engine and returns the version token.
+ */
+TEST(database_datastore_get_versioned, e2e)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char value[1024];
+    size_t value_size = sizeof(value);
+    vcdb_version_t version = VCDB_VERSION_NONE;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* preconditions */
+    test_datastore_reset();
+    test_datastore_get_versioned_version = 42;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore,
+            (void*)key, key_size,
+            (void*)value, &value_size, &version));
+
+    /* the versioned engine method should have been called */
+    EXPECT_TRUE(test_datastore_get_versioned_called);
+    EXPECT_FALSE(test_datastore_get_called);
+    EXPECT_EQ(&database, test_datastore_get_versioned_param_database);
+    EXPECT_EQ(&datastore, test_datastore_get_versioned_param_datastore);
+    EXPECT_EQ(key, test_datastore_get_versioned_param_key);
+    EXPECT_EQ(key_size, test_datastore_get_versioned_param_key_size);
+    EXPECT_EQ(&version, test_datastore_get_versioned_param_version);
+    EXPECT_EQ(42U, version);
+
+    /* the serialization reader method should have been called. */
+    EXPECT_TRUE(test_value_reader_called);
+    EXPECT_EQ(value, test_value_reader_param_value);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that the versioned get reports engines that do not support it.
+ */
+TEST(database_datastore_get_versioned, not_supported)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char value[1024];
+    size_t value_size = sizeof(value);
+    vcdb_version_t version;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    test_datastore_reset();
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore,
+            (void*)key, key_size,
+            (void*)value, &value_size, &version));
+
+    EXPECT_FALSE(test_datastore_get_versioned_called);
+    EXPECT_FALSE(test_value_reader_called);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that the versioned get fails on invalid parameters.
+ */
+TEST(database_datastore_get_versioned, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char value[1024];
+    size_t value_size = sizeof(value);
+    vcdb_version_t version;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            NULL, &datastore, (void*)key, key_size,
+            (void*)value, &value_size, &version));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            &database, NULL, (void*)key, key_size,
+            (void*)value, &value_size, &version));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore, NULL, key_size,
+            (void*)value, &value_size, &version));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore, (void*)key, 0U,
+            (void*)value, &value_size, &version));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore, (void*)key, key_size,
+            NULL, &value_size, &version));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore, (void*)key, key_size,
+            (void*)value, NULL, &version));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_get_versioned(
+            &database, &datastore, (void*)key, key_size,
+            (void*)value, &value_size, NULL));
+
+    /* the engine method should NOT have been called */
+    EXPECT_FALSE(test_datastore_get_versioned_called);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,192 @@
+/**
+ * \file test_database_index_get_primary_key.cpp
+ *
+ * \brief Test the vcdb_database_index_get_primary_key() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * Test that the engine's mapping is used when it has one.
+ */
+TEST(database_index_get_primary_key, e2e)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char primary_key[64];
+    size_t primary_key_size = sizeof(primary_key);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* preconditions */
+    test_datastore_reset();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, key_size,
+            primary_key, &primary_key_size));
+
+    /* the engine mapping should have been used instead of the index get. */
+    EXPECT_TRUE(test_index_get_primary_key_called);
+    EXPECT_FALSE(test_index_get_called);
+    EXPECT_EQ(&database, test_index_get_primary_key_param_database);
+    EXPECT_EQ(&index, test_index_get_primary_key_param_index);
+    EXPECT_EQ(key, test_index_get_primary_key_param_key);
+    EXPECT_EQ(key_size, test_index_get_primary_key_param_key_size);
+    EXPECT_EQ(primary_key, test_index_get_primary_key_param_primary_key);
+    EXPECT_EQ(&primary_key_size,
+        test_index_get_primary_key_param_primary_key_size);
+
+    /* the value is never deserialized. */
+    EXPECT_FALSE(test_value_reader_called);
+    EXPECT_FALSE(test_key_getter_called);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that engines without a mapping fall back to reading the value.
+ */
+TEST(database_index_get_primary_key, fallback)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char primary_key[64];
+    size_t primary_key_size = 1;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    test_datastore_reset();
+
+    /* a small buffer reports the size needed. */
+    ASSERT_EQ(VCDB_ERROR_WOULD_TRUNCATE,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, key_size,
+            primary_key, &primary_key_size));
+    EXPECT_TRUE(test_index_get_called);
+    EXPECT_TRUE(test_key_getter_called);
+    EXPECT_FALSE(test_index_get_primary_key_called);
+    EXPECT_EQ(sizeof(((test_value_t*)0)->test_key), primary_key_size);
+
+    primary_key_size = sizeof(primary_key);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, key_size,
+            primary_key, &primary_key_size));
+    EXPECT_EQ(sizeof(((test_value_t*)0)->test_key), primary_key_size);
+
+    /* a missing key is reported without getting a key. */
+    test_datastore_reset();
+    test_index_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    ASSERT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, key_size,
+            primary_key, &primary_key_size));
+    EXPECT_FALSE(test_key_getter_called);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that the primary key lookup fails on invalid parameters.
+ */
+TEST(database_index_get_primary_key, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char primary_key[64];
+    size_t primary_key_size = sizeof(primary_key);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_primary_key(
+            NULL, &index, (void*)key, key_size,
+            primary_key, &primary_key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_primary_key(
+            &database, NULL, (void*)key, key_size,
+            primary_key, &primary_key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_primary_key(
+            &database, &index, NULL, key_size,
+            primary_key, &primary_key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, 0U,
+            primary_key, &primary_key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, key_size,
+            NULL, &primary_key_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_primary_key(
+            &database, &index, (void*)key, key_size,
+            primary_key, NULL));
+
+    /* the engine method should NOT have been called */
+    EXPECT_FALSE(test_index_get_primary_key_called);
+
+    /* clean up */
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,286 @@
+/**
+ * \file test_database_index_get_projection.cpp
+ *
+ * \brief Test the vcdb_database_index_get_projection() method and the storing
+ * of projections in covering indexes.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * \brief The size of the test projection.
+ */
+#define TEST_PROJECTION_SIZE 8
+
+/**
+ * \brief Project the first bytes of the value field.
+ */
+static int test_projection_writer(
+    const void* value, void* output, size_t* size)
+{
+    const test_value_t* v = (const test_value_t*)value;
+
+    if (*size < TEST_PROJECTION_SIZE)
+    {
+        *size = TEST_PROJECTION_SIZE;
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, v->test_value, TEST_PROJECTION_SIZE);
+    *size = TEST_PROJECTION_SIZE;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Only index values which are pending.
+ */
+static bool test_predicate(const void* value)
+{
+    const test_value_t* v = (const test_value_t*)value;
+
+    return 0 == strncmp(v->test_value, "pending", 7);
+}
+
+/**
+ * \brief Test fixture with a covering index.
+ */
+class database_index_get_projection : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_index_projection_writer_set(
+                &index, &test_projection_writer));
+    }
+
+    void open(const char* engine)
+    {
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, engine, "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_index(&builder, &index));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+
+        test_datastore_reset();
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        dispose((disposable_t*)&builder);
+    }
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+};
+
+/**
+ * Test that a put stores the projection under the secondary key.
+ */
+TEST_F(database_index_get_projection, put_stores_projection)
+{
+    vcdb_transaction_t transaction;
+    test_value_t value;
+    size_t value_size = sizeof(value);
+
+    open("TESTDB");
+
+    memset(&value, 0, sizeof(value));
+    strcpy(value.test_key, "primary");
+    strcpy(value.test_value, "status=ok;rest");
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+
+    EXPECT_TRUE(test_datastore_put_called);
+    EXPECT_TRUE(test_index_projection_put_called);
+    EXPECT_EQ(&transaction, test_index_projection_put_param_transaction);
+    EXPECT_EQ(&index, test_index_projection_put_param_index);
+    EXPECT_EQ(sizeof(value.test_value),
+        test_index_projection_put_param_key_size);
+    EXPECT_EQ((size_t)TEST_PROJECTION_SIZE,
+        test_index_projection_put_param_projection_size);
+
+    /* a failed put stores no projection. */
+    test_index_projection_put_called = false;
+    test_datastore_put_retval = VCDB_ERROR_NOT_SUPPORTED;
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    EXPECT_FALSE(test_index_projection_put_called);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    dispose((disposable_t*)&transaction);
+}
+
+/**
+ * Test that a partial index only stores projections of matching values.
+ */
+TEST_F(database_index_get_projection, partial_index)
+{
+    vcdb_transaction_t transaction;
+    test_value_t value;
+    size_t value_size = sizeof(value);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_index_predicate_set(&index, &test_predicate));
+    open("TESTDB");
+
+    memset(&value, 0, sizeof(value));
+    strcpy(value.test_key, "primary");
+    strcpy(value.test_value, "settled");
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    EXPECT_TRUE(test_datastore_put_called);
+    EXPECT_FALSE(test_index_projection_put_called);
+
+    strcpy(value.test_value, "pending");
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    EXPECT_TRUE(test_index_projection_put_called);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    dispose((disposable_t*)&transaction);
+}
+
+/**
+ * Test that the projection is read from the index entry.
+ */
+TEST_F(database_index_get_projection, e2e)
+{
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char projection[64];
+    size_t projection_size = sizeof(projection);
+
+    open("TESTDB");
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            projection, &projection_size));
+
+    /* the primary datastore is not touched. */
+    EXPECT_TRUE(test_index_get_projection_called);
+    EXPECT_FALSE(test_index_get_called);
+    EXPECT_FALSE(test_value_reader_called);
+    EXPECT_EQ(&database, test_index_get_projection_param_database);
+    EXPECT_EQ(&index, test_index_get_projection_param_index);
+    EXPECT_EQ(key, test_index_get_projection_param_key);
+    EXPECT_EQ(key_size, test_index_get_projection_param_key_size);
+    EXPECT_EQ(projection, test_index_get_projection_param_projection);
+    EXPECT_EQ(&projection_size,
+        test_index_get_projection_param_projection_size);
+}
+
+/**
+ * Test that engines without stored projections project the value.
+ */
+TEST_F(database_index_get_projection, fallback)
+{
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char projection[64];
+    size_t projection_size = 1;
+
+    open("TESTDB_MINIMAL");
+
+    /* a small buffer reports the size needed. */
+    ASSERT_EQ(VCDB_ERROR_WOULD_TRUNCATE,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            projection, &projection_size));
+    EXPECT_TRUE(test_index_get_called);
+    EXPECT_TRUE(test_value_reader_called);
+    EXPECT_FALSE(test_index_get_projection_called);
+    EXPECT_EQ((size_t)TEST_PROJECTION_SIZE, projection_size);
+
+    projection_size = sizeof(projection);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            projection, &projection_size));
+    EXPECT_EQ((size_t)TEST_PROJECTION_SIZE, projection_size);
+
+    /* a missing key is passed through. */
+    test_index_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    ASSERT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            projection, &projection_size));
+}
+
+/**
+ * Test that the projection get fails on invalid parameters.
+ */
+TEST_F(database_index_get_projection, bad_params)
+{
+    const char* key = "TESTKEY";
+    size_t key_size = strlen(key);
+    char projection[64];
+    size_t projection_size = sizeof(projection);
+
+    open("TESTDB");
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            NULL, &index, (void*)key, key_size,
+            projection, &projection_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            &database, NULL, (void*)key, key_size,
+            projection, &projection_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            &database, &index, NULL, key_size,
+            projection, &projection_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, 0U,
+            projection, &projection_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            NULL, &projection_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            projection, NULL));
+
+    /* only covering indexes have projections. */
+    index.projection_writer = NULL;
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_index_get_projection(
+            &database, &index, (void*)key, key_size,
+            projection, &projection_size));
+
+    /* the engine method should NOT have been called */
+    EXPECT_FALSE(test_index_get_projection_called);
+}
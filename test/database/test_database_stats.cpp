@@ -0,0 +1,225 @@
+/**
+ * \file test_database_stats.cpp
+ *
+ * \brief Test the vcdb_database_stats() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+#include <vector>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * \brief Test fixture with a datastore and an index.
+ */
+class database_stats : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_index(&builder, &index));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_stats_enable(&builder));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Get a value from the datastore.
+     */
+    int get()
+    {
+        test_value_t value;
+        size_t value_size = sizeof(value);
+
+        return vcdb_database_datastore_get(
+            &database, &datastore, (void*)"key", 3, &value, &value_size);
+    }
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+};
+
+/**
+ * Test that gets are counted by outcome.
+ */
+TEST_F(database_stats, gets)
+{
+    vcdb_database_stats_t stats;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get());
+
+    test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    ASSERT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get());
+
+    /* the engine asks for a larger buffer both times. */
+    test_datastore_get_retval = VCDB_ERROR_WOULD_TRUNCATE;
+    ASSERT_EQ(VCDB_ERROR_WOULD_TRUNCATE, get());
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_database_stats(&database, &stats));
+    ASSERT_EQ(2U, stats.instance_count);
+
+    vcdb_database_counters_t* c = &stats.instances[datastore.correlation_id];
+    EXPECT_EQ(3U, c->gets);
+    EXPECT_EQ(1U, c->hits);
+    EXPECT_EQ(1U, c->misses);
+    EXPECT_EQ(1U, c->truncate_retries);
+    EXPECT_EQ(0U, c->cache_hits);
+    EXPECT_EQ(0U, c->filter_rejects);
+    EXPECT_LT(0U, c->bytes_deserialized);
+
+    /* the index saw nothing. */
+    EXPECT_EQ(0U, stats.instances[index.correlation_id].gets);
+
+    dispose((disposable_t*)&stats);
+}
+
+/**
+ * Test that writes and transactions are counted.
+ */
+TEST_F(database_stats, writes)
+{
+    vcdb_database_stats_t stats;
+    vcdb_transaction_t transaction;
+    test_value_t value;
+    size_t value_size = sizeof(value);
+    char key[] = "key";
+    size_t key_size = strlen(key);
+
+    memset(&value, 0, sizeof(value));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_delete(
+            &transaction, &datastore, key, &key_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_delete(&transaction, &index, key, &key_size));
+
+    /* failed writes are not counted. */
+    test_datastore_put_retval = VCDB_ERROR_NOT_SUPPORTED;
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_database_stats(&database, &stats));
+
+    vcdb_database_counters_t* c = &stats.instances[datastore.correlation_id];
+    EXPECT_EQ(1U, c->puts);
+    EXPECT_LT(0U, c->bytes_serialized);
+    EXPECT_EQ(1U, c->deletes);
+    EXPECT_EQ(1U, stats.instances[index.correlation_id].deletes);
+    EXPECT_EQ(1U, stats.commits);
+    EXPECT_EQ(1U, stats.rollbacks);
+
+    dispose((disposable_t*)&stats);
+}
+
+/**
+ * Test that counts from many threads are all kept.
+ */
+TEST_F(database_stats, threads)
+{
+    const size_t THREADS = 8;
+    const size_t GETS = 1000;
+    vcdb_database_stats_t stats;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&]() {
+            test_value_t value;
+
+            for (size_t j = 0; j < GETS; ++j)
+            {
+                size_t value_size = sizeof(value);
+                vcdb_database_datastore_get(
+                    &database, &datastore, (void*)"key", 3, &value,
+                    &value_size);
+            }
+        });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_database_stats(&database, &stats));
+    EXPECT_EQ(THREADS * GETS, stats.instances[datastore.correlation_id].gets);
+
+    dispose((disposable_t*)&stats);
+}
+
+/**
+ * Test that the stats method fails on invalid parameters.
+ */
+TEST_F(database_stats, bad_params)
+{
+    vcdb_database_stats_t stats;
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER, vcdb_database_stats(NULL, &stats));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_stats(&database, NULL));
+}
+
+/**
+ * Test that no snapshot is available when counters are not enabled.
+ */
+TEST(database_stats_disabled, not_supported)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_database_stats_t stats;
+
+    register_test_database();
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* counters are off by default. */
+    EXPECT_EQ(nullptr, database.stats);
+    EXPECT_EQ(VCDB_ERROR_NOT_SUPPORTED, vcdb_database_stats(&database, &stats));
+
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
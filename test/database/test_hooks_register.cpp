@@ -0,0 +1,154 @@
+/**
+ * \file test_hooks_register.cpp
+ *
+ * \brief Test the vcdb_hooks_register() method and the hooks it registers.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/hooks.h>
+#include <vcdb/transaction.h>
+#include <vector>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief The events seen by the test hooks.
+ */
+static std::vector<vcdb_hook_event_t> test_hook_begins;
+static std::vector<vcdb_hook_event_t> test_hook_ends;
+
+/**
+ * \brief Test begin callback, which leaves a marker for the end callback.
+ */
+static void test_hook_begin(void* context, vcdb_hook_event_t* event)
+{
+    EXPECT_EQ(&test_hook_begins, context);
+
+    test_hook_begins.push_back(*event);
+    event->user_data = 0x1234;
+}
+
+/**
+ * \brief Test end callback.
+ */
+static void test_hook_end(void* context, vcdb_hook_event_t* event)
+{
+    EXPECT_EQ(&test_hook_begins, context);
+    EXPECT_EQ(0x1234U, event->user_data);
+
+    test_hook_ends.push_back(*event);
+}
+
+/**
+ * \brief Test fixture with the test hooks registered.
+ */
+class hooks_register : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+        test_hook_begins.clear();
+        test_hook_ends.clear();
+
+        hooks.begin = &test_hook_begin;
+        hooks.end = &test_hook_end;
+        hooks.context = &test_hook_begins;
+        vcdb_hooks_register(&hooks);
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+    }
+
+    void TearDown() override
+    {
+        vcdb_hooks_register(NULL);
+        dispose((disposable_t*)&builder);
+    }
+
+    vcdb_hooks_t hooks;
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+};
+
+/**
+ * Test that each entry point calls the begin and end hooks in order.
+ */
+TEST_F(hooks_register, entry_points)
+{
+    test_value_t value;
+    size_t value_size = sizeof(value);
+    vcdb_transaction_t transaction;
+
+    memset(&value, 0, sizeof(value));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_datastore_get(
+            &database, &datastore, value.test_key, sizeof(value.test_key),
+            &value, &value_size));
+    dispose((disposable_t*)&database);
+
+    const vcdb_hook_entry_point_t expected[] = {
+        VCDB_HOOK_DATABASE_CREATE,
+        VCDB_HOOK_TRANSACTION_BEGIN,
+        VCDB_HOOK_DATASTORE_PUT,
+        VCDB_HOOK_TRANSACTION_COMMIT,
+        VCDB_HOOK_DATASTORE_GET,
+        VCDB_HOOK_DATABASE_DISPOSE };
+    const size_t expected_count = sizeof(expected) / sizeof(expected[0]);
+
+    ASSERT_EQ(expected_count, test_hook_begins.size());
+    ASSERT_EQ(expected_count, test_hook_ends.size());
+    for (size_t i = 0; i < expected_count; ++i)
+    {
+        EXPECT_EQ(expected[i], test_hook_begins[i].entry_point);
+        EXPECT_EQ(expected[i], test_hook_ends[i].entry_point);
+    }
+
+    /* the put event carries the extracted key size. */
+    EXPECT_STREQ(datastore.name, test_hook_begins[2].name);
+    EXPECT_EQ(sizeof(value.test_key), test_hook_begins[2].key_size);
+    EXPECT_EQ(sizeof(value), test_hook_begins[2].value_size);
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, test_hook_ends[2].status);
+
+    /* the get event carries the datastore, sizes, and result. */
+    EXPECT_STREQ(datastore.name, test_hook_ends[4].name);
+    EXPECT_EQ(sizeof(value.test_key), test_hook_ends[4].key_size);
+    EXPECT_EQ(sizeof(value), test_hook_ends[4].value_size);
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, test_hook_ends[4].status);
+}
+
+/**
+ * Test that no hooks are called once they are removed.
+ */
+TEST_F(hooks_register, unregister)
+{
+    vcdb_hooks_register(NULL);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    dispose((disposable_t*)&database);
+
+    EXPECT_EQ(0U, test_hook_begins.size());
+    EXPECT_EQ(0U, test_hook_ends.size());
+}
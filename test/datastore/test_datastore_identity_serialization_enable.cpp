@@ -0,0 +1,154 @@
+/**
+ * \file test_datastore_identity_serialization_enable.cpp
+ *
+ * \brief Test the vcdb_datastore_identity_serialization_enable() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/index.h>
+#include <vcdb/transaction.h>
+
+#include "../memory_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief A plain-old-data record.
+ */
+typedef struct pod_value
+{
+    uint8_t uuid[16];
+    uint8_t owner[16];
+    uint64_t balance;
+} pod_value_t;
+
+static void pod_key_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const pod_value_t*)value)->uuid, 16);
+    *key_size = 16;
+}
+
+static void pod_owner_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const pod_value_t*)value)->owner, 16);
+    *key_size = 16;
+}
+
+/**
+ * \brief The number of times the reader or writer was called.
+ */
+static int pod_serializer_calls;
+
+static int pod_value_reader(const void*, size_t, void*)
+{
+    ++pod_serializer_calls;
+
+    return VCDB_ERROR_DATABASE_ENGINE;
+}
+
+static int pod_value_writer(const void*, void*, size_t*)
+{
+    ++pod_serializer_calls;
+
+    return VCDB_ERROR_DATABASE_ENGINE;
+}
+
+/**
+ * Test that identity serialization can be enabled on a datastore.
+ */
+TEST(datastore_identity_serialization_enable, happy_path)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    /* by default, values are serialized by the writer. */
+    EXPECT_FALSE(datastore.identity_serialization);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_identity_serialization_enable(&datastore));
+
+    EXPECT_TRUE(datastore.identity_serialization);
+
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that enabling identity serialization fails on invalid parameters.
+ */
+TEST(datastore_identity_serialization_enable, bad_params)
+{
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_identity_serialization_enable(NULL));
+}
+
+/**
+ * Test that values round trip without calling the reader or writer.
+ */
+TEST(datastore_identity_serialization_enable, round_trip)
+{
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_transaction_t txn;
+    pod_value_t value, read;
+
+    register_memory_database();
+    pod_serializer_calls = 0;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_init(
+            &datastore, "pod", sizeof(pod_value_t), &pod_key_getter,
+            &pod_value_reader, &pod_value_writer));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_identity_serialization_enable(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_index_init(&index, &datastore, "owner", &pod_owner_getter));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(
+            &builder, MEMORY_DATABASE_ENGINE, "identity_serialization"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    memset(&value, 0x11, sizeof(value));
+    memset(value.owner, 0x22, sizeof(value.owner));
+    value.balance = 12345;
+
+    size_t value_size = sizeof(value);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_begin(&txn, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(&txn, &datastore, &value, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&txn));
+
+    /* read by primary key. */
+    memset(&read, 0, sizeof(read));
+    size_t read_size = sizeof(read);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &datastore, value.uuid, 16, &read, &read_size));
+    EXPECT_EQ(0, memcmp(&value, &read, sizeof(value)));
+
+    /* read by secondary key. */
+    memset(&read, 0, sizeof(read));
+    read_size = sizeof(read);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get(
+            &database, &index, value.owner, 16, &read, &read_size));
+    EXPECT_EQ(12345U, read.balance);
+
+    /* neither the reader nor the writer was needed. */
+    EXPECT_EQ(0, pod_serializer_calls);
+
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,191 @@
+/**
+ * \file test_datastore_key_reference_getter_set.cpp
+ *
+ * \brief Test the vcdb_datastore_key_reference_getter_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/transaction.h>
+
+#include "../memory_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief The size of the key of a long key value, which is larger than
+ * VCDB_MAX_KEY_SIZE.
+ */
+#define LONG_KEY_SIZE 4096
+
+/**
+ * \brief A value with a key too long for a key getter.
+ */
+typedef struct long_key_value
+{
+    uint8_t key[LONG_KEY_SIZE];
+    uint32_t count;
+} long_key_value_t;
+
+/**
+ * \brief The number of times the copying key getter was called.
+ */
+static int long_key_getter_calls;
+
+static void long_key_getter(const void*, void*, size_t* key_size)
+{
+    ++long_key_getter_calls;
+
+    /* this key can't be copied. */
+    *key_size = 0;
+}
+
+static const void* long_key_reference_getter(
+    const void* value, size_t* key_size)
+{
+    *key_size = LONG_KEY_SIZE;
+
+    return ((const long_key_value_t*)value)->key;
+}
+
+static int long_value_reader(const void* input, size_t size, void* value)
+{
+    if (sizeof(long_key_value_t) != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+static int long_value_writer(const void* value, void* output, size_t* size)
+{
+    if (*size < sizeof(long_key_value_t))
+    {
+        *size = sizeof(long_key_value_t);
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, sizeof(long_key_value_t));
+    *size = sizeof(long_key_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * Test that a key reference getter can be set on a datastore.
+ */
+TEST(datastore_key_reference_getter_set, happy_path)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    /* by default, there is no key reference getter. */
+    EXPECT_EQ(nullptr, datastore.key_reference_getter);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_key_reference_getter_set(
+            &datastore, &long_key_reference_getter));
+
+    EXPECT_EQ(&long_key_reference_getter, datastore.key_reference_getter);
+
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that setting a key reference getter fails on invalid parameters.
+ */
+TEST(datastore_key_reference_getter_set, bad_params)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_key_reference_getter_set(
+            NULL, &long_key_reference_getter));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_key_reference_getter_set(&datastore, NULL));
+
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that a value with a key longer than VCDB_MAX_KEY_SIZE can be put and
+ * read back, without copying its key.
+ */
+TEST(datastore_key_reference_getter_set, long_key)
+{
+    vcdb_datastore_t datastore;
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_transaction_t txn;
+
+    register_memory_database();
+    long_key_getter_calls = 0;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_init(
+            &datastore, "long", sizeof(long_key_value_t), &long_key_getter,
+            &long_value_reader, &long_value_writer));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_key_reference_getter_set(
+            &datastore, &long_key_reference_getter));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, MEMORY_DATABASE_ENGINE, "long_key"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* two keys which only differ past VCDB_MAX_KEY_SIZE. */
+    long_key_value_t* first = new long_key_value_t;
+    long_key_value_t* second = new long_key_value_t;
+    long_key_value_t* read = new long_key_value_t;
+    memset(first, 0x41, sizeof(long_key_value_t));
+    memset(second, 0x41, sizeof(long_key_value_t));
+    second->key[LONG_KEY_SIZE - 1] = 0x42;
+    first->count = 1;
+    second->count = 2;
+
+    size_t value_size = sizeof(long_key_value_t);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_begin(&txn, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(&txn, &datastore, first, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(&txn, &datastore, second, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&txn));
+
+    size_t read_size = sizeof(long_key_value_t);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &datastore, first->key, LONG_KEY_SIZE, read,
+            &read_size));
+    EXPECT_EQ(1U, read->count);
+
+    read_size = sizeof(long_key_value_t);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &datastore, second->key, LONG_KEY_SIZE, read,
+            &read_size));
+    EXPECT_EQ(2U, read->count);
+
+    /* the copying key getter was never needed. */
+    EXPECT_EQ(0, long_key_getter_calls);
+
+    delete first;
+    delete second;
+    delete read;
+
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,239 @@
+/**
+ * \file test_datastore_serial_data_size_set.cpp
+ *
+ * \brief Test the vcdb_datastore_serial_data_size_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/transaction.h>
+
+#include "../memory_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief A fixed size record keyed by a UUID.
+ */
+typedef struct fixed_value
+{
+    uint8_t uuid[16];
+    uint8_t payload[80];
+} fixed_value_t;
+
+static void fixed_key_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const fixed_value_t*)value)->uuid, 16);
+    *key_size = 16;
+}
+
+static int fixed_value_reader(const void* input, size_t size, void* value)
+{
+    if (sizeof(fixed_value_t) != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+static int fixed_value_writer(const void* value, void* output, size_t* size)
+{
+    if (*size < sizeof(fixed_value_t))
+    {
+        *size = sizeof(fixed_value_t);
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, sizeof(fixed_value_t));
+    *size = sizeof(fixed_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Count allocations made through the builder's allocator.
+ */
+static size_t fixed_allocations;
+
+static void* fixed_allocate(void*, size_t size)
+{
+    ++fixed_allocations;
+
+    return malloc(size);
+}
+
+static void fixed_release(void*, void* mem)
+{
+    free(mem);
+}
+
+static void* fixed_reallocate(void*, void* mem, size_t, size_t new_size)
+{
+    ++fixed_allocations;
+
+    return realloc(mem, new_size);
+}
+
+static void fixed_dispose(void*)
+{
+}
+
+/**
+ * \brief Test fixture with an in-memory database holding fixed size records,
+ * which counts the library's allocations.
+ */
+class datastore_serial_data_size : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_memory_database();
+
+        memset(&alloc_opts, 0, sizeof(alloc_opts));
+        alloc_opts.hdr.dispose = &fixed_dispose;
+        alloc_opts.allocator_allocate = &fixed_allocate;
+        alloc_opts.allocator_release = &fixed_release;
+        alloc_opts.allocator_reallocate = &fixed_reallocate;
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_datastore_init(
+                &datastore, "fixed", sizeof(fixed_value_t),
+                &fixed_key_getter, &fixed_value_reader,
+                &fixed_value_writer));
+    }
+
+    void open()
+    {
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init_with_allocator(
+                &builder, &alloc_opts, MEMORY_DATABASE_ENGINE,
+                "datastore_serial_data_size"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        vcdb_database_delete_using_builder(&builder);
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Put a value and read it back.
+     */
+    void put_get()
+    {
+        fixed_value_t value, read;
+        vcdb_transaction_t txn;
+
+        memset(&value, 0x33, sizeof(value));
+        value.payload[79] = 0x77;
+
+        size_t value_size = sizeof(value);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_transaction_begin(&txn, &database));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_datastore_put(
+                &txn, &datastore, &value, &value_size));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&txn));
+
+        size_t read_size = sizeof(read);
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_datastore_get(
+                &database, &datastore, value.uuid, 16, &read, &read_size));
+        EXPECT_EQ(0, memcmp(&value, &read, sizeof(value)));
+    }
+
+    allocator_options_t alloc_opts;
+    vcdb_datastore_t datastore;
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+};
+
+/**
+ * Test that the serial data size can be set on a datastore.
+ */
+TEST(datastore_serial_data_size_set, happy_path)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    /* by default, serialized values are unbounded. */
+    EXPECT_EQ(0U, datastore.serial_data_size);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_serial_data_size_set(&datastore, 96));
+
+    EXPECT_EQ(96U, datastore.serial_data_size);
+
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that setting the serial data size fails on invalid parameters.
+ */
+TEST(datastore_serial_data_size_set, bad_params)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_serial_data_size_set(NULL, 96));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_serial_data_size_set(&datastore, 0));
+
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that an unbounded datastore allocates serialization buffers.
+ */
+TEST_F(datastore_serial_data_size, unbounded_allocates)
+{
+    open();
+
+    fixed_allocations = 0;
+    put_get();
+
+    EXPECT_LT(0U, fixed_allocations);
+}
+
+/**
+ * Test that puts and gets against a bounded datastore don't allocate.
+ */
+TEST_F(datastore_serial_data_size, bounded_does_not_allocate)
+{
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_serial_data_size_set(
+            &datastore, sizeof(fixed_value_t)));
+    open();
+
+    fixed_allocations = 0;
+    put_get();
+
+    EXPECT_EQ(0U, fixed_allocations);
+}
+
+/**
+ * Test that a value larger than the declared size is still handled.
+ */
+TEST_F(datastore_serial_data_size, undersized_bound)
+{
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_serial_data_size_set(&datastore, 8));
+    open();
+
+    put_get();
+}
@@ -0,0 +1,58 @@
+/**
+ * \file test_datastore_value_merger_set.cpp
+ *
+ * \brief Test the vcdb_datastore_value_merger_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/datastore.h>
+
+#include "../test_datastore.h"
+
+/**
+ * \brief Dummy merge method.
+ */
+static int test_value_merger(
+    const void*, size_t, const void*, size_t, void*, size_t*)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * Test that a merge method can be set on a datastore.
+ */
+TEST(datastore_value_merger_set, happy_path)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    /* by default, there is no merge method. */
+    EXPECT_EQ(nullptr, datastore.value_merger);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+
+    EXPECT_EQ(&test_value_merger, datastore.value_merger);
+
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that setting a merge method fails on invalid parameters.
+ */
+TEST(datastore_value_merger_set, bad_params)
+{
+    vcdb_datastore_t datastore;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_value_merger_set(NULL, &test_value_merger));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_datastore_value_merger_set(&datastore, NULL));
+
+    dispose((disposable_t*)&datastore);
+}
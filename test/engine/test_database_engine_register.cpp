@@ -0,0 +1,123 @@
+/**
+ * \file test_database_engine_register.cpp
+ *
+ * \brief Test the vcdb_database_engine_register() and
+ * vcdb_database_engine_lookup() methods.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vcdb/engine.h>
+#include <vector>
+
+/**
+ * Test that a registered engine can be looked up by name.
+ */
+TEST(database_engine_register, register_lookup)
+{
+    vcdb_database_engine_t engine;
+
+    vcdb_database_engine_register(&engine, "REGISTER_LOOKUP");
+
+    EXPECT_EQ(&engine, vcdb_database_engine_lookup("REGISTER_LOOKUP"));
+}
+
+/**
+ * Test that looking up an unregistered engine returns NULL.
+ */
+TEST(database_engine_register, lookup_missing)
+{
+    EXPECT_EQ(nullptr, vcdb_database_engine_lookup("NO_SUCH_ENGINE"));
+}
+
+/**
+ * Test that the first registration of a name wins.
+ */
+TEST(database_engine_register, first_registration_wins)
+{
+    vcdb_database_engine_t first;
+    vcdb_database_engine_t second;
+
+    vcdb_database_engine_register(&first, "FIRST_WINS");
+    vcdb_database_engine_register(&second, "FIRST_WINS");
+
+    EXPECT_EQ(&first, vcdb_database_engine_lookup("FIRST_WINS"));
+}
+
+/**
+ * Test that many engines can be registered, well beyond the bucket count.
+ */
+TEST(database_engine_register, many_engines)
+{
+    static vcdb_database_engine_t engines[500];
+
+    for (size_t i = 0; i < 500; ++i)
+    {
+        std::string name = "MANY_" + std::to_string(i);
+        vcdb_database_engine_register(&engines[i], name.c_str());
+    }
+
+    for (size_t i = 0; i < 500; ++i)
+    {
+        std::string name = "MANY_" + std::to_string(i);
+        EXPECT_EQ(&engines[i], vcdb_database_engine_lookup(name.c_str()));
+    }
+}
+
+/**
+ * Test that concurrent registration and lookup from several threads sees
+ * every engine exactly as it was registered.
+ */
+TEST(database_engine_register, concurrent)
+{
+    const size_t THREADS = 8;
+    const size_t PER_THREAD = 100;
+    static vcdb_database_engine_t engines[THREADS][PER_THREAD];
+    static vcdb_database_engine_t shared[THREADS];
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([t]() {
+            /* every thread races to register the same name. */
+            vcdb_database_engine_register(&shared[t], "CONCURRENT_SHARED");
+
+            for (size_t i = 0; i < PER_THREAD; ++i)
+            {
+                std::string name =
+                    "CONCURRENT_" + std::to_string(t) + "_"
+                  + std::to_string(i);
+                vcdb_database_engine_register(
+                    &engines[t][i], name.c_str());
+
+                /* our own registration is immediately visible. */
+                EXPECT_EQ(
+                    &engines[t][i], vcdb_database_engine_lookup(name.c_str()));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    /* exactly one of the racing registrations won. */
+    vcdb_database_engine_t* winner =
+        vcdb_database_engine_lookup("CONCURRENT_SHARED");
+    EXPECT_LE(&shared[0], winner);
+    EXPECT_GT(&shared[THREADS], winner);
+
+    for (size_t t = 0; t < THREADS; ++t)
+    {
+        for (size_t i = 0; i < PER_THREAD; ++i)
+        {
+            std::string name =
+                "CONCURRENT_" + std::to_string(t) + "_" + std::to_string(i);
+            EXPECT_EQ(&engines[t][i], vcdb_database_engine_lookup(name.c_str()));
+        }
+    }
+}
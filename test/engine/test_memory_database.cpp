@@ -0,0 +1,277 @@
+/**
+ * \file test_memory_database.cpp
+ *
+ * \brief Test the in-memory database engine through the public interface.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/index.h>
+#include <vcdb/transaction.h>
+
+#include "../memory_database.h"
+
+/**
+ * \brief A value with a primary key and a group used as secondary key.
+ */
+typedef struct memory_value
+{
+    char key[8];
+    char group[8];
+    uint32_t count;
+} memory_value_t;
+
+/**
+ * \brief Get the primary key of a value.
+ */
+static void memory_key_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const memory_value_t*)value)->key, 8);
+    *key_size = 8;
+}
+
+/**
+ * \brief Get the group of a value.
+ */
+static void memory_group_getter(
+    const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const memory_value_t*)value)->group, 8);
+    *key_size = 8;
+}
+
+/**
+ * \brief Read a value by copying it.
+ */
+static int memory_value_reader(const void* input, size_t size, void* value)
+{
+    if (sizeof(memory_value_t) != size)
+    {
+        return VCDB_ERROR_DATABASE_ENGINE;
+    }
+
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write a value by copying it.
+ */
+static int memory_value_writer(const void* value, void* output, size_t* size)
+{
+    if (*size < sizeof(memory_value_t))
+    {
+        *size = sizeof(memory_value_t);
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(output, value, sizeof(memory_value_t));
+    *size = sizeof(memory_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Test fixture with a fresh in-memory database.
+ */
+class memory_database : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_memory_database();
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_datastore_init(
+                &datastore, "values", sizeof(memory_value_t),
+                &memory_key_getter, &memory_value_reader,
+                &memory_value_writer));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_index_init(&index, &datastore, "groups",
+                &memory_group_getter));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, MEMORY_DATABASE_ENGINE, "memory"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_index(&builder, &index));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        vcdb_database_delete_using_builder(&builder);
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Put a value in its own transaction, then commit or roll back.
+     */
+    void put(const char* key, const char* group, uint32_t count, bool commit)
+    {
+        memory_value_t value;
+        size_t value_size = sizeof(value);
+        vcdb_transaction_t transaction;
+
+        memset(&value, 0, sizeof(value));
+        memcpy(value.key, key, strnlen(key, sizeof(value.key)));
+        memcpy(value.group, group, strnlen(group, sizeof(value.group)));
+        value.count = count;
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_transaction_begin(&transaction, &database));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_datastore_put(
+                &transaction, &datastore, &value, &value_size));
+        if (commit)
+        {
+            ASSERT_EQ(VCDB_STATUS_SUCCESS,
+                vcdb_transaction_commit(&transaction));
+        }
+        else
+        {
+            ASSERT_EQ(VCDB_STATUS_SUCCESS,
+                vcdb_transaction_rollback(&transaction));
+        }
+        dispose((disposable_t*)&transaction);
+    }
+
+    /**
+     * \brief Get a value by primary key, returning the status code.
+     */
+    int get(const char* key, memory_value_t* value)
+    {
+        char k[8];
+        size_t value_size = sizeof(*value);
+
+        memset(k, 0, sizeof(k));
+        memcpy(k, key, strnlen(key, sizeof(k)));
+
+        return
+            vcdb_database_datastore_get(
+                &database, &datastore, k, sizeof(k), value, &value_size);
+    }
+
+    /**
+     * \brief Get a value by group, returning the status code.
+     */
+    int index_get(const char* group, memory_value_t* value)
+    {
+        char k[8];
+        size_t value_size = sizeof(*value);
+
+        memset(k, 0, sizeof(k));
+        memcpy(k, group, strnlen(group, sizeof(k)));
+
+        return
+            vcdb_database_index_get(
+                &database, &index, k, sizeof(k), value, &value_size);
+    }
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+};
+
+/**
+ * Test that committed values can be read by primary and secondary key.
+ */
+TEST_F(memory_database, put_get)
+{
+    memory_value_t value;
+
+    put("alpha", "red", 7, true);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_STREQ("red", value.group);
+    EXPECT_EQ(7U, value.count);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, index_get("red", &value));
+    EXPECT_STREQ("alpha", value.key);
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("beta", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("blue", &value));
+}
+
+/**
+ * Test that an update moves the value's index entry.
+ */
+TEST_F(memory_database, update)
+{
+    memory_value_t value;
+
+    put("alpha", "red", 7, true);
+    put("alpha", "blue", 8, true);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+    EXPECT_EQ(8U, value.count);
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("red", &value));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, index_get("blue", &value));
+}
+
+/**
+ * Test that a rolled back transaction leaves nothing behind.
+ */
+TEST_F(memory_database, rollback)
+{
+    memory_value_t value;
+
+    put("alpha", "red", 7, false);
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("alpha", &value));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, index_get("red", &value));
+}
+
+/**
+ * Test that deleting by secondary key removes the primary value.
+ */
+TEST_F(memory_database, index_delete)
+{
+    memory_value_t value;
+    vcdb_transaction_t transaction;
+    char group[8] = "red";
+    size_t group_size = sizeof(group);
+
+    put("alpha", "red", 7, true);
+    put("beta", "blue", 8, true);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_delete(&transaction, &index, group, &group_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("alpha", &value));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, get("beta", &value));
+}
+
+/**
+ * Test that data survives reopening until the database is deleted.
+ */
+TEST_F(memory_database, reopen)
+{
+    memory_value_t value;
+
+    put("alpha", "red", 7, true);
+
+    dispose((disposable_t*)&database);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_open_from_builder(&database, &builder));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, get("alpha", &value));
+
+    dispose((disposable_t*)&database);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_delete_using_builder(&builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_open_from_builder(&database, &builder));
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get("alpha", &value));
+}
@@ -0,0 +1,65 @@
+/**
+ * \file test_null_database.cpp
+ *
+ * \brief Test the null database engine through the public interface.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/transaction.h>
+
+#include "../null_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that reads succeed, reporting the datastore's data size, and that
+ * writes are discarded.
+ */
+TEST(null_database, calls_succeed)
+{
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_database_t database;
+    vcdb_transaction_t transaction;
+    test_value_t value;
+    size_t value_size = sizeof(value);
+
+    register_null_database();
+    test_datastore_reset();
+
+    memset(&value, 0, sizeof(value));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, NULL_DATABASE_ENGINE, "null"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* the value reader sees a value of the datastore's data size. */
+    EXPECT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &datastore, value.test_key, sizeof(value.test_key),
+            &value, &value_size));
+    EXPECT_TRUE(test_value_reader_called);
+    EXPECT_EQ(sizeof(test_value_t), test_value_reader_param_size);
+
+    EXPECT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_contains(
+            &database, &datastore, value.test_key, sizeof(value.test_key)));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
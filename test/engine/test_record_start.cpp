@@ -0,0 +1,299 @@
+/**
+ * \file test_record_start.cpp
+ *
+ * \brief Test the record engine and the vcdb_record_start() and
+ * vcdb_record_stop() methods.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/engine.h>
+#include <vcdb/index.h>
+#include <vcdb/record.h>
+#include <vcdb/transaction.h>
+#include <vector>
+
+#include "../memory_database.h"
+
+using namespace std;
+
+/**
+ * \brief A value with a primary key and a secondary key.
+ */
+typedef struct record_value
+{
+    char key[8];
+    char group[8];
+} record_value_t;
+
+/**
+ * \brief Get the primary key of a value.
+ */
+static void record_key_getter(const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const record_value_t*)value)->key, 8);
+    *key_size = 8;
+}
+
+/**
+ * \brief Get the secondary key of a value.
+ */
+static void record_group_getter(
+    const void* value, void* key, size_t* key_size)
+{
+    memcpy(key, ((const record_value_t*)value)->group, 8);
+    *key_size = 8;
+}
+
+/**
+ * \brief Read a value by copying it.
+ */
+static int record_value_reader(const void* input, size_t size, void* value)
+{
+    memcpy(value, input, size);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write a value by copying it.
+ */
+static int record_value_writer(const void* value, void* output, size_t* size)
+{
+    memcpy(output, value, sizeof(record_value_t));
+    *size = sizeof(record_value_t);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief A record read back from a record file.
+ */
+struct record_entry
+{
+    vcdb_record_header_t header;
+    string name;
+    string key;
+    string value;
+    string extra;
+};
+
+/**
+ * \brief Read all records of a record file.
+ */
+static bool record_file_read(const char* path, vector<record_entry>* records)
+{
+    FILE* file = fopen(path, "rb");
+    char magic[VCDB_RECORD_MAGIC_SIZE];
+
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    if (1 != fread(magic, sizeof(magic), 1, file)
+     || 0 != memcmp(magic, VCDB_RECORD_MAGIC, sizeof(magic)))
+    {
+        fclose(file);
+        return false;
+    }
+
+    record_entry entry;
+    while (1 == fread(&entry.header, sizeof(entry.header), 1, file))
+    {
+        string* parts[] = {
+            &entry.name, &entry.key, &entry.value, &entry.extra };
+        uint32_t sizes[] = {
+            entry.header.name_size, entry.header.key_size,
+            entry.header.value_size, entry.header.extra_size };
+
+        for (int i = 0; i < 4; ++i)
+        {
+            parts[i]->resize(sizes[i]);
+            if (sizes[i] > 0 && 1 != fread(&(*parts[i])[0], sizes[i], 1, file))
+            {
+                fclose(file);
+                return false;
+            }
+        }
+
+        records->push_back(entry);
+    }
+
+    fclose(file);
+
+    return true;
+}
+
+/**
+ * Test that operations are recorded while recording is started.
+ */
+TEST(record_start, happy_path)
+{
+    const char* ENGINE = VCDB_RECORD_ENGINE_PREFIX MEMORY_DATABASE_ENGINE;
+    char path[] = "/tmp/vcdb_record_XXXXXX";
+    vcdb_builder_t builder;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    vcdb_database_t database;
+    vcdb_transaction_t transaction;
+    record_value_t value = { "alpha", "red" };
+    size_t value_size = sizeof(value);
+    vector<record_entry> records;
+
+    int fd = mkstemp(path);
+    ASSERT_LE(0, fd);
+    close(fd);
+
+    register_memory_database();
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_record_engine_register(MEMORY_DATABASE_ENGINE));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_init(
+            &datastore, "values", sizeof(record_value_t), &record_key_getter,
+            &record_value_reader, &record_value_writer));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_index_init(&index, &datastore, "groups", &record_group_getter));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, ENGINE, "record"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+
+    /* calls before recording starts are not recorded. */
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND,
+        vcdb_database_datastore_get(
+            &database, &datastore, value.key, sizeof(value.key), &value,
+            &value_size));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_record_start(ENGINE, path));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put(
+            &transaction, &datastore, &value, &value_size));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    value_size = sizeof(value);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_index_get(
+            &database, &index, value.group, sizeof(value.group), &value,
+            &value_size));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_record_stop(ENGINE));
+
+    /* calls after recording stops are not recorded. */
+    value_size = sizeof(value);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_get(
+            &database, &datastore, value.key, sizeof(value.key), &value,
+            &value_size));
+
+    dispose((disposable_t*)&database);
+    vcdb_database_delete_using_builder(&builder);
+    dispose((disposable_t*)&builder);
+
+    ASSERT_TRUE(record_file_read(path, &records));
+    unlink(path);
+
+    ASSERT_EQ(4U, records.size());
+
+    EXPECT_EQ((uint32_t)VCDB_RECORD_OP_TRANSACTION_BEGIN,
+        records[0].header.op);
+    EXPECT_NE(0U, records[0].header.transaction);
+
+    /* the put carries the serialized value and its secondary keys. */
+    EXPECT_EQ((uint32_t)VCDB_RECORD_OP_DATASTORE_PUT, records[1].header.op);
+    EXPECT_EQ(records[0].header.transaction, records[1].header.transaction);
+    EXPECT_EQ("values", records[1].name);
+    EXPECT_EQ(string("alpha\0\0\0", 8), records[1].key);
+    EXPECT_EQ(sizeof(record_value_t), records[1].value.size());
+    ASSERT_EQ(sizeof(vcdb_record_index_key_t) + 6 + 8,
+        records[1].extra.size());
+    EXPECT_EQ("groups", records[1].extra.substr(8, 6));
+    EXPECT_EQ(string("red\0\0\0\0\0", 8), records[1].extra.substr(14));
+
+    EXPECT_EQ((uint32_t)VCDB_RECORD_OP_TRANSACTION_COMMIT,
+        records[2].header.op);
+    EXPECT_EQ(records[0].header.transaction, records[2].header.transaction);
+
+    EXPECT_EQ((uint32_t)VCDB_RECORD_OP_INDEX_GET, records[3].header.op);
+    EXPECT_EQ(0U, records[3].header.transaction);
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, records[3].header.status);
+    EXPECT_EQ("groups", records[3].name);
+    EXPECT_EQ("values", records[3].extra);
+
+    /* all calls were made from this thread, in order. */
+    for (auto& record : records)
+    {
+        EXPECT_EQ(records[0].header.thread, record.header.thread);
+        EXPECT_LE(records[0].header.time, record.header.time);
+        EXPECT_EQ(sizeof(vcdb_record_header_t) + record.name.size()
+                + record.key.size() + record.value.size()
+                + record.extra.size(),
+            record.header.size);
+    }
+}
+
+/**
+ * Test that record engines are only registered on request.
+ */
+TEST(record_engine, register)
+{
+    static vcdb_database_engine_t unrecorded_engine;
+
+    register_memory_database();
+    unrecorded_engine = *vcdb_database_engine_lookup(MEMORY_DATABASE_ENGINE);
+    vcdb_database_engine_register(&unrecorded_engine, "MEMDB_UNRECORDED");
+
+    /* looking up a record engine does not register it. */
+    EXPECT_EQ(nullptr, vcdb_database_engine_lookup("record:MEMDB_UNRECORDED"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_record_engine_register("MEMDB_UNRECORDED"));
+    vcdb_database_engine_t* record =
+        vcdb_database_engine_lookup("record:MEMDB_UNRECORDED");
+    EXPECT_NE(nullptr, record);
+
+    /* registering it again keeps the first record engine. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_record_engine_register("MEMDB_UNRECORDED"));
+    EXPECT_EQ(record, vcdb_database_engine_lookup("record:MEMDB_UNRECORDED"));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER, vcdb_record_engine_register(NULL));
+    EXPECT_EQ(VCDB_ERROR_MISSING_DATABASE_ENGINE,
+        vcdb_record_engine_register("NO_SUCH_ENGINE"));
+    EXPECT_EQ(nullptr, vcdb_database_engine_lookup("record:NO_SUCH_ENGINE"));
+}
+
+/**
+ * Test that recording needs a record engine.
+ */
+TEST(record_start, bad_engine)
+{
+    register_memory_database();
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_record_engine_register(MEMORY_DATABASE_ENGINE));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_record_start(NULL, "/tmp/unused"));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_record_start(MEMORY_DATABASE_ENGINE, "/tmp/unused"));
+    EXPECT_EQ(VCDB_ERROR_MISSING_DATABASE_ENGINE,
+        vcdb_record_start("record:NO_SUCH_ENGINE", "/tmp/unused"));
+    EXPECT_EQ(VCDB_ERROR_RECORD_FILE,
+        vcdb_record_start(
+            VCDB_RECORD_ENGINE_PREFIX MEMORY_DATABASE_ENGINE,
+            "/nonexistent/dir/file"));
+}
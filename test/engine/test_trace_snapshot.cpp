@@ -0,0 +1,227 @@
+/**
+ * \file test_trace_snapshot.cpp
+ *
+ * \brief Test the trace engine and the vcdb_trace_snapshot() and
+ * vcdb_trace_slow_threshold_set() methods.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/engine.h>
+#include <vcdb/trace.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * \brief Test fixture with a database using the trace engine for TESTDB.
+ */
+class trace_snapshot : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        register_test_database();
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_trace_engine_register("TESTDB"));
+
+        ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_init(&builder, "trace:TESTDB", "test-dir"));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_builder_add_datastore(&builder, &datastore));
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_database_create_from_builder(&database, &builder));
+
+        /* totals are kept for the life of the process. */
+        ASSERT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_trace_snapshot("trace:TESTDB", &before));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&database);
+        dispose((disposable_t*)&builder);
+    }
+
+    /**
+     * \brief Get a value, returning the status code.
+     */
+    int get()
+    {
+        test_value_t value;
+        size_t value_size = sizeof(value);
+
+        memset(&value, 0, sizeof(value));
+
+        return
+            vcdb_database_datastore_get(
+                &database, &datastore, value.test_key, sizeof(value.test_key),
+                &value, &value_size);
+    }
+
+    /**
+     * \brief Get the change in a method's totals since SetUp().
+     */
+    vcdb_trace_method_stats_t delta(vcdb_trace_method_t method)
+    {
+        vcdb_trace_snapshot_t after;
+        vcdb_trace_method_stats_t d;
+
+        EXPECT_EQ(VCDB_STATUS_SUCCESS,
+            vcdb_trace_snapshot("trace:TESTDB", &after));
+
+        d = after.methods[method];
+        d.calls -= before.methods[method].calls;
+        d.errors -= before.methods[method].errors;
+        d.not_found -= before.methods[method].not_found;
+        d.bytes -= before.methods[method].bytes;
+
+        return d;
+    }
+
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_trace_snapshot_t before;
+};
+
+/**
+ * Test that calls are forwarded to the inner engine and recorded.
+ */
+TEST_F(trace_snapshot, forward)
+{
+    test_datastore_get_called = false;
+    EXPECT_EQ(VCDB_STATUS_SUCCESS, get());
+    EXPECT_TRUE(test_datastore_get_called);
+
+    test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get());
+
+    test_datastore_get_retval = VCDB_ERROR_DATABASE_ENGINE;
+    EXPECT_EQ(VCDB_ERROR_DATABASE_ENGINE, get());
+
+    vcdb_trace_method_stats_t d = delta(VCDB_TRACE_METHOD_DATASTORE_GET);
+    EXPECT_EQ(3U, d.calls);
+    EXPECT_EQ(1U, d.not_found);
+    EXPECT_EQ(1U, d.errors);
+    EXPECT_EQ(VCDB_ERROR_DATABASE_ENGINE, d.last_error);
+    EXPECT_LT(0U, d.bytes);
+}
+
+/**
+ * Test that calls slower than the threshold are sampled.
+ */
+TEST_F(trace_snapshot, slow_samples)
+{
+    vcdb_trace_snapshot_t snapshot;
+
+    /* every call is slower than a zero threshold. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_trace_slow_threshold_set("trace:TESTDB", 0));
+    test_datastore_get_retval = VCDB_ERROR_VALUE_NOT_FOUND;
+    for (int i = 0; i < VCDB_TRACE_SAMPLES + 1; ++i)
+    {
+        EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, get());
+    }
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_trace_slow_threshold_set(
+            "trace:TESTDB", VCDB_TRACE_DEFAULT_SLOW_THRESHOLD));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_trace_snapshot("trace:TESTDB", &snapshot));
+    ASSERT_EQ((size_t)VCDB_TRACE_SAMPLES, snapshot.sample_count);
+
+    /* the newest sample is the last get. */
+    vcdb_trace_sample_t* s = &snapshot.samples[VCDB_TRACE_SAMPLES - 1];
+    EXPECT_EQ(VCDB_TRACE_METHOD_DATASTORE_GET, s->method);
+    EXPECT_EQ(datastore.correlation_id, s->correlation_id);
+    EXPECT_EQ(VCDB_ERROR_VALUE_NOT_FOUND, s->status);
+}
+
+/**
+ * Test that transaction methods are forwarded and recorded.
+ */
+TEST_F(trace_snapshot, transaction)
+{
+    vcdb_transaction_t transaction;
+
+    test_transaction_begin_called = false;
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    EXPECT_TRUE(test_transaction_begin_called);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    dispose((disposable_t*)&transaction);
+
+    EXPECT_EQ(1U, delta(VCDB_TRACE_METHOD_TRANSACTION_BEGIN).calls);
+    EXPECT_EQ(1U, delta(VCDB_TRACE_METHOD_TRANSACTION_ROLLBACK).calls);
+    EXPECT_EQ(0U, delta(VCDB_TRACE_METHOD_TRANSACTION_COMMIT).calls);
+}
+
+/**
+ * Test that optional methods the inner engine lacks stay unsupported.
+ */
+TEST(trace_engine, optional_methods)
+{
+    register_test_database();
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_trace_engine_register("TESTDB_MINIMAL"));
+
+    vcdb_database_engine_t* inner =
+        vcdb_database_engine_lookup("TESTDB_MINIMAL");
+    vcdb_database_engine_t* trace =
+        vcdb_database_engine_lookup("trace:TESTDB_MINIMAL");
+
+    ASSERT_NE(nullptr, inner);
+    ASSERT_NE(nullptr, trace);
+    EXPECT_EQ(nullptr, trace->datastore_merge);
+    EXPECT_NE(nullptr, trace->datastore_get);
+    EXPECT_NE(inner->datastore_get, trace->datastore_get);
+
+    /* registering again keeps the same trace engine. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_trace_engine_register("TESTDB_MINIMAL"));
+    EXPECT_EQ(trace, vcdb_database_engine_lookup("trace:TESTDB_MINIMAL"));
+}
+
+/**
+ * Test that trace engines are only registered explicitly.
+ */
+TEST(trace_engine, register)
+{
+    static vcdb_database_engine_t untraced_engine;
+
+    register_test_database();
+    untraced_engine = *vcdb_database_engine_lookup("TESTDB");
+    vcdb_database_engine_register(&untraced_engine, "TESTDB_UNTRACED");
+
+    /* looking up a trace engine does not register it. */
+    EXPECT_EQ(nullptr, vcdb_database_engine_lookup("trace:TESTDB_UNTRACED"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_trace_engine_register("TESTDB_UNTRACED"));
+    EXPECT_NE(nullptr, vcdb_database_engine_lookup("trace:TESTDB_UNTRACED"));
+
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER, vcdb_trace_engine_register(NULL));
+    EXPECT_EQ(VCDB_ERROR_MISSING_DATABASE_ENGINE,
+        vcdb_trace_engine_register("NO_SUCH_ENGINE"));
+    EXPECT_EQ(nullptr, vcdb_database_engine_lookup("trace:NO_SUCH_ENGINE"));
+}
+
+/**
+ * Test that snapshots need a trace engine.
+ */
+TEST(trace_engine, bad_engine)
+{
+    vcdb_trace_snapshot_t snapshot;
+
+    register_test_database();
+
+    EXPECT_EQ(nullptr, vcdb_database_engine_lookup("trace:NO_SUCH_ENGINE"));
+    EXPECT_EQ(VCDB_ERROR_MISSING_DATABASE_ENGINE,
+        vcdb_trace_snapshot("trace:NO_SUCH_ENGINE", &snapshot));
+    EXPECT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_trace_snapshot("TESTDB", &snapshot));
+}
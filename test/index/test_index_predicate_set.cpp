@@ -0,0 +1,74 @@
+/**
+ * \file test_index_predicate_set.cpp
+ *
+ * \brief Test the vcdb_index_predicate_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vcdb/index.h>
+
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * \brief Only index values which are pending.
+ */
+static bool test_predicate(const void* value)
+{
+    const test_value_t* v = (const test_value_t*)value;
+
+    return 0 == strcmp(v->test_value, "pending");
+}
+
+/**
+ * Test that a predicate can be set on an index.
+ */
+TEST(index_predicate_set, happy_path)
+{
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    test_value_t value;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    memset(&value, 0, sizeof(value));
+
+    /* by default, every value is indexed. */
+    EXPECT_EQ(nullptr, index.predicate);
+    EXPECT_TRUE(vcdb_index_value_included(&index, &value));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_index_predicate_set(&index, &test_predicate));
+    EXPECT_EQ(&test_predicate, index.predicate);
+
+    /* only matching values are indexed. */
+    EXPECT_FALSE(vcdb_index_value_included(&index, &value));
+    strcpy(value.test_value, "pending");
+    EXPECT_TRUE(vcdb_index_value_included(&index, &value));
+
+    dispose((disposable_t*)&index);
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that setting a predicate fails on invalid parameters.
+ */
+TEST(index_predicate_set, bad_params)
+{
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_index_predicate_set(NULL, &test_predicate));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_index_predicate_set(&index, NULL));
+
+    dispose((disposable_t*)&index);
+    dispose((disposable_t*)&datastore);
+}
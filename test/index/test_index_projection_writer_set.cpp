@@ -0,0 +1,64 @@
+/**
+ * \file test_index_projection_writer_set.cpp
+ *
+ * \brief Test the vcdb_index_projection_writer_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/index.h>
+
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * \brief Dummy projection writer.
+ */
+static int test_projection_writer(const void*, void*, size_t*)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * Test that a projection writer can be set on an index.
+ */
+TEST(index_projection_writer_set, happy_path)
+{
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+
+    /* by default, an index does not store projections. */
+    EXPECT_EQ(nullptr, index.projection_writer);
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_index_projection_writer_set(&index, &test_projection_writer));
+
+    EXPECT_EQ(&test_projection_writer, index.projection_writer);
+
+    dispose((disposable_t*)&index);
+    dispose((disposable_t*)&datastore);
+}
+
+/**
+ * Test that setting a projection writer fails on invalid parameters.
+ */
+TEST(index_projection_writer_set, bad_params)
+{
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_index_projection_writer_set(NULL, &test_projection_writer));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_index_projection_writer_set(&index, NULL));
+
+    dispose((disposable_t*)&index);
+    dispose((disposable_t*)&datastore);
+}
@@ -0,0 +1,517 @@
+/**
+ * \file memory_database.cpp
+ *
+ * \brief A simple in-memory database engine, used to exercise the library
+ * end to end in tests and benchmarks.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory_database.h"
+
+using namespace std;
+
+/**
+ * \brief A stored value, with the secondary keys under which it is indexed.
+ */
+struct memory_database_record
+{
+    string value;
+    vector<pair<int, string>> secondary_keys;
+};
+
+/**
+ * \brief An in-memory database.
+ *
+ * Datastores map primary keys to records, and indexes map secondary keys to
+ * primary keys, both by correlation ID.
+ */
+struct memory_database_store
+{
+    shared_timed_mutex lock;
+    map<int, map<string, memory_database_record>> datastores;
+    map<int, multimap<string, string>> indexes;
+};
+
+/**
+ * \brief A write buffered in a transaction.
+ */
+struct memory_database_op
+{
+    enum { PUT, DELETE, DELETE_RANGE, INDEX_DELETE } type;
+    int id;
+    string key;
+    string end;
+    memory_database_record record;
+};
+
+/**
+ * \brief The writes buffered in a transaction.
+ */
+struct memory_database_transaction
+{
+    vector<memory_database_op> ops;
+};
+
+/* the in-memory databases, by connection string. */
+static mutex memory_database_stores_lock;
+static map<string, unique_ptr<memory_database_store>> memory_database_stores;
+
+/* forward decls */
+static int memory_database_create(
+    vcdb_database_t* database, vcdb_builder_t* builder);
+static int memory_database_open(
+    vcdb_database_t* database, vcdb_builder_t* builder);
+static void memory_database_close(vcdb_database_t* database);
+static int memory_database_delete(vcdb_builder_t* builder);
+static int memory_datastore_get(
+    vcdb_database_t* database, vcdb_datastore_t* datastore, void* key,
+    size_t key_size, void* value, size_t* value_size);
+static int memory_index_get(
+    vcdb_database_t* database, vcdb_index_t* index, void* key,
+    size_t key_size, void* value, size_t* value_size);
+static int memory_transaction_begin(
+    vcdb_transaction_t* transaction, vcdb_database_t* database);
+static int memory_transaction_commit(vcdb_transaction_t* transaction);
+static int memory_transaction_rollback(vcdb_transaction_t* transaction);
+static int memory_datastore_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size, void* value, size_t* value_size);
+static int memory_datastore_delete(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size);
+static int memory_index_delete(
+    vcdb_transaction_t* transaction, vcdb_index_t* index, void* key,
+    size_t* key_size);
+static int memory_datastore_delete_range(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    void* start, size_t* start_size, void* end, size_t* end_size);
+
+/* the engine, with only range deletes of the optional methods. */
+static bool memory_database_registered = false;
+static vcdb_database_engine_t memory_database_engine = {
+    &memory_database_create,
+    &memory_database_open,
+    &memory_database_close,
+    &memory_database_delete,
+    &memory_datastore_get,
+    &memory_index_get,
+    &memory_transaction_begin,
+    &memory_transaction_commit,
+    &memory_transaction_rollback,
+    &memory_datastore_put,
+    &memory_datastore_delete,
+    &memory_index_delete,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    &memory_datastore_delete_range,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+/**
+ * \brief Register the in-memory database engine.
+ */
+void register_memory_database()
+{
+    if (!memory_database_registered)
+    {
+        vcdb_database_engine_register(
+            &memory_database_engine, MEMORY_DATABASE_ENGINE);
+        memory_database_registered = true;
+    }
+}
+
+/**
+ * \brief Get the store of a database.
+ */
+static memory_database_store* memory_database_store_get(
+    vcdb_database_t* database)
+{
+    return (memory_database_store*)database->database_engine_context;
+}
+
+/**
+ * \brief Get the buffered writes of a transaction.
+ */
+static memory_database_transaction* memory_database_transaction_get(
+    vcdb_transaction_t* transaction)
+{
+    return (memory_database_transaction*)
+        transaction->transaction_engine_context;
+}
+
+/**
+ * \brief Copy a stored value to the caller's buffer.
+ */
+static int memory_database_value_copy(
+    const string& stored, void* value, size_t* value_size)
+{
+    if (*value_size < stored.size())
+    {
+        *value_size = stored.size();
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    memcpy(value, stored.data(), stored.size());
+    *value_size = stored.size();
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Remove a record and its index entries from a store.
+ */
+static void memory_database_record_erase(
+    memory_database_store* store, int id, const string& key)
+{
+    auto& datastore = store->datastores[id];
+    auto record = datastore.find(key);
+    if (datastore.end() == record)
+    {
+        return;
+    }
+
+    for (auto& secondary : record->second.secondary_keys)
+    {
+        auto& index = store->indexes[secondary.first];
+        auto range = index.equal_range(secondary.second);
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (i->second == key)
+            {
+                index.erase(i);
+                break;
+            }
+        }
+    }
+
+    datastore.erase(record);
+}
+
+/**
+ * \brief Create or replace the in-memory database for a connection string.
+ */
+static int memory_database_create(
+    vcdb_database_t* database, vcdb_builder_t* builder)
+{
+    lock_guard<mutex> guard(memory_database_stores_lock);
+
+    auto& store = memory_database_stores[builder->connection_string];
+    store.reset(new memory_database_store);
+    database->database_engine_context = store.get();
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Open the in-memory database for a connection string, creating it if
+ * it does not exist.
+ */
+static int memory_database_open(
+    vcdb_database_t* database, vcdb_builder_t* builder)
+{
+    lock_guard<mutex> guard(memory_database_stores_lock);
+
+    auto& store = memory_database_stores[builder->connection_string];
+    if (!store)
+    {
+        store.reset(new memory_database_store);
+    }
+
+    database->database_engine_context = store.get();
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Close a database.  The data stays in memory.
+ */
+static void memory_database_close(vcdb_database_t* database)
+{
+    database->database_engine_context = NULL;
+}
+
+/**
+ * \brief Discard the in-memory database for a connection string.
+ */
+static int memory_database_delete(vcdb_builder_t* builder)
+{
+    lock_guard<mutex> guard(memory_database_stores_lock);
+
+    memory_database_stores.erase(builder->connection_string);
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Get a committed value by primary key.
+ */
+static int memory_datastore_get(
+    vcdb_database_t* database, vcdb_datastore_t* datastore, void* key,
+    size_t key_size, void* value, size_t* value_size)
+{
+    memory_database_store* store = memory_database_store_get(database);
+    shared_lock<shared_timed_mutex> guard(store->lock);
+
+    auto& values = store->datastores[datastore->correlation_id];
+    auto record = values.find(string((const char*)key, key_size));
+    if (values.end() == record)
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    return memory_database_value_copy(record->second.value, value, value_size);
+}
+
+/**
+ * \brief Get a committed value by secondary key.
+ */
+static int memory_index_get(
+    vcdb_database_t* database, vcdb_index_t* index, void* key,
+    size_t key_size, void* value, size_t* value_size)
+{
+    memory_database_store* store = memory_database_store_get(database);
+    shared_lock<shared_timed_mutex> guard(store->lock);
+
+    auto& entries = store->indexes[index->correlation_id];
+    auto entry = entries.find(string((const char*)key, key_size));
+    if (entries.end() == entry)
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    auto& values = store->datastores[index->datastore->correlation_id];
+    auto record = values.find(entry->second);
+    if (values.end() == record)
+    {
+        return VCDB_ERROR_VALUE_NOT_FOUND;
+    }
+
+    return memory_database_value_copy(record->second.value, value, value_size);
+}
+
+/**
+ * \brief Begin buffering the writes of a transaction.
+ */
+static int memory_transaction_begin(
+    vcdb_transaction_t* transaction, vcdb_database_t* /*database*/)
+{
+    transaction->transaction_engine_context = new memory_database_transaction;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Apply the buffered writes of a transaction atomically.
+ */
+static int memory_transaction_commit(vcdb_transaction_t* transaction)
+{
+    memory_database_store* store =
+        memory_database_store_get(transaction->database);
+    memory_database_transaction* txn =
+        memory_database_transaction_get(transaction);
+
+    {
+        unique_lock<shared_timed_mutex> guard(store->lock);
+
+        for (auto& op : txn->ops)
+        {
+            switch (op.type)
+            {
+                case memory_database_op::PUT:
+                    memory_database_record_erase(store, op.id, op.key);
+                    for (auto& secondary : op.record.secondary_keys)
+                    {
+                        store->indexes[secondary.first].emplace(
+                            secondary.second, op.key);
+                    }
+                    store->datastores[op.id][op.key] = move(op.record);
+                    break;
+
+                case memory_database_op::DELETE:
+                    memory_database_record_erase(store, op.id, op.key);
+                    break;
+
+                case memory_database_op::DELETE_RANGE:
+                {
+                    auto& values = store->datastores[op.id];
+                    auto i = values.lower_bound(op.key);
+                    while (values.end() != i && i->first < op.end)
+                    {
+                        string key = (i++)->first;
+                        memory_database_record_erase(store, op.id, key);
+                    }
+                    break;
+                }
+
+                case memory_database_op::INDEX_DELETE:
+                {
+                    /* op.end holds the datastore ID of the index. */
+                    int datastore_id = stoi(op.end);
+                    auto& entries = store->indexes[op.id];
+                    auto entry = entries.find(op.key);
+                    while (entries.end() != entry)
+                    {
+                        string key = entry->second;
+                        memory_database_record_erase(
+                            store, datastore_id, key);
+                        entry = entries.find(op.key);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    delete txn;
+    transaction->transaction_engine_context = NULL;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Discard the buffered writes of a transaction.
+ */
+static int memory_transaction_rollback(vcdb_transaction_t* transaction)
+{
+    delete memory_database_transaction_get(transaction);
+    transaction->transaction_engine_context = NULL;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Buffer a put, computing the value's secondary keys.
+ */
+static int memory_datastore_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size, void* value, size_t* value_size)
+{
+    memory_database_op op;
+    op.type = memory_database_op::PUT;
+    op.id = datastore->correlation_id;
+    op.key.assign((const char*)key, *key_size);
+    op.record.value.assign((const char*)value, *value_size);
+
+    /* secondary keys are read from the deserialized value. */
+    vcdb_index_t* const* indexes;
+    size_t count;
+    int retval =
+        vcdb_builder_datastore_indexes_get(
+            transaction->database->builder, datastore, &indexes, &count);
+    if (VCDB_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (count > 0)
+    {
+        /* an identity serialized value needs no reader. */
+        vector<char> raw;
+        const void* deserialized = value;
+        if (!datastore->identity_serialization)
+        {
+            raw.resize(datastore->data_size);
+            retval = datastore->value_reader(value, *value_size, raw.data());
+            if (VCDB_STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            deserialized = raw.data();
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!vcdb_index_value_included(indexes[i], deserialized))
+            {
+                continue;
+            }
+
+            char secondary[VCDB_MAX_KEY_SIZE];
+            size_t secondary_size = sizeof(secondary);
+            indexes[i]->secondary_key_getter(
+                deserialized, secondary, &secondary_size);
+            op.record.secondary_keys.emplace_back(
+                indexes[i]->correlation_id,
+                string(secondary, secondary_size));
+        }
+    }
+
+    memory_database_transaction_get(transaction)->ops.push_back(move(op));
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Buffer a delete by primary key.
+ */
+static int memory_datastore_delete(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size)
+{
+    memory_database_op op;
+    op.type = memory_database_op::DELETE;
+    op.id = datastore->correlation_id;
+    op.key.assign((const char*)key, *key_size);
+
+    memory_database_transaction_get(transaction)->ops.push_back(move(op));
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Buffer a delete by secondary key.
+ */
+static int memory_index_delete(
+    vcdb_transaction_t* transaction, vcdb_index_t* index, void* key,
+    size_t* key_size)
+{
+    memory_database_op op;
+    op.type = memory_database_op::INDEX_DELETE;
+    op.id = index->correlation_id;
+    op.key.assign((const char*)key, *key_size);
+    op.end = to_string(index->datastore->correlation_id);
+
+    memory_database_transaction_get(transaction)->ops.push_back(move(op));
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Buffer a delete of the keys in [start, end).
+ */
+static int memory_datastore_delete_range(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    void* start, size_t* start_size, void* end, size_t* end_size)
+{
+    memory_database_op op;
+    op.type = memory_database_op::DELETE_RANGE;
+    op.id = datastore->correlation_id;
+    op.key.assign((const char*)start, *start_size);
+    op.end.assign((const char*)end, *end_size);
+
+    memory_database_transaction_get(transaction)->ops.push_back(move(op));
+
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,34 @@
+/**
+ * \file memory_database.h
+ *
+ * \brief A simple in-memory database engine, used to exercise the library
+ * end to end in tests and benchmarks.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef MEMORY_DATABASE_PRIVATE_HEADER_GUARD
+#define MEMORY_DATABASE_PRIVATE_HEADER_GUARD
+
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/engine.h>
+#include <vcdb/transaction.h>
+
+/**
+ * \brief The name under which the in-memory engine is registered.
+ */
+#define MEMORY_DATABASE_ENGINE "MEMDB"
+
+/**
+ * \brief Register the in-memory database engine.
+ *
+ * Each connection string names a separate in-memory database.  Data survives
+ * closing and reopening the database, and is only discarded when the database
+ * is deleted or created again.  Writes are buffered in the transaction and
+ * applied atomically on commit, so a rolled back transaction leaves nothing
+ * behind.  Keys are ordered bytewise.
+ */
+void register_memory_database();
+
+#endif /*MEMORY_DATABASE_PRIVATE_HEADER_GUARD*/
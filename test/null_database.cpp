@@ -0,0 +1,259 @@
+/**
+ * \file null_database.cpp
+ *
+ * \brief A database engine which does no work, used to measure the overhead
+ * the library adds on top of an engine.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "null_database.h"
+
+/* forward decls */
+static int null_database_create(
+    vcdb_database_t* database, vcdb_builder_t* builder);
+static void null_database_close(vcdb_database_t* database);
+static int null_database_delete(vcdb_builder_t* builder);
+static int null_datastore_get(
+    vcdb_database_t* database, vcdb_datastore_t* datastore, void* key,
+    size_t key_size, void* value, size_t* value_size);
+static int null_index_get(
+    vcdb_database_t* database, vcdb_index_t* index, void* key,
+    size_t key_size, void* value, size_t* value_size);
+static int null_transaction_begin(
+    vcdb_transaction_t* transaction, vcdb_database_t* database);
+static int null_transaction_end(vcdb_transaction_t* transaction);
+static int null_datastore_put(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size, void* value, size_t* value_size);
+static int null_datastore_delete(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size);
+static int null_index_delete(
+    vcdb_transaction_t* transaction, vcdb_index_t* index, void* key,
+    size_t* key_size);
+static int null_datastore_get_versioned(
+    vcdb_database_t* database, vcdb_datastore_t* datastore, void* key,
+    size_t key_size, void* value, size_t* value_size,
+    vcdb_version_t* version);
+static int null_datastore_put_if_version(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore, void* key,
+    size_t* key_size, void* value, size_t* value_size,
+    vcdb_version_t version);
+static int null_datastore_delete_range(
+    vcdb_transaction_t* transaction, vcdb_datastore_t* datastore,
+    void* start, size_t* start_size, void* end, size_t* end_size);
+static int null_datastore_contains(
+    vcdb_database_t* database, vcdb_datastore_t* datastore, void* key,
+    size_t key_size);
+static int null_index_contains(
+    vcdb_database_t* database, vcdb_index_t* index, void* key,
+    size_t key_size);
+
+/* the engine.  merges share the signature of puts. */
+static bool null_database_registered = false;
+static vcdb_database_engine_t null_database_engine = {
+    &null_database_create,
+    &null_database_create,
+    &null_database_close,
+    &null_database_delete,
+    &null_datastore_get,
+    &null_index_get,
+    &null_transaction_begin,
+    &null_transaction_end,
+    &null_transaction_end,
+    &null_datastore_put,
+    &null_datastore_delete,
+    &null_index_delete,
+    NULL,
+    NULL,
+    NULL,
+    &null_datastore_put,
+    &null_datastore_get_versioned,
+    &null_datastore_put_if_version,
+    &null_datastore_delete_range,
+    NULL,
+    NULL,
+    &null_datastore_contains,
+    &null_index_contains,
+    NULL,
+    NULL,
+    NULL
+};
+
+/**
+ * \brief Register the null database engine.
+ */
+void register_null_database()
+{
+    if (!null_database_registered)
+    {
+        vcdb_database_engine_register(
+            &null_database_engine, NULL_DATABASE_ENGINE);
+        null_database_registered = true;
+    }
+}
+
+/**
+ * \brief Create or open a database.
+ */
+static int null_database_create(
+    vcdb_database_t* /*database*/, vcdb_builder_t* /*builder*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Close a database.
+ */
+static void null_database_close(vcdb_database_t* /*database*/)
+{
+}
+
+/**
+ * \brief Delete a database.
+ */
+static int null_database_delete(vcdb_builder_t* /*builder*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Report a value of the given data size without writing it.
+ */
+static int null_value(size_t data_size, size_t* value_size)
+{
+    if (*value_size < data_size)
+    {
+        *value_size = data_size;
+
+        return VCDB_ERROR_WOULD_TRUNCATE;
+    }
+
+    *value_size = data_size;
+
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Get a value by primary key.
+ */
+static int null_datastore_get(
+    vcdb_database_t* /*database*/, vcdb_datastore_t* datastore,
+    void* /*key*/, size_t /*key_size*/, void* /*value*/, size_t* value_size)
+{
+    return null_value(datastore->data_size, value_size);
+}
+
+/**
+ * \brief Get a value by secondary key.
+ */
+static int null_index_get(
+    vcdb_database_t* /*database*/, vcdb_index_t* index, void* /*key*/,
+    size_t /*key_size*/, void* /*value*/, size_t* value_size)
+{
+    return null_value(index->datastore->data_size, value_size);
+}
+
+/**
+ * \brief Begin a transaction.
+ */
+static int null_transaction_begin(
+    vcdb_transaction_t* /*transaction*/, vcdb_database_t* /*database*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Commit or roll back a transaction.
+ */
+static int null_transaction_end(vcdb_transaction_t* /*transaction*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Put a value, or record a merge operand.
+ */
+static int null_datastore_put(
+    vcdb_transaction_t* /*transaction*/, vcdb_datastore_t* /*datastore*/,
+    void* /*key*/, size_t* /*key_size*/, void* /*value*/,
+    size_t* /*value_size*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Delete a value by primary key.
+ */
+static int null_datastore_delete(
+    vcdb_transaction_t* /*transaction*/, vcdb_datastore_t* /*datastore*/,
+    void* /*key*/, size_t* /*key_size*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Delete values by secondary key.
+ */
+static int null_index_delete(
+    vcdb_transaction_t* /*transaction*/, vcdb_index_t* /*index*/,
+    void* /*key*/, size_t* /*key_size*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Get a value and its version, which is always 1.
+ */
+static int null_datastore_get_versioned(
+    vcdb_database_t* /*database*/, vcdb_datastore_t* datastore,
+    void* /*key*/, size_t /*key_size*/, void* /*value*/, size_t* value_size,
+    vcdb_version_t* version)
+{
+    *version = 1;
+
+    return null_value(datastore->data_size, value_size);
+}
+
+/**
+ * \brief Put a value regardless of its version.
+ */
+static int null_datastore_put_if_version(
+    vcdb_transaction_t* /*transaction*/, vcdb_datastore_t* /*datastore*/,
+    void* /*key*/, size_t* /*key_size*/, void* /*value*/,
+    size_t* /*value_size*/, vcdb_version_t /*version*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Delete a range of keys.
+ */
+static int null_datastore_delete_range(
+    vcdb_transaction_t* /*transaction*/, vcdb_datastore_t* /*datastore*/,
+    void* /*start*/, size_t* /*start_size*/, void* /*end*/,
+    size_t* /*end_size*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Check for a primary key, which is always found.
+ */
+static int null_datastore_contains(
+    vcdb_database_t* /*database*/, vcdb_datastore_t* /*datastore*/,
+    void* /*key*/, size_t /*key_size*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Check for a secondary key, which is always found.
+ */
+static int null_index_contains(
+    vcdb_database_t* /*database*/, vcdb_index_t* /*index*/, void* /*key*/,
+    size_t /*key_size*/)
+{
+    return VCDB_STATUS_SUCCESS;
+}
@@ -0,0 +1,33 @@
+/**
+ * \file null_database.h
+ *
+ * \brief A database engine which does no work, used to measure the overhead
+ * the library adds on top of an engine.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#ifndef NULL_DATABASE_PRIVATE_HEADER_GUARD
+#define NULL_DATABASE_PRIVATE_HEADER_GUARD
+
+#include <vcdb/builder.h>
+#include <vcdb/database.h>
+#include <vcdb/engine.h>
+#include <vcdb/transaction.h>
+
+/**
+ * \brief The name under which the null engine is registered.
+ */
+#define NULL_DATABASE_ENGINE "NULLDB"
+
+/**
+ * \brief Register the null database engine.
+ *
+ * Every method returns immediately.  Writes succeed and are discarded.  Reads
+ * succeed without touching the value buffer, reporting a serialized value of
+ * the datastore's data size, so the library's deserialization path still
+ * runs.  Contains checks always find the key.
+ */
+void register_null_database();
+
+#endif /*NULL_DATABASE_PRIVATE_HEADER_GUARD*/
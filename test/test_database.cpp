@@ -6,6 +6,7 @@
  * \copyright 2018 Velo Payments, Inc.  All rights reserved.
  */
 
+#include <string.h>
 #include <vpr/parameters.h>
 
 #include "test_database.h"
@@ -27,8 +28,76 @@ static vcdb_database_engine_t test_database_engine = {
     &test_transaction_rollback,
     &test_datastore_put,
     &test_datastore_delete,
-    &test_index_delete
+    &test_index_delete,
+    &test_transaction_savepoint_set,
+    &test_transaction_savepoint_rollback,
+    &test_transaction_savepoint_release,
+    &test_datastore_merge,
+    &test_datastore_get_versioned,
+    &test_datastore_put_if_version,
+    &test_datastore_delete_range,
+    &test_filter_load,
+    &test_filter_save,
+    &test_datastore_contains,
+    &test_index_contains,
+    &test_index_get_primary_key,
+    &test_index_projection_put,
+    &test_index_get_projection
 };
+static vcdb_database_engine_t test_database_minimal_engine = {
+    &test_database_create,
+    &test_database_open,
+    &test_database_close,
+    &test_database_delete,
+    &test_datastore_get,
+    &test_index_get,
+    &test_transaction_begin,
+    &test_transaction_commit,
+    &test_transaction_rollback,
+    &test_datastore_put,
+    &test_datastore_delete,
+    &test_index_delete,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+/**
+ * \brief Store the mock engine's per-instance object in each handle slot.
+ *
+ * The mock engine has no real storage, so the object for each datastore or
+ * index is simply the instance itself.
+ *
+ * \param builder   The builder whose handles are set.
+ */
+static void test_database_handles_set(vcdb_builder_t* builder)
+{
+    for (size_t i = 0; i < builder->instance_array_size; ++i)
+    {
+        vcdb_builder_datastore_instance_t* inst = &builder->instance_array[i];
+        if (VCDB_BUILDER_INSTANCE_TYPE_DATASTORE == inst->instance_type)
+        {
+            vcdb_builder_datastore_handle_set(
+                builder, inst->instance.datastore, inst->instance.datastore);
+        }
+        else
+        {
+            vcdb_builder_index_handle_set(
+                builder, inst->instance.index, inst->instance.index);
+        }
+    }
+}
 
 /**
  * \brief Register the test database mock.
@@ -38,6 +107,8 @@ void register_test_database()
     if (!test_database_registered)
     {
         vcdb_database_engine_register(&test_database_engine, "TESTDB");
+        vcdb_database_engine_register(
+            &test_database_minimal_engine, "TESTDB_MINIMAL");
         test_database_registered = true;
     }
 
@@ -50,8 +121,10 @@ void register_test_database()
     test_database_delete_called = false;
     test_database_delete_retval = VCDB_STATUS_SUCCESS;
     test_datastore_get_called = false;
+    test_datastore_get_handle = NULL;
     test_datastore_get_retval = VCDB_STATUS_SUCCESS;
     test_index_get_called = false;
+    test_index_get_handle = NULL;
     test_index_get_retval = VCDB_STATUS_SUCCESS;
     test_transaction_begin_called = false;
     test_transaction_begin_retval = VCDB_STATUS_SUCCESS;
@@ -65,6 +138,36 @@ void register_test_database()
     test_datastore_delete_retval = VCDB_STATUS_SUCCESS;
     test_index_delete_called = false;
     test_index_delete_retval = VCDB_STATUS_SUCCESS;
+    test_transaction_savepoint_set_called = false;
+    test_transaction_savepoint_set_retval = VCDB_STATUS_SUCCESS;
+    test_transaction_savepoint_rollback_called = false;
+    test_transaction_savepoint_rollback_retval = VCDB_STATUS_SUCCESS;
+    test_transaction_savepoint_release_called = false;
+    test_transaction_savepoint_release_retval = VCDB_STATUS_SUCCESS;
+    test_datastore_merge_called = false;
+    test_datastore_merge_retval = VCDB_STATUS_SUCCESS;
+    test_datastore_get_versioned_called = false;
+    test_datastore_get_versioned_retval = VCDB_STATUS_SUCCESS;
+    test_datastore_get_versioned_version = VCDB_VERSION_NONE;
+    test_datastore_put_if_version_called = false;
+    test_datastore_put_if_version_retval = VCDB_STATUS_SUCCESS;
+    test_datastore_delete_range_called = false;
+    test_datastore_delete_range_retval = VCDB_STATUS_SUCCESS;
+    test_filter_load_called = false;
+    test_filter_load_retval = VCDB_STATUS_SUCCESS;
+    test_filter_save_called = false;
+    test_filter_save_retval = VCDB_STATUS_SUCCESS;
+    test_filter_saved.clear();
+    test_datastore_contains_called = false;
+    test_datastore_contains_retval = VCDB_STATUS_SUCCESS;
+    test_index_contains_called = false;
+    test_index_contains_retval = VCDB_STATUS_SUCCESS;
+    test_index_get_primary_key_called = false;
+    test_index_get_primary_key_retval = VCDB_STATUS_SUCCESS;
+    test_index_projection_put_called = false;
+    test_index_projection_put_retval = VCDB_STATUS_SUCCESS;
+    test_index_get_projection_called = false;
+    test_index_get_projection_retval = VCDB_STATUS_SUCCESS;
 }
 
 /**
@@ -86,6 +189,7 @@ int test_database_create(
     test_database_create_param_builder = builder;
 
     database->database_engine_context = &test_database_dummy;
+    test_database_handles_set(builder);
 
     return test_database_create_retval;
 }
@@ -129,6 +233,7 @@ int test_database_open(
     test_database_open_param_builder = builder;
 
     database->database_engine_context = &test_database_dummy;
+    test_database_handles_set(builder);
 
     return test_database_open_retval;
 }
@@ -241,6 +346,8 @@ int test_datastore_get(
     test_datastore_get_param_key_size = key_size;
     test_datastore_get_param_value = value;
     test_datastore_get_param_value_size = value_size;
+    test_datastore_get_handle =
+        vcdb_builder_datastore_handle_get(database->builder, datastore);
 
     return test_datastore_get_retval;
 }
@@ -285,6 +392,11 @@ void* test_datastore_get_param_value;
  */
 size_t* test_datastore_get_param_value_size;
 
+/**
+ * \brief The engine handle resolved by test_datastore_get().
+ */
+void* test_datastore_get_handle;
+
 /**
  * \brief Database engine method for getting a value from a secondary index.
  *
@@ -319,6 +431,8 @@ int test_index_get(
     test_index_get_param_key_size = key_size;
     test_index_get_param_value = value;
     test_index_get_param_value_size = value_size;
+    test_index_get_handle =
+        vcdb_builder_index_handle_get(database->builder, index);
 
     return test_index_get_retval;
 }
@@ -363,6 +477,11 @@ void* test_index_get_param_value;
  */
 size_t* test_index_get_param_value_size;
 
+/**
+ * \brief The engine handle resolved by test_index_get().
+ */
+void* test_index_get_handle;
+
 /**
  * \brief Begin a transaction in the given database.
  *
@@ -658,3 +777,930 @@ void* test_index_delete_param_key;
  * \brief The key_size parameter passed to test_index_delete().
  */
 size_t* test_index_delete_param_key_size;
+
+/**
+ * \brief Mark a savepoint in the given transaction.
+ *
+ * \param transaction   The transaction in which the savepoint is marked.
+ * \param savepoint     The savepoint instance to mark.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_transaction_savepoint_set(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint)
+{
+    test_transaction_savepoint_set_called = true;
+    test_transaction_savepoint_set_param_transaction = transaction;
+    test_transaction_savepoint_set_param_savepoint = savepoint;
+
+    return test_transaction_savepoint_set_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_transaction_savepoint_set() was called.
+ */
+bool test_transaction_savepoint_set_called;
+
+/**
+ * \brief The return value for test_transaction_savepoint_set().
+ */
+int test_transaction_savepoint_set_retval;
+
+/**
+ * \brief The transaction parameter passed to test_transaction_savepoint_set().
+ */
+vcdb_transaction_t* test_transaction_savepoint_set_param_transaction;
+
+/**
+ * \brief The savepoint parameter passed to test_transaction_savepoint_set().
+ */
+vcdb_transaction_savepoint_t* test_transaction_savepoint_set_param_savepoint;
+
+/**
+ * \brief Roll back a transaction to a savepoint.
+ *
+ * \param transaction   The transaction to partially roll back.
+ * \param savepoint     The savepoint to roll back to.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_transaction_savepoint_rollback(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint)
+{
+    test_transaction_savepoint_rollback_called = true;
+    test_transaction_savepoint_rollback_param_transaction = transaction;
+    test_transaction_savepoint_rollback_param_savepoint = savepoint;
+
+    return test_transaction_savepoint_rollback_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_transaction_savepoint_rollback() was called.
+ */
+bool test_transaction_savepoint_rollback_called;
+
+/**
+ * \brief The return value for test_transaction_savepoint_rollback().
+ */
+int test_transaction_savepoint_rollback_retval;
+
+/**
+ * \brief The transaction parameter passed to test_transaction_savepoint_rollback().
+ */
+vcdb_transaction_t* test_transaction_savepoint_rollback_param_transaction;
+
+/**
+ * \brief The savepoint parameter passed to test_transaction_savepoint_rollback().
+ */
+vcdb_transaction_savepoint_t* test_transaction_savepoint_rollback_param_savepoint;
+
+/**
+ * \brief Release a savepoint.
+ *
+ * \param transaction   The transaction owning the savepoint.
+ * \param savepoint     The savepoint to release.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_transaction_savepoint_release(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint)
+{
+    test_transaction_savepoint_release_called = true;
+    test_transaction_savepoint_release_param_transaction = transaction;
+    test_transaction_savepoint_release_param_savepoint = savepoint;
+
+    return test_transaction_savepoint_release_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_transaction_savepoint_release() was called.
+ */
+bool test_transaction_savepoint_release_called;
+
+/**
+ * \brief The return value for test_transaction_savepoint_release().
+ */
+int test_transaction_savepoint_release_retval;
+
+/**
+ * \brief The transaction parameter passed to test_transaction_savepoint_release().
+ */
+vcdb_transaction_t* test_transaction_savepoint_release_param_transaction;
+
+/**
+ * \brief The savepoint parameter passed to test_transaction_savepoint_release().
+ */
+vcdb_transaction_savepoint_t* test_transaction_savepoint_release_param_savepoint;
+
+/**
+ * \brief Record a merge operand for the given key in the given datastore.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to merge the operand into.
+ * \param key           The key of the value to update.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_merge(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size)
+{
+    test_datastore_merge_called = true;
+    test_datastore_merge_param_transaction = transaction;
+    test_datastore_merge_param_datastore = datastore;
+    test_datastore_merge_param_key = key;
+    test_datastore_merge_param_key_size = key_size;
+    test_datastore_merge_param_operand = operand;
+    test_datastore_merge_param_operand_size = operand_size;
+
+    return test_datastore_merge_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_datastore_merge() was called.
+ */
+bool test_datastore_merge_called;
+
+/**
+ * \brief The return value for test_datastore_merge().
+ */
+int test_datastore_merge_retval;
+
+/**
+ * \brief The transaction parameter passed to test_datastore_merge().
+ */
+vcdb_transaction_t* test_datastore_merge_param_transaction;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_merge().
+ */
+vcdb_datastore_t* test_datastore_merge_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_merge().
+ */
+void* test_datastore_merge_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_merge().
+ */
+size_t* test_datastore_merge_param_key_size;
+
+/**
+ * \brief The operand parameter passed to test_datastore_merge().
+ */
+void* test_datastore_merge_param_operand;
+
+/**
+ * \brief The operand_size parameter passed to test_datastore_merge().
+ */
+size_t* test_datastore_merge_param_operand_size;
+
+/**
+ * \brief Database engine method for getting a value and its version token from a datastore.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to get the value from.
+ * \param key           The key to use for the query.
+ * \param key_size      The size of the key.
+ * \param value         The value to read.
+ * \param value_size    The size pointer.
+ * \param version       Pointer to receive the version token.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the value is not in the datastore.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the value_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_get_versioned(
+    struct vcdb_database* database,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t* version)
+{
+    test_datastore_get_versioned_called = true;
+    test_datastore_get_versioned_param_database = database;
+    test_datastore_get_versioned_param_datastore = datastore;
+    test_datastore_get_versioned_param_key = key;
+    test_datastore_get_versioned_param_key_size = key_size;
+    test_datastore_get_versioned_param_value = value;
+    test_datastore_get_versioned_param_value_size = value_size;
+    test_datastore_get_versioned_param_version = version;
+
+    *version = test_datastore_get_versioned_version;
+
+    return test_datastore_get_versioned_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_datastore_get_versioned() was called.
+ */
+bool test_datastore_get_versioned_called;
+
+/**
+ * \brief The return value for test_datastore_get_versioned().
+ */
+int test_datastore_get_versioned_retval;
+
+/**
+ * \brief The database parameter passed to test_datastore_get_versioned().
+ */
+vcdb_database_t* test_datastore_get_versioned_param_database;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_get_versioned().
+ */
+vcdb_datastore_t* test_datastore_get_versioned_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_get_versioned().
+ */
+void* test_datastore_get_versioned_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_get_versioned().
+ */
+size_t test_datastore_get_versioned_param_key_size;
+
+/**
+ * \brief The value parameter passed to test_datastore_get_versioned().
+ */
+void* test_datastore_get_versioned_param_value;
+
+/**
+ * \brief The value_size parameter passed to test_datastore_get_versioned().
+ */
+size_t* test_datastore_get_versioned_param_value_size;
+
+/**
+ * \brief The version parameter passed to test_datastore_get_versioned().
+ */
+vcdb_version_t* test_datastore_get_versioned_param_version;
+
+/**
+ * \brief The version token returned by test_datastore_get_versioned().
+ */
+vcdb_version_t test_datastore_get_versioned_version;
+
+/**
+ * \brief Put a value into the datastore if its stored version matches.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param key           The key to put.
+ * \param key_size      The size of the key to put.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VERSION_MISMATCH if the stored version differs.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_put_if_version(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t version)
+{
+    test_datastore_put_if_version_called = true;
+    test_datastore_put_if_version_param_transaction = transaction;
+    test_datastore_put_if_version_param_datastore = datastore;
+    test_datastore_put_if_version_param_key = key;
+    test_datastore_put_if_version_param_key_size = key_size;
+    test_datastore_put_if_version_param_value = value;
+    test_datastore_put_if_version_param_value_size = value_size;
+    test_datastore_put_if_version_param_version = version;
+
+    return test_datastore_put_if_version_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_datastore_put_if_version() was called.
+ */
+bool test_datastore_put_if_version_called;
+
+/**
+ * \brief The return value for test_datastore_put_if_version().
+ */
+int test_datastore_put_if_version_retval;
+
+/**
+ * \brief The transaction parameter passed to test_datastore_put_if_version().
+ */
+vcdb_transaction_t* test_datastore_put_if_version_param_transaction;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_put_if_version().
+ */
+vcdb_datastore_t* test_datastore_put_if_version_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_put_if_version().
+ */
+void* test_datastore_put_if_version_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_put_if_version().
+ */
+size_t* test_datastore_put_if_version_param_key_size;
+
+/**
+ * \brief The value parameter passed to test_datastore_put_if_version().
+ */
+void* test_datastore_put_if_version_param_value;
+
+/**
+ * \brief The value_size parameter passed to test_datastore_put_if_version().
+ */
+size_t* test_datastore_put_if_version_param_value_size;
+
+/**
+ * \brief The version parameter passed to test_datastore_put_if_version().
+ */
+vcdb_version_t test_datastore_put_if_version_param_version;
+
+/**
+ * \brief Delete all values in the half-open key range [start, end) in the given datastore.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to use when deleting.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_delete_range(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size)
+{
+    test_datastore_delete_range_called = true;
+    test_datastore_delete_range_param_transaction = transaction;
+    test_datastore_delete_range_param_datastore = datastore;
+    test_datastore_delete_range_param_start = start;
+    test_datastore_delete_range_param_start_size = start_size;
+    test_datastore_delete_range_param_end = end;
+    test_datastore_delete_range_param_end_size = end_size;
+
+    return test_datastore_delete_range_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_datastore_delete_range() was called.
+ */
+bool test_datastore_delete_range_called;
+
+/**
+ * \brief The return value for test_datastore_delete_range().
+ */
+int test_datastore_delete_range_retval;
+
+/**
+ * \brief The transaction parameter passed to test_datastore_delete_range().
+ */
+vcdb_transaction_t* test_datastore_delete_range_param_transaction;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_delete_range().
+ */
+vcdb_datastore_t* test_datastore_delete_range_param_datastore;
+
+/**
+ * \brief The start parameter passed to test_datastore_delete_range().
+ */
+void* test_datastore_delete_range_param_start;
+
+/**
+ * \brief The start_size parameter passed to test_datastore_delete_range().
+ */
+size_t* test_datastore_delete_range_param_start_size;
+
+/**
+ * \brief The end parameter passed to test_datastore_delete_range().
+ */
+void* test_datastore_delete_range_param_end;
+
+/**
+ * \brief The end_size parameter passed to test_datastore_delete_range().
+ */
+size_t* test_datastore_delete_range_param_end_size;
+
+/**
+ * \brief Load the persisted negative-lookup filter for a datastore or index.
+ *
+ * \param database       The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index.
+ * \param data           The buffer to receive the filter data.
+ * \param size           The size of the data buffer, updated on success.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if no filter has been saved.
+ *          - a non-zero failure code on failure.
+ */
+int test_filter_load(
+    struct vcdb_database* database,
+    int correlation_id,
+    void* data,
+    size_t* size)
+{
+    test_filter_load_called = true;
+    test_filter_load_param_database = database;
+    test_filter_load_param_correlation_id = correlation_id;
+    test_filter_load_param_data = data;
+    test_filter_load_param_size = size;
+
+    /* serve the filter saved by test_filter_save(). */
+    auto saved = test_filter_saved.find(correlation_id);
+    if (VCDB_STATUS_SUCCESS == test_filter_load_retval)
+    {
+        if (test_filter_saved.end() == saved)
+        {
+            return VCDB_ERROR_VALUE_NOT_FOUND;
+        }
+
+        *size = saved->second.size() < *size ? saved->second.size() : *size;
+        memcpy(data, saved->second.data(), *size);
+    }
+
+    return test_filter_load_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_filter_load() was called.
+ */
+bool test_filter_load_called;
+
+/**
+ * \brief The return value for test_filter_load().
+ */
+int test_filter_load_retval;
+
+/**
+ * \brief The database parameter passed to test_filter_load().
+ */
+vcdb_database_t* test_filter_load_param_database;
+
+/**
+ * \brief The correlation_id parameter passed to test_filter_load().
+ */
+int test_filter_load_param_correlation_id;
+
+/**
+ * \brief The data parameter passed to test_filter_load().
+ */
+void* test_filter_load_param_data;
+
+/**
+ * \brief The size parameter passed to test_filter_load().
+ */
+size_t* test_filter_load_param_size;
+
+/**
+ * \brief Persist the negative-lookup filter for a datastore or index.
+ *
+ * \param database       The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index.
+ * \param data           The filter data to save, or NULL to remove it.
+ * \param size           The size of the filter data.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_filter_save(
+    struct vcdb_database* database,
+    int correlation_id,
+    const void* data,
+    size_t size)
+{
+    test_filter_save_called = true;
+    test_filter_save_param_database = database;
+    test_filter_save_param_correlation_id = correlation_id;
+    test_filter_save_param_data = data;
+    test_filter_save_param_size = size;
+
+    /* keep the filter so that test_filter_load() can return it. */
+    if (VCDB_STATUS_SUCCESS == test_filter_save_retval)
+    {
+        if (NULL == data)
+        {
+            test_filter_saved.erase(correlation_id);
+        }
+        else
+        {
+            const uint8_t* bytes = (const uint8_t*)data;
+            test_filter_saved[correlation_id].assign(bytes, bytes + size);
+        }
+    }
+
+    return test_filter_save_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_filter_save() was called.
+ */
+bool test_filter_save_called;
+
+/**
+ * \brief The return value for test_filter_save().
+ */
+int test_filter_save_retval;
+
+/**
+ * \brief The database parameter passed to test_filter_save().
+ */
+vcdb_database_t* test_filter_save_param_database;
+
+/**
+ * \brief The correlation_id parameter passed to test_filter_save().
+ */
+int test_filter_save_param_correlation_id;
+
+/**
+ * \brief The data parameter passed to test_filter_save().
+ */
+const void* test_filter_save_param_data;
+
+/**
+ * \brief The size parameter passed to test_filter_save().
+ */
+size_t test_filter_save_param_size;
+
+/**
+ * \brief Filters saved by test_filter_save(), by correlation ID.
+ */
+std::map<int, std::vector<uint8_t>> test_filter_saved;
+
+/**
+ * \brief Check whether a key is in a datastore.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the datastore.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the datastore.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_contains(
+    struct vcdb_database* database,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t key_size)
+{
+    test_datastore_contains_called = true;
+    test_datastore_contains_param_database = database;
+    test_datastore_contains_param_datastore = datastore;
+    test_datastore_contains_param_key = key;
+    test_datastore_contains_param_key_size = key_size;
+
+    return test_datastore_contains_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_datastore_contains() was called.
+ */
+bool test_datastore_contains_called;
+
+/**
+ * \brief The return value for test_datastore_contains().
+ */
+int test_datastore_contains_retval;
+
+/**
+ * \brief The database parameter passed to test_datastore_contains().
+ */
+vcdb_database_t* test_datastore_contains_param_database;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_contains().
+ */
+vcdb_datastore_t* test_datastore_contains_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_contains().
+ */
+void* test_datastore_contains_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_contains().
+ */
+size_t test_datastore_contains_param_key_size;
+
+/**
+ * \brief Check whether a key is in a secondary index.
+ *
+ * \param database      The database instance to use.
+ * \param index         The secondary index to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the index.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_contains(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size)
+{
+    test_index_contains_called = true;
+    test_index_contains_param_database = database;
+    test_index_contains_param_index = index;
+    test_index_contains_param_key = key;
+    test_index_contains_param_key_size = key_size;
+
+    return test_index_contains_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_index_contains() was called.
+ */
+bool test_index_contains_called;
+
+/**
+ * \brief The return value for test_index_contains().
+ */
+int test_index_contains_retval;
+
+/**
+ * \brief The database parameter passed to test_index_contains().
+ */
+vcdb_database_t* test_index_contains_param_database;
+
+/**
+ * \brief The index parameter passed to test_index_contains().
+ */
+vcdb_index_t* test_index_contains_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_contains().
+ */
+void* test_index_contains_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_contains().
+ */
+size_t test_index_contains_param_key_size;
+
+/**
+ * \brief Get the primary key that a secondary index key maps to.
+ *
+ * \param database         The database instance to use.
+ * \param index            The secondary index to use.
+ * \param key              The secondary key to use for the query.
+ * \param key_size         The size of the secondary key.
+ * \param primary_key      The buffer to receive the primary key.
+ * \param primary_key_size The size of the primary key buffer.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_get_primary_key(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size)
+{
+    test_index_get_primary_key_called = true;
+    test_index_get_primary_key_param_database = database;
+    test_index_get_primary_key_param_index = index;
+    test_index_get_primary_key_param_key = key;
+    test_index_get_primary_key_param_key_size = key_size;
+    test_index_get_primary_key_param_primary_key = primary_key;
+    test_index_get_primary_key_param_primary_key_size = primary_key_size;
+
+    return test_index_get_primary_key_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_index_get_primary_key() was called.
+ */
+bool test_index_get_primary_key_called;
+
+/**
+ * \brief The return value for test_index_get_primary_key().
+ */
+int test_index_get_primary_key_retval;
+
+/**
+ * \brief The database parameter passed to test_index_get_primary_key().
+ */
+vcdb_database_t* test_index_get_primary_key_param_database;
+
+/**
+ * \brief The index parameter passed to test_index_get_primary_key().
+ */
+vcdb_index_t* test_index_get_primary_key_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_get_primary_key().
+ */
+void* test_index_get_primary_key_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_get_primary_key().
+ */
+size_t test_index_get_primary_key_param_key_size;
+
+/**
+ * \brief The primary_key parameter passed to test_index_get_primary_key().
+ */
+void* test_index_get_primary_key_param_primary_key;
+
+/**
+ * \brief The primary_key_size parameter passed to test_index_get_primary_key().
+ */
+size_t* test_index_get_primary_key_param_primary_key_size;
+
+/**
+ * \brief Store the projection of a value in a covering index entry.
+ *
+ * \param transaction     The transaction instance to use.
+ * \param index           The covering index.
+ * \param key             The secondary key of the index entry.
+ * \param key_size        The size of the secondary key.
+ * \param projection      The serialized projection to store.
+ * \param projection_size The size of the projection.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_projection_put(
+    struct vcdb_transaction* transaction,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t projection_size)
+{
+    test_index_projection_put_called = true;
+    test_index_projection_put_param_transaction = transaction;
+    test_index_projection_put_param_index = index;
+    test_index_projection_put_param_key = key;
+    test_index_projection_put_param_key_size = key_size;
+    test_index_projection_put_param_projection = projection;
+    test_index_projection_put_param_projection_size = projection_size;
+
+    return test_index_projection_put_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_index_projection_put() was called.
+ */
+bool test_index_projection_put_called;
+
+/**
+ * \brief The return value for test_index_projection_put().
+ */
+int test_index_projection_put_retval;
+
+/**
+ * \brief The transaction parameter passed to test_index_projection_put().
+ */
+vcdb_transaction_t* test_index_projection_put_param_transaction;
+
+/**
+ * \brief The index parameter passed to test_index_projection_put().
+ */
+vcdb_index_t* test_index_projection_put_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_projection_put().
+ */
+void* test_index_projection_put_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_projection_put().
+ */
+size_t test_index_projection_put_param_key_size;
+
+/**
+ * \brief The projection parameter passed to test_index_projection_put().
+ */
+void* test_index_projection_put_param_projection;
+
+/**
+ * \brief The projection_size parameter passed to test_index_projection_put().
+ */
+size_t test_index_projection_put_param_projection_size;
+
+/**
+ * \brief Get the projection stored in a covering index entry.
+ *
+ * \param database        The database instance to use.
+ * \param index           The covering index.
+ * \param key             The secondary key to use for the query.
+ * \param key_size        The size of the secondary key.
+ * \param projection      The buffer to receive the projection.
+ * \param projection_size The size of the projection buffer.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the projection_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_get_projection(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t* projection_size)
+{
+    test_index_get_projection_called = true;
+    test_index_get_projection_param_database = database;
+    test_index_get_projection_param_index = index;
+    test_index_get_projection_param_key = key;
+    test_index_get_projection_param_key_size = key_size;
+    test_index_get_projection_param_projection = projection;
+    test_index_get_projection_param_projection_size = projection_size;
+
+    return test_index_get_projection_retval;
+}
+
+/**
+ * \brief Flag to indicate whether test_index_get_projection() was called.
+ */
+bool test_index_get_projection_called;
+
+/**
+ * \brief The return value for test_index_get_projection().
+ */
+int test_index_get_projection_retval;
+
+/**
+ * \brief The database parameter passed to test_index_get_projection().
+ */
+vcdb_database_t* test_index_get_projection_param_database;
+
+/**
+ * \brief The index parameter passed to test_index_get_projection().
+ */
+vcdb_index_t* test_index_get_projection_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_get_projection().
+ */
+void* test_index_get_projection_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_get_projection().
+ */
+size_t test_index_get_projection_param_key_size;
+
+/**
+ * \brief The projection parameter passed to test_index_get_projection().
+ */
+void* test_index_get_projection_param_projection;
+
+/**
+ * \brief The projection_size parameter passed to test_index_get_projection().
+ */
+size_t* test_index_get_projection_param_projection_size;
@@ -10,17 +10,24 @@
 #ifndef TEST_DATABASE_PRIVATE_HEADER_GUARD
 #define TEST_DATABASE_PRIVATE_HEADER_GUARD
 
+#include <map>
 #include <stdbool.h>
+#include <stdint.h>
 #include <vcdb/builder.h>
 #include <vcdb/database.h>
 #include <vcdb/datastore.h>
 #include <vcdb/transaction.h>
 #include <vcdb/index.h>
+#include <vector>
 
 extern int test_database_dummy;
 
 /**
  * \brief Register the test database mock.
+ *
+ * This registers two engines.  "TESTDB" implements every engine method, and
+ * "TESTDB_MINIMAL" implements only the required engine methods, leaving all
+ * optional methods set to NULL.
  */
 void register_test_database();
 
@@ -203,6 +210,11 @@ extern void* test_datastore_get_param_value;
  */
 extern size_t* test_datastore_get_param_value_size;
 
+/**
+ * \brief The engine handle resolved by test_datastore_get().
+ */
+extern void* test_datastore_get_handle;
+
 /**
  * \brief Database engine method for getting a value from a secondary index.
  *
@@ -270,6 +282,11 @@ extern void* test_index_get_param_value;
  */
 extern size_t* test_index_get_param_value_size;
 
+/**
+ * \brief The engine handle resolved by test_index_get().
+ */
+extern void* test_index_get_handle;
+
 /**
  * \brief Begin a transaction in the given database.
  *
@@ -518,4 +535,766 @@ extern void* test_index_delete_param_key;
  */
 extern size_t* test_index_delete_param_key_size;
 
+/**
+ * \brief Mark a savepoint in the given transaction.
+ *
+ * \param transaction   The transaction in which the savepoint is marked.
+ * \param savepoint     The savepoint instance to mark.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_transaction_savepoint_set(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint);
+
+/**
+ * \brief Flag to indicate whether test_transaction_savepoint_set() was called.
+ */
+extern bool test_transaction_savepoint_set_called;
+
+/**
+ * \brief The return value for test_transaction_savepoint_set().
+ */
+extern int test_transaction_savepoint_set_retval;
+
+/**
+ * \brief The transaction parameter passed to test_transaction_savepoint_set().
+ */
+extern vcdb_transaction_t* test_transaction_savepoint_set_param_transaction;
+
+/**
+ * \brief The savepoint parameter passed to test_transaction_savepoint_set().
+ */
+extern vcdb_transaction_savepoint_t* test_transaction_savepoint_set_param_savepoint;
+
+/**
+ * \brief Roll back a transaction to a savepoint.
+ *
+ * \param transaction   The transaction to partially roll back.
+ * \param savepoint     The savepoint to roll back to.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_transaction_savepoint_rollback(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint);
+
+/**
+ * \brief Flag to indicate whether test_transaction_savepoint_rollback() was called.
+ */
+extern bool test_transaction_savepoint_rollback_called;
+
+/**
+ * \brief The return value for test_transaction_savepoint_rollback().
+ */
+extern int test_transaction_savepoint_rollback_retval;
+
+/**
+ * \brief The transaction parameter passed to test_transaction_savepoint_rollback().
+ */
+extern vcdb_transaction_t* test_transaction_savepoint_rollback_param_transaction;
+
+/**
+ * \brief The savepoint parameter passed to test_transaction_savepoint_rollback().
+ */
+extern vcdb_transaction_savepoint_t* test_transaction_savepoint_rollback_param_savepoint;
+
+/**
+ * \brief Release a savepoint.
+ *
+ * \param transaction   The transaction owning the savepoint.
+ * \param savepoint     The savepoint to release.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_transaction_savepoint_release(
+    struct vcdb_transaction* transaction,
+    struct vcdb_transaction_savepoint* savepoint);
+
+/**
+ * \brief Flag to indicate whether test_transaction_savepoint_release() was called.
+ */
+extern bool test_transaction_savepoint_release_called;
+
+/**
+ * \brief The return value for test_transaction_savepoint_release().
+ */
+extern int test_transaction_savepoint_release_retval;
+
+/**
+ * \brief The transaction parameter passed to test_transaction_savepoint_release().
+ */
+extern vcdb_transaction_t* test_transaction_savepoint_release_param_transaction;
+
+/**
+ * \brief The savepoint parameter passed to test_transaction_savepoint_release().
+ */
+extern vcdb_transaction_savepoint_t* test_transaction_savepoint_release_param_savepoint;
+
+/**
+ * \brief Record a merge operand for the given key in the given datastore.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to merge the operand into.
+ * \param key           The key of the value to update.
+ * \param key_size      The size of the key.
+ * \param operand       The serialized merge operand.
+ * \param operand_size  The size of the merge operand.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_merge(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t* key_size,
+    void* operand,
+    size_t* operand_size);
+
+/**
+ * \brief Flag to indicate whether test_datastore_merge() was called.
+ */
+extern bool test_datastore_merge_called;
+
+/**
+ * \brief The return value for test_datastore_merge().
+ */
+extern int test_datastore_merge_retval;
+
+/**
+ * \brief The transaction parameter passed to test_datastore_merge().
+ */
+extern vcdb_transaction_t* test_datastore_merge_param_transaction;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_merge().
+ */
+extern vcdb_datastore_t* test_datastore_merge_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_merge().
+ */
+extern void* test_datastore_merge_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_merge().
+ */
+extern size_t* test_datastore_merge_param_key_size;
+
+/**
+ * \brief The operand parameter passed to test_datastore_merge().
+ */
+extern void* test_datastore_merge_param_operand;
+
+/**
+ * \brief The operand_size parameter passed to test_datastore_merge().
+ */
+extern size_t* test_datastore_merge_param_operand_size;
+
+/**
+ * \brief Database engine method for getting a value and its version token from a datastore.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to get the value from.
+ * \param key           The key to use for the query.
+ * \param key_size      The size of the key.
+ * \param value         The value to read.
+ * \param value_size    The size pointer.
+ * \param version       Pointer to receive the version token.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the value is not in the datastore.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the value_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_get_versioned(
+    struct vcdb_database* database,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t* version);
+
+/**
+ * \brief Flag to indicate whether test_datastore_get_versioned() was called.
+ */
+extern bool test_datastore_get_versioned_called;
+
+/**
+ * \brief The return value for test_datastore_get_versioned().
+ */
+extern int test_datastore_get_versioned_retval;
+
+/**
+ * \brief The database parameter passed to test_datastore_get_versioned().
+ */
+extern vcdb_database_t* test_datastore_get_versioned_param_database;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_get_versioned().
+ */
+extern vcdb_datastore_t* test_datastore_get_versioned_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_get_versioned().
+ */
+extern void* test_datastore_get_versioned_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_get_versioned().
+ */
+extern size_t test_datastore_get_versioned_param_key_size;
+
+/**
+ * \brief The value parameter passed to test_datastore_get_versioned().
+ */
+extern void* test_datastore_get_versioned_param_value;
+
+/**
+ * \brief The value_size parameter passed to test_datastore_get_versioned().
+ */
+extern size_t* test_datastore_get_versioned_param_value_size;
+
+/**
+ * \brief The version parameter passed to test_datastore_get_versioned().
+ */
+extern vcdb_version_t* test_datastore_get_versioned_param_version;
+
+/**
+ * \brief The version token returned by test_datastore_get_versioned().
+ */
+extern vcdb_version_t test_datastore_get_versioned_version;
+
+/**
+ * \brief Put a value into the datastore if its stored version matches.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to put the value into.
+ * \param key           The key to put.
+ * \param key_size      The size of the key to put.
+ * \param value         The value to put.
+ * \param value_size    The size of the value to put.
+ * \param version       The expected version token.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VERSION_MISMATCH if the stored version differs.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_put_if_version(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t* key_size,
+    void* value,
+    size_t* value_size,
+    vcdb_version_t version);
+
+/**
+ * \brief Flag to indicate whether test_datastore_put_if_version() was called.
+ */
+extern bool test_datastore_put_if_version_called;
+
+/**
+ * \brief The return value for test_datastore_put_if_version().
+ */
+extern int test_datastore_put_if_version_retval;
+
+/**
+ * \brief The transaction parameter passed to test_datastore_put_if_version().
+ */
+extern vcdb_transaction_t* test_datastore_put_if_version_param_transaction;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_put_if_version().
+ */
+extern vcdb_datastore_t* test_datastore_put_if_version_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_put_if_version().
+ */
+extern void* test_datastore_put_if_version_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_put_if_version().
+ */
+extern size_t* test_datastore_put_if_version_param_key_size;
+
+/**
+ * \brief The value parameter passed to test_datastore_put_if_version().
+ */
+extern void* test_datastore_put_if_version_param_value;
+
+/**
+ * \brief The value_size parameter passed to test_datastore_put_if_version().
+ */
+extern size_t* test_datastore_put_if_version_param_value_size;
+
+/**
+ * \brief The version parameter passed to test_datastore_put_if_version().
+ */
+extern vcdb_version_t test_datastore_put_if_version_param_version;
+
+/**
+ * \brief Delete all values in the half-open key range [start, end) in the given datastore.
+ *
+ * \param transaction   The transaction instance to use.
+ * \param datastore     The datastore to use when deleting.
+ * \param start         The first key in the range, inclusive.
+ * \param start_size    The size of the start key.
+ * \param end           The last key in the range, exclusive.
+ * \param end_size      The size of the end key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_delete_range(
+    struct vcdb_transaction* transaction,
+    struct vcdb_datastore* datastore,
+    void* start,
+    size_t* start_size,
+    void* end,
+    size_t* end_size);
+
+/**
+ * \brief Flag to indicate whether test_datastore_delete_range() was called.
+ */
+extern bool test_datastore_delete_range_called;
+
+/**
+ * \brief The return value for test_datastore_delete_range().
+ */
+extern int test_datastore_delete_range_retval;
+
+/**
+ * \brief The transaction parameter passed to test_datastore_delete_range().
+ */
+extern vcdb_transaction_t* test_datastore_delete_range_param_transaction;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_delete_range().
+ */
+extern vcdb_datastore_t* test_datastore_delete_range_param_datastore;
+
+/**
+ * \brief The start parameter passed to test_datastore_delete_range().
+ */
+extern void* test_datastore_delete_range_param_start;
+
+/**
+ * \brief The start_size parameter passed to test_datastore_delete_range().
+ */
+extern size_t* test_datastore_delete_range_param_start_size;
+
+/**
+ * \brief The end parameter passed to test_datastore_delete_range().
+ */
+extern void* test_datastore_delete_range_param_end;
+
+/**
+ * \brief The end_size parameter passed to test_datastore_delete_range().
+ */
+extern size_t* test_datastore_delete_range_param_end_size;
+
+/**
+ * \brief Load the persisted negative-lookup filter for a datastore or index.
+ *
+ * \param database       The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index.
+ * \param data           The buffer to receive the filter data.
+ * \param size           The size of the data buffer, updated on success.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if no filter has been saved.
+ *          - a non-zero failure code on failure.
+ */
+int test_filter_load(
+    struct vcdb_database* database,
+    int correlation_id,
+    void* data,
+    size_t* size);
+
+/**
+ * \brief Flag to indicate whether test_filter_load() was called.
+ */
+extern bool test_filter_load_called;
+
+/**
+ * \brief The return value for test_filter_load().
+ */
+extern int test_filter_load_retval;
+
+/**
+ * \brief The database parameter passed to test_filter_load().
+ */
+extern vcdb_database_t* test_filter_load_param_database;
+
+/**
+ * \brief The correlation_id parameter passed to test_filter_load().
+ */
+extern int test_filter_load_param_correlation_id;
+
+/**
+ * \brief The data parameter passed to test_filter_load().
+ */
+extern void* test_filter_load_param_data;
+
+/**
+ * \brief The size parameter passed to test_filter_load().
+ */
+extern size_t* test_filter_load_param_size;
+
+/**
+ * \brief Persist the negative-lookup filter for a datastore or index.
+ *
+ * \param database       The database instance to use.
+ * \param correlation_id The correlation ID of the datastore or index.
+ * \param data           The filter data to save, or NULL to remove it.
+ * \param size           The size of the filter data.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_filter_save(
+    struct vcdb_database* database,
+    int correlation_id,
+    const void* data,
+    size_t size);
+
+/**
+ * \brief Flag to indicate whether test_filter_save() was called.
+ */
+extern bool test_filter_save_called;
+
+/**
+ * \brief The return value for test_filter_save().
+ */
+extern int test_filter_save_retval;
+
+/**
+ * \brief The database parameter passed to test_filter_save().
+ */
+extern vcdb_database_t* test_filter_save_param_database;
+
+/**
+ * \brief The correlation_id parameter passed to test_filter_save().
+ */
+extern int test_filter_save_param_correlation_id;
+
+/**
+ * \brief The data parameter passed to test_filter_save().
+ */
+extern const void* test_filter_save_param_data;
+
+/**
+ * \brief The size parameter passed to test_filter_save().
+ */
+extern size_t test_filter_save_param_size;
+
+/**
+ * \brief Filters saved by test_filter_save(), by correlation ID.
+ */
+extern std::map<int, std::vector<uint8_t>> test_filter_saved;
+
+/**
+ * \brief Check whether a key is in a datastore.
+ *
+ * \param database      The database instance to use.
+ * \param datastore     The datastore to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the datastore.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the datastore.
+ *          - a non-zero failure code on failure.
+ */
+int test_datastore_contains(
+    struct vcdb_database* database,
+    struct vcdb_datastore* datastore,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Flag to indicate whether test_datastore_contains() was called.
+ */
+extern bool test_datastore_contains_called;
+
+/**
+ * \brief The return value for test_datastore_contains().
+ */
+extern int test_datastore_contains_retval;
+
+/**
+ * \brief The database parameter passed to test_datastore_contains().
+ */
+extern vcdb_database_t* test_datastore_contains_param_database;
+
+/**
+ * \brief The datastore parameter passed to test_datastore_contains().
+ */
+extern vcdb_datastore_t* test_datastore_contains_param_datastore;
+
+/**
+ * \brief The key parameter passed to test_datastore_contains().
+ */
+extern void* test_datastore_contains_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_datastore_contains().
+ */
+extern size_t test_datastore_contains_param_key_size;
+
+/**
+ * \brief Check whether a key is in a secondary index.
+ *
+ * \param database      The database instance to use.
+ * \param index         The secondary index to check.
+ * \param key           The key to check.
+ * \param key_size      The size of the key.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS if the key is in the index.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_contains(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size);
+
+/**
+ * \brief Flag to indicate whether test_index_contains() was called.
+ */
+extern bool test_index_contains_called;
+
+/**
+ * \brief The return value for test_index_contains().
+ */
+extern int test_index_contains_retval;
+
+/**
+ * \brief The database parameter passed to test_index_contains().
+ */
+extern vcdb_database_t* test_index_contains_param_database;
+
+/**
+ * \brief The index parameter passed to test_index_contains().
+ */
+extern vcdb_index_t* test_index_contains_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_contains().
+ */
+extern void* test_index_contains_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_contains().
+ */
+extern size_t test_index_contains_param_key_size;
+
+/**
+ * \brief Get the primary key that a secondary index key maps to.
+ *
+ * \param database         The database instance to use.
+ * \param index            The secondary index to use.
+ * \param key              The secondary key to use for the query.
+ * \param key_size         The size of the secondary key.
+ * \param primary_key      The buffer to receive the primary key.
+ * \param primary_key_size The size of the primary key buffer.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the primary_key_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_get_primary_key(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* primary_key,
+    size_t* primary_key_size);
+
+/**
+ * \brief Flag to indicate whether test_index_get_primary_key() was called.
+ */
+extern bool test_index_get_primary_key_called;
+
+/**
+ * \brief The return value for test_index_get_primary_key().
+ */
+extern int test_index_get_primary_key_retval;
+
+/**
+ * \brief The database parameter passed to test_index_get_primary_key().
+ */
+extern vcdb_database_t* test_index_get_primary_key_param_database;
+
+/**
+ * \brief The index parameter passed to test_index_get_primary_key().
+ */
+extern vcdb_index_t* test_index_get_primary_key_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_get_primary_key().
+ */
+extern void* test_index_get_primary_key_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_get_primary_key().
+ */
+extern size_t test_index_get_primary_key_param_key_size;
+
+/**
+ * \brief The primary_key parameter passed to test_index_get_primary_key().
+ */
+extern void* test_index_get_primary_key_param_primary_key;
+
+/**
+ * \brief The primary_key_size parameter passed to test_index_get_primary_key().
+ */
+extern size_t* test_index_get_primary_key_param_primary_key_size;
+
+/**
+ * \brief Store the projection of a value in a covering index entry.
+ *
+ * \param transaction     The transaction instance to use.
+ * \param index           The covering index.
+ * \param key             The secondary key of the index entry.
+ * \param key_size        The size of the secondary key.
+ * \param projection      The serialized projection to store.
+ * \param projection_size The size of the projection.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_projection_put(
+    struct vcdb_transaction* transaction,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t projection_size);
+
+/**
+ * \brief Flag to indicate whether test_index_projection_put() was called.
+ */
+extern bool test_index_projection_put_called;
+
+/**
+ * \brief The return value for test_index_projection_put().
+ */
+extern int test_index_projection_put_retval;
+
+/**
+ * \brief The transaction parameter passed to test_index_projection_put().
+ */
+extern vcdb_transaction_t* test_index_projection_put_param_transaction;
+
+/**
+ * \brief The index parameter passed to test_index_projection_put().
+ */
+extern vcdb_index_t* test_index_projection_put_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_projection_put().
+ */
+extern void* test_index_projection_put_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_projection_put().
+ */
+extern size_t test_index_projection_put_param_key_size;
+
+/**
+ * \brief The projection parameter passed to test_index_projection_put().
+ */
+extern void* test_index_projection_put_param_projection;
+
+/**
+ * \brief The projection_size parameter passed to test_index_projection_put().
+ */
+extern size_t test_index_projection_put_param_projection_size;
+
+/**
+ * \brief Get the projection stored in a covering index entry.
+ *
+ * \param database        The database instance to use.
+ * \param index           The covering index.
+ * \param key             The secondary key to use for the query.
+ * \param key_size        The size of the secondary key.
+ * \param projection      The buffer to receive the projection.
+ * \param projection_size The size of the projection buffer.
+ *
+ * \returns A status code signifying success or failure.
+ *          - VCDB_STATUS_SUCCESS on success.
+ *          - VCDB_ERROR_VALUE_NOT_FOUND if the key is not in the index.
+ *          - VCDB_ERROR_WOULD_TRUNCATE if the projection_size is too small.
+ *          - a non-zero failure code on failure.
+ */
+int test_index_get_projection(
+    struct vcdb_database* database,
+    struct vcdb_index* index,
+    void* key,
+    size_t key_size,
+    void* projection,
+    size_t* projection_size);
+
+/**
+ * \brief Flag to indicate whether test_index_get_projection() was called.
+ */
+extern bool test_index_get_projection_called;
+
+/**
+ * \brief The return value for test_index_get_projection().
+ */
+extern int test_index_get_projection_retval;
+
+/**
+ * \brief The database parameter passed to test_index_get_projection().
+ */
+extern vcdb_database_t* test_index_get_projection_param_database;
+
+/**
+ * \brief The index parameter passed to test_index_get_projection().
+ */
+extern vcdb_index_t* test_index_get_projection_param_index;
+
+/**
+ * \brief The key parameter passed to test_index_get_projection().
+ */
+extern void* test_index_get_projection_param_key;
+
+/**
+ * \brief The key_size parameter passed to test_index_get_projection().
+ */
+extern size_t test_index_get_projection_param_key_size;
+
+/**
+ * \brief The projection parameter passed to test_index_get_projection().
+ */
+extern void* test_index_get_projection_param_projection;
+
+/**
+ * \brief The projection_size parameter passed to test_index_get_projection().
+ */
+extern size_t* test_index_get_projection_param_projection_size;
+
 #endif /*TEST_DATABASE_PRIVATE_HEADER_GUARD*/
@@ -84,6 +84,7 @@ static void test_key_getter(const void* value, void* key, size_t* key_size)
     test_value_t* v = (test_value_t*)value;
     assert(sizeof(v->test_key) < *key_size);
     memcpy(key, v->test_key, sizeof(v->test_key));
+    *key_size = sizeof(v->test_key);
 }
 
 /**
@@ -6,6 +6,8 @@
  * \copyright 2018 Velo Payments, Inc.  All rights reserved.
  */
 
+#include <cstring>
+
 #include "test_datastore.h"
 
 /* globals */
@@ -58,4 +60,9 @@ static void test_secondary_key_getter(
     test_secondary_key_getter_param_value = value;
     test_secondary_key_getter_param_key = key;
     test_secondary_key_getter_param_key_size = key_size;
+
+    /* the value field doubles as the secondary key. */
+    const test_value_t* v = (const test_value_t*)value;
+    memcpy(key, v->test_value, sizeof(v->test_value));
+    *key_size = sizeof(v->test_value);
 }
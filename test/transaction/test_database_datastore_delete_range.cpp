@@ -0,0 +1,229 @@
+/**
+ * \file test_database_datastore_delete_range.cpp
+ *
+ * \brief Test the vcdb_database_datastore_delete_range() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/index.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * Test that a range delete is passed to the engine as a single operation.
+ */
+TEST(datastore_delete_range, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char start[] = "key_0000";
+    size_t start_size = sizeof(start);
+    char end[] = "key_1000";
+    size_t end_size = sizeof(end);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    /* preconditions */
+    test_datastore_reset();
+    ASSERT_FALSE(test_datastore_delete_range_called);
+
+    /* delete the range. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &end_size));
+
+    /* postconditions */
+    EXPECT_TRUE(test_datastore_delete_range_called);
+    EXPECT_FALSE(test_datastore_delete_called);
+    EXPECT_EQ(&transaction, test_datastore_delete_range_param_transaction);
+    EXPECT_EQ(&datastore, test_datastore_delete_range_param_datastore);
+    EXPECT_EQ(start, test_datastore_delete_range_param_start);
+    EXPECT_EQ(&start_size, test_datastore_delete_range_param_start_size);
+    EXPECT_EQ(end, test_datastore_delete_range_param_end);
+    EXPECT_EQ(&end_size, test_datastore_delete_range_param_end_size);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a range delete reports engines that do not support it.
+ */
+TEST(datastore_delete_range, not_supported)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char start[] = "key_0000";
+    size_t start_size = sizeof(start);
+    char end[] = "key_1000";
+    size_t end_size = sizeof(end);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    test_datastore_reset();
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &end_size));
+
+    EXPECT_FALSE(test_datastore_delete_range_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a range delete is refused for datastores with an index, since the
+ * index entries of the deleted values would go stale.
+ */
+TEST(datastore_delete_range, indexed)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    vcdb_transaction_t transaction;
+    char start[] = "key_0000";
+    size_t start_size = sizeof(start);
+    char end[] = "key_1000";
+    size_t end_size = sizeof(end);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    test_datastore_reset();
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &end_size));
+
+    EXPECT_FALSE(test_datastore_delete_range_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a range delete fails for invalid parameters and finished
+ * transactions.
+ */
+TEST(datastore_delete_range, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char start[] = "key_0000";
+    size_t start_size = sizeof(start);
+    char end[] = "key_1000";
+    size_t end_size = sizeof(end);
+    size_t zero_size = 0U;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    test_datastore_reset();
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            NULL, &datastore, start, &start_size, end, &end_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, NULL, start, &start_size, end, &end_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, NULL, &start_size, end, &end_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, NULL, end, &end_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &zero_size, end, &end_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, NULL, &end_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, NULL));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &zero_size));
+
+    /* a finished transaction can't be used. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_database_datastore_delete_range(
+            &transaction, &datastore, start, &start_size, end, &end_size));
+
+    EXPECT_FALSE(test_datastore_delete_range_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
@@ -0,0 +1,280 @@
+/**
+ * \file test_database_datastore_merge.cpp
+ *
+ * \brief Test the vcdb_database_datastore_merge() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/index.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+#include "../test_index.h"
+
+/**
+ * \brief Dummy merge method used to enable merge on the test datastore.
+ */
+static int test_value_merger(
+    const void*, size_t, const void*, size_t, void*, size_t*)
+{
+    return VCDB_STATUS_SUCCESS;
+}
+
+/**
+ * Test that we can begin a transaction and record a merge operand.
+ */
+TEST(datastore_merge, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char key[] = "test_key";
+    size_t key_size = sizeof(key);
+    char operand[] = "+1";
+    size_t operand_size = sizeof(operand);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    /* preconditions */
+    test_datastore_reset();
+    ASSERT_FALSE(test_datastore_merge_called);
+
+    /* record a merge operand. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, operand, &operand_size));
+
+    /* postconditions -- the value is neither read nor serialized. */
+    EXPECT_TRUE(test_datastore_merge_called);
+    EXPECT_EQ(&transaction, test_datastore_merge_param_transaction);
+    EXPECT_EQ(&datastore, test_datastore_merge_param_datastore);
+    EXPECT_EQ(key, test_datastore_merge_param_key);
+    EXPECT_EQ(&key_size, test_datastore_merge_param_key_size);
+    EXPECT_EQ(operand, test_datastore_merge_param_operand);
+    EXPECT_EQ(&operand_size, test_datastore_merge_param_operand_size);
+    EXPECT_FALSE(test_datastore_get_called);
+    EXPECT_FALSE(test_value_reader_called);
+    EXPECT_FALSE(test_value_writer_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that merge fails for a rolled back transaction.
+ */
+TEST(datastore_merge, bad_transaction)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char key[] = "test_key";
+    size_t key_size = sizeof(key);
+    char operand[] = "+1";
+    size_t operand_size = sizeof(operand);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, operand, &operand_size));
+
+    /* postconditions */
+    EXPECT_FALSE(test_datastore_merge_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that merge reports engines which do not support it.
+ */
+TEST(datastore_merge, not_supported)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char key[] = "test_key";
+    size_t key_size = sizeof(key);
+    char operand[] = "+1";
+    size_t operand_size = sizeof(operand);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, operand, &operand_size));
+
+    /* postconditions */
+    EXPECT_FALSE(test_datastore_merge_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that merge is refused for datastores with an index, since the index
+ * entries would go stale.
+ */
+TEST(datastore_merge, indexed)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_index_t index;
+    vcdb_transaction_t transaction;
+    char key[] = "test_key";
+    size_t key_size = sizeof(key);
+    char operand[] = "+1";
+    size_t operand_size = sizeof(operand);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_index_init(&index, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_builder_add_index(&builder, &index));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, operand, &operand_size));
+
+    /* postconditions */
+    EXPECT_FALSE(test_datastore_merge_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that merge returns an error for invalid parameters.
+ */
+TEST(datastore_merge, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    char key[] = "test_key";
+    size_t key_size = sizeof(key);
+    char operand[] = "+1";
+    size_t operand_size = sizeof(operand);
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    /* the datastore does not yet have a merge method. */
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, operand, &operand_size));
+
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_datastore_value_merger_set(&datastore, &test_value_merger));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            NULL, &datastore, key, &key_size, operand, &operand_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            &transaction, NULL, key, &key_size, operand, &operand_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, NULL, &key_size, operand, &operand_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, NULL, operand, &operand_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, NULL, &operand_size));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_merge(
+            &transaction, &datastore, key, &key_size, operand, NULL));
+
+    /* postconditions */
+    EXPECT_FALSE(test_datastore_merge_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
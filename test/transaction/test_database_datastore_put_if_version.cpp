@@ -0,0 +1,217 @@
+/**
+ * \file test_database_datastore_put_if_version.cpp
+ *
+ * \brief Test the vcdb_database_datastore_put_if_version() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that a versioned put serializes the value and passes the expected
+ * version to the engine.
+ */
+TEST(datastore_put_if_version, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    const char* KEY = "test_key";
+    const char* VALUE = "test_value";
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    /* preconditions */
+    test_datastore_reset();
+
+    /* put a value. */
+    test_value_t test_value;
+    memset(&test_value, 0, sizeof(test_value));
+    strcpy(test_value.test_key, KEY);
+    strcpy(test_value.test_value, VALUE);
+    size_t test_value_size = sizeof(test_value);
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_datastore_put_if_version(
+            &transaction, &datastore, &test_value, &test_value_size, 42));
+
+    /* postconditions */
+    EXPECT_TRUE(test_key_getter_called);
+    EXPECT_TRUE(test_value_writer_called);
+    EXPECT_FALSE(test_datastore_put_called);
+    EXPECT_TRUE(test_datastore_put_if_version_called);
+    EXPECT_EQ(&transaction, test_datastore_put_if_version_param_transaction);
+    EXPECT_EQ(&datastore, test_datastore_put_if_version_param_datastore);
+    EXPECT_NE(nullptr, test_datastore_put_if_version_param_key);
+    EXPECT_NE(nullptr, test_datastore_put_if_version_param_value);
+    EXPECT_EQ(42U, test_datastore_put_if_version_param_version);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a version mismatch from the engine bubbles up.
+ */
+TEST(datastore_put_if_version, version_mismatch)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    test_datastore_reset();
+    test_datastore_put_if_version_retval = VCDB_ERROR_VERSION_MISMATCH;
+
+    test_value_t test_value;
+    memset(&test_value, 0, sizeof(test_value));
+    size_t test_value_size = sizeof(test_value);
+    ASSERT_EQ(VCDB_ERROR_VERSION_MISMATCH,
+        vcdb_database_datastore_put_if_version(
+            &transaction, &datastore, &test_value, &test_value_size,
+            VCDB_VERSION_NONE));
+
+    /* postconditions */
+    EXPECT_TRUE(test_datastore_put_if_version_called);
+    EXPECT_EQ(
+        VCDB_VERSION_NONE, test_datastore_put_if_version_param_version);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a versioned put reports engines that do not support it.
+ */
+TEST(datastore_put_if_version, not_supported)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    test_datastore_reset();
+
+    test_value_t test_value;
+    memset(&test_value, 0, sizeof(test_value));
+    size_t test_value_size = sizeof(test_value);
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_database_datastore_put_if_version(
+            &transaction, &datastore, &test_value, &test_value_size, 1));
+
+    /* nothing was serialized. */
+    EXPECT_FALSE(test_key_getter_called);
+    EXPECT_FALSE(test_value_writer_called);
+    EXPECT_FALSE(test_datastore_put_if_version_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that a versioned put fails for invalid parameters and finished
+ * transactions.
+ */
+TEST(datastore_put_if_version, bad_params)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    test_value_t test_value;
+    memset(&test_value, 0, sizeof(test_value));
+    size_t test_value_size = sizeof(test_value);
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_put_if_version(
+            NULL, &datastore, &test_value, &test_value_size, 1));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_put_if_version(
+            &transaction, NULL, &test_value, &test_value_size, 1));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_put_if_version(
+            &transaction, &datastore, NULL, &test_value_size, 1));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_database_datastore_put_if_version(
+            &transaction, &datastore, &test_value, NULL, 1));
+
+    /* a finished transaction can't be used. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_database_datastore_put_if_version(
+            &transaction, &datastore, &test_value, &test_value_size, 1));
+
+    EXPECT_FALSE(test_datastore_put_if_version_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
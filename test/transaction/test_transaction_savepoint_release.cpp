@@ -0,0 +1,126 @@
+/**
+ * \file test_transaction_savepoint_release.cpp
+ *
+ * \brief Test the vcdb_transaction_savepoint_release() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that we can release a savepoint.
+ */
+TEST(transaction_savepoint_release, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and mark a savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* preconditions */
+    ASSERT_FALSE(test_transaction_savepoint_release_called);
+
+    /* release the savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_release(&savepoint));
+
+    /* postconditions */
+    EXPECT_TRUE(test_transaction_savepoint_release_called);
+    EXPECT_EQ(
+        &transaction, test_transaction_savepoint_release_param_transaction);
+    EXPECT_EQ(&savepoint, test_transaction_savepoint_release_param_savepoint);
+    EXPECT_FALSE(savepoint.active);
+    EXPECT_TRUE(transaction.in_transaction);
+
+    /* a released savepoint can't be released again. */
+    test_transaction_savepoint_release_called = false;
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_transaction_savepoint_release(&savepoint));
+    EXPECT_FALSE(test_transaction_savepoint_release_called);
+
+    /* disposing a released savepoint does not release it again. */
+    dispose((disposable_t*)&savepoint);
+    EXPECT_FALSE(test_transaction_savepoint_release_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that releasing a savepoint after its transaction ends fails.
+ */
+TEST(transaction_savepoint_release, finished_transaction)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and mark a savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_commit(&transaction));
+
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_transaction_savepoint_release(&savepoint));
+
+    /* postconditions */
+    EXPECT_FALSE(test_transaction_savepoint_release_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&savepoint);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that releasing a savepoint fails on invalid parameters.
+ */
+TEST(transaction_savepoint_release, bad_param)
+{
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_transaction_savepoint_release(NULL));
+}
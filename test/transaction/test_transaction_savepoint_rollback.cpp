@@ -0,0 +1,124 @@
+/**
+ * \file test_transaction_savepoint_rollback.cpp
+ *
+ * \brief Test the vcdb_transaction_savepoint_rollback() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that we can roll back to a savepoint more than once, and that the
+ * enclosing transaction stays active.
+ */
+TEST(transaction_savepoint_rollback, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and mark a savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* preconditions */
+    ASSERT_FALSE(test_transaction_savepoint_rollback_called);
+
+    /* roll back to the savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_rollback(&savepoint));
+
+    /* postconditions */
+    EXPECT_TRUE(test_transaction_savepoint_rollback_called);
+    EXPECT_EQ(
+        &transaction, test_transaction_savepoint_rollback_param_transaction);
+    EXPECT_EQ(&savepoint, test_transaction_savepoint_rollback_param_savepoint);
+    EXPECT_TRUE(savepoint.active);
+    EXPECT_TRUE(transaction.in_transaction);
+    EXPECT_FALSE(test_transaction_rollback_called);
+
+    /* we can roll back to the same savepoint again. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_rollback(&savepoint));
+
+    /* cleanup */
+    dispose((disposable_t*)&savepoint);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that rolling back to a released savepoint fails.
+ */
+TEST(transaction_savepoint_rollback, released_savepoint)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and mark a savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_release(&savepoint));
+
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_transaction_savepoint_rollback(&savepoint));
+
+    /* postconditions */
+    EXPECT_FALSE(test_transaction_savepoint_rollback_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&savepoint);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that rolling back to a savepoint fails on invalid parameters.
+ */
+TEST(transaction_savepoint_rollback, bad_param)
+{
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_transaction_savepoint_rollback(NULL));
+}
@@ -0,0 +1,267 @@
+/**
+ * \file test_transaction_savepoint_set.cpp
+ *
+ * \brief Test the vcdb_transaction_savepoint_set() method.
+ *
+ * \copyright 2018 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <gtest/gtest.h>
+#include <vcdb/database.h>
+#include <vcdb/datastore.h>
+#include <vcdb/engine.h>
+#include <vcdb/transaction.h>
+
+#include "../test_database.h"
+#include "../test_datastore.h"
+
+/**
+ * Test that we can mark a savepoint in an active transaction.
+ */
+TEST(transaction_savepoint_set, happy_path)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    /* preconditions */
+    ASSERT_FALSE(test_transaction_savepoint_set_called);
+
+    /* mark a savepoint. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* postconditions */
+    EXPECT_TRUE(test_transaction_savepoint_set_called);
+    EXPECT_EQ(&transaction, test_transaction_savepoint_set_param_transaction);
+    EXPECT_EQ(&savepoint, test_transaction_savepoint_set_param_savepoint);
+    EXPECT_TRUE(savepoint.active);
+    EXPECT_EQ(&transaction, savepoint.transaction);
+
+    /* disposing an active savepoint releases it. */
+    ASSERT_FALSE(test_transaction_savepoint_release_called);
+    dispose((disposable_t*)&savepoint);
+    EXPECT_TRUE(test_transaction_savepoint_release_called);
+    EXPECT_FALSE(savepoint.active);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that an engine error marking a savepoint bubbles up.
+ */
+TEST(transaction_savepoint_set, bad_engine)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    /* the engine will fail. */
+    test_transaction_savepoint_set_retval = -17;
+
+    ASSERT_EQ(-17,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* postconditions */
+    EXPECT_TRUE(test_transaction_savepoint_set_called);
+    EXPECT_FALSE(savepoint.active);
+
+    /* disposing an inactive savepoint does not release it. */
+    dispose((disposable_t*)&savepoint);
+    EXPECT_FALSE(test_transaction_savepoint_release_called);
+
+    /* cleanup */
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that marking a savepoint in a finished transaction fails.
+ */
+TEST(transaction_savepoint_set, bad_transaction)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, vcdb_transaction_rollback(&transaction));
+
+    ASSERT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* postconditions */
+    EXPECT_FALSE(test_transaction_savepoint_set_called);
+    EXPECT_FALSE(savepoint.active);
+
+    /* cleanup */
+    dispose((disposable_t*)&savepoint);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that engines without savepoint support report that fact.
+ */
+TEST(transaction_savepoint_set, not_supported)
+{
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_MINIMAL", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* postconditions */
+    EXPECT_FALSE(test_transaction_savepoint_set_called);
+    EXPECT_FALSE(savepoint.active);
+
+    /* cleanup */
+    dispose((disposable_t*)&savepoint);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that engines which only implement part of savepoint support are treated
+ * as not supporting savepoints.
+ */
+TEST(transaction_savepoint_set, partially_supported)
+{
+    static vcdb_database_engine_t partial_engine;
+    static bool partial_engine_registered = false;
+    vcdb_builder_t builder;
+    vcdb_database_t database;
+    vcdb_datastore_t datastore;
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register an engine which can mark savepoints but not undo them. */
+    register_test_database();
+    if (!partial_engine_registered)
+    {
+        partial_engine = *vcdb_database_engine_lookup("TESTDB");
+        partial_engine.transaction_savepoint_rollback = NULL;
+        partial_engine.transaction_savepoint_release = NULL;
+        vcdb_database_engine_register(&partial_engine, "TESTDB_SAVEPOINT_SET");
+        partial_engine_registered = true;
+    }
+
+    /* we should be able to build a test database and start a transaction. */
+    ASSERT_EQ(VCDB_STATUS_SUCCESS, test_datastore_init(&datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_init(&builder, "TESTDB_SAVEPOINT_SET", "test-dir"));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_builder_add_datastore(&builder, &datastore));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_database_create_from_builder(&database, &builder));
+    ASSERT_EQ(VCDB_STATUS_SUCCESS,
+        vcdb_transaction_begin(&transaction, &database));
+
+    ASSERT_EQ(VCDB_ERROR_NOT_SUPPORTED,
+        vcdb_transaction_savepoint_set(&savepoint, &transaction));
+
+    /* postconditions */
+    EXPECT_FALSE(test_transaction_savepoint_set_called);
+    EXPECT_FALSE(savepoint.active);
+
+    /* rollback and release refuse the inactive savepoint. */
+    EXPECT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_transaction_savepoint_rollback(&savepoint));
+    EXPECT_EQ(VCDB_ERROR_BAD_TRANSACTION,
+        vcdb_transaction_savepoint_release(&savepoint));
+
+    /* cleanup */
+    dispose((disposable_t*)&savepoint);
+    dispose((disposable_t*)&transaction);
+    dispose((disposable_t*)&database);
+    dispose((disposable_t*)&builder);
+}
+
+/**
+ * Test that marking a savepoint fails on invalid parameters.
+ */
+TEST(transaction_savepoint_set, bad_params)
+{
+    vcdb_transaction_t transaction;
+    vcdb_transaction_savepoint_t savepoint;
+
+    /* register the test database engine. */
+    register_test_database();
+
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_transaction_savepoint_set(NULL, &transaction));
+    ASSERT_EQ(VCDB_ERROR_INVALID_PARAMETER,
+        vcdb_transaction_savepoint_set(&savepoint, NULL));
+
+    /* postconditions */
+    EXPECT_FALSE(test_transaction_savepoint_set_called);
+}